@@ -0,0 +1,110 @@
+//
+//  PSChords.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include <limits>
+
+#include "PSChords.hpp"
+#include "MidiNum.hpp"
+
+
+namespace pse {
+
+
+// static
+const uint16_t PSChords::NOPC = std::numeric_limits<uint16_t>::max();
+
+// static
+const uint32_t PSChords::NOCHORD = std::numeric_limits<uint32_t>::max();
+
+
+size_t PSChords::Chord::type() const
+{
+    size_t n = 0;
+    for (unsigned int c = 0; c < 12; ++c)
+        if (pcs & (1 << c))
+            ++n;
+    return n;
+}
+
+
+PSChords::PSChords():
+_first(0),
+_chords(),
+_index()
+{ }
+
+
+PSChords::PSChords(const PSEnum& e):
+_first(e.first()),
+_chords(),
+_index(e.size(), NOCHORD)
+{
+    size_t i = e.first();
+    while (i < e.stop())
+    {
+        // single note
+        if (! e.simultaneous(i))
+        {
+            ++i;
+            continue;
+        }
+        Chord ch;
+        ch.first = i;
+        ch.bass = i;
+        ch.pcs = 0;
+        ch.low.fill(NOPC);
+        // the last note of the chord is not simultaneous with the next one.
+        // if the enumerator ends before, the chord is truncated.
+        size_t i1 = i;
+        while (i1 < e.stop() and e.simultaneous(i1))
+            ++i1;
+        ch.stop = (i1 < e.stop())?(i1 + 1):e.stop();
+        assert(ch.stop - ch.first < NOPC);
+        assert(_chords.size() < NOCHORD);
+        for (size_t j = ch.first; j < ch.stop; ++j)
+        {
+            unsigned int m = e.midipitch(j);
+            assert(MidiNum::check_midi(m));
+            unsigned int c = m % 12;
+            if (m < e.midipitch(ch.bass))
+                ch.bass = j;
+            uint16_t& lo = ch.low[c];
+            if (lo == NOPC or m < e.midipitch(ch.first + lo))
+                lo = (uint16_t) (j - ch.first);
+            ch.pcs |= (1 << c);
+            _index[j - _first] = (uint32_t) _chords.size();
+        }
+        _chords.push_back(ch);
+        i = ch.stop;
+    }
+}
+
+
+PSChords::~PSChords()
+{ }
+
+
+const PSChords::Chord& PSChords::chord(size_t k) const
+{
+    assert(k < _chords.size());
+    return _chords[k];
+}
+
+
+uint32_t PSChords::index(size_t i) const
+{
+    assert(_first <= i);
+    assert(i - _first < _index.size());
+    return _index[i - _first];
+}
+
+
+} // namespace pse
+
+/// @}
@@ -0,0 +1,110 @@
+//
+//  PSChords.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+
+#ifndef PSChords_hpp
+#define PSChords_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <array>
+#include <vector>
+
+#include "pstrace.hpp"
+#include "PSEnum.hpp"
+
+
+namespace pse {
+
+/// immutable table of the chords (maximal sequences of simultaneous notes)
+/// of an enumerator, built once, in one pass over the notes.
+/// Every chord is described by a fixed size record, without allocation,
+/// and referred to by its index in the table.
+/// It replaces the construction of one PSChord per configuration
+/// entering a chord in the best-path search.
+class PSChords
+{
+public:
+
+    /// offset value for a pitch class not in a chord.
+    static const uint16_t NOPC;
+
+    /// index value for a note not in a chord.
+    static const uint32_t NOCHORD;
+
+    /// descriptor of one chord.
+    struct Chord
+    {
+        /// index of the first note of the chord in the enumerator.
+        size_t first;
+
+        /// index of the note after the last note of the chord
+        /// in the enumerator.
+        size_t stop;
+
+        /// index of the lowest note (bass) of the chord in the enumerator.
+        size_t bass;
+
+        /// 12 bits set of the pitch classes of the chord,
+        /// pitch class p is in the set iff bit p is 1.
+        uint16_t pcs;
+
+        /// offset, from first, of the lowest occurrence of each
+        /// pitch class in the chord, or NOPC if there is none.
+        std::array<uint16_t, 12> low;
+
+        /// number of notes in the chord.
+        inline size_t size() const { return stop - first; }
+
+        /// number of distinct pitch classes in the chord:
+        /// 2 for interval, 3 for triad etc.
+        size_t type() const;
+    };
+
+    /// empty table.
+    PSChords();
+
+    /// table of the chords of the given enumerator.
+    /// @param e enumerator of notes. it is not referenced by the table.
+    PSChords(const PSEnum& e);
+
+    ~PSChords();
+
+    /// number of chords in this table.
+    inline size_t size() const { return _chords.size(); }
+
+    /// descriptor of one chord of this table.
+    /// @param k index of a chord. must be smaller than size().
+    const Chord& chord(size_t k) const;
+
+    /// index of the chord containing the given note.
+    /// @param i index of a note of the enumerator of this table.
+    /// @return the index of the chord containing the note i in this table,
+    /// or NOCHORD if i is not in a chord.
+    uint32_t index(size_t i) const;
+
+private: // data
+
+    /// index of the first note of the enumerator.
+    size_t _first;
+
+    /// descriptors of chords, ordered by first note.
+    std::vector<Chord> _chords;
+
+    /// index of chord for each note of the enumerator, or NOCHORD.
+    std::vector<uint32_t> _index;
+
+}; // class PSChords
+
+
+} // namespace pse
+
+#endif /* PSChords_hpp */
+
+/// @}
@@ -10,6 +10,23 @@
 namespace pse {
 
 
+const uint64_t Cost::NOKEY = UINT64_MAX;
+
+
+Cost::Cost():
+_key(0)
+{ }
+
+
+Cost::Cost(const Cost& rhs):
+_key(rhs._key)
+{ }
+
+
+Cost::~Cost()
+{ }
+
+
 bool Cost::operator==(const Cost& rhs) const
 {
     // RTTI check
@@ -18,6 +35,9 @@ bool Cost::operator==(const Cost& rhs) const
         ERROR("Cost: equality between different types");
         return false;
     }
+    // fast path: compare the sort keys
+    if (packed() and rhs.packed())
+        return (_key == rhs._key);
     // Invoke equal on derived types
     return equal(rhs);
 }
@@ -37,6 +57,9 @@ bool Cost::operator<(const Cost& rhs) const
         ERROR("Cost: disequality between different types");
         return false;
     }
+    // fast path: compare the sort keys
+    if (packed() and rhs.packed())
+        return (_key < rhs._key);
     // Invoke smaller on derived types
     return smaller(rhs);
 }
@@ -68,7 +91,79 @@ Cost& Cost::operator+=(const Cost& rhs)
         ERROR("Cost: sum between different types");
     }
     // Invoke smaller on derived types
-    return add(rhs);
+    add(rhs);
+    rekey();
+    return *this;
+}
+
+
+Cost& Cost::operator-=(const Cost& rhs)
+{
+    // RTTI check
+    if (typeid(*this) != typeid(rhs))
+    {
+        ERROR("Cost: difference between different types");
+    }
+    sub(rhs);
+    rekey();
+    return *this;
+}
+
+
+bool Cost::update(const enum NoteName& name,
+                  const enum Accid& accid,
+                  bool printed,
+                  const Ton& gton,
+                  const Ton& lton,
+                  const enum NoteName& prev_name)
+{
+    bool ret = updateCost(name, accid, printed, gton, lton, prev_name);
+    if (ret)
+        rekey();
+    return ret;
+}
+
+
+void Cost::rekey()
+{
+    _key = packKey();
+}
+
+
+size_t Cost::primary() const
+{
+    return 0;
+}
+
+
+double Cost::magnitude() const
+{
+    return (double) primary();
+}
+
+
+bool Cost::far(double lb, double d) const
+{
+    assert(d >= 0);
+    double m = magnitude();
+    // dist is increasing in the magnitude of the larger cost
+    if (lb <= m)
+        return false;
+    else if (m == 0)
+        return true;
+    else
+        return (dist(lb, m) > d);
+}
+
+
+bool Cost::pack(uint64_t& key, size_t val, unsigned int width)
+{
+    assert(0 < width);
+    assert(width < 64);
+    if (val >> width)
+        return false;
+    key = (key << width) | val;
+    return true;
 }
 
 
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <assert.h>
 #include <memory>
+#include <cstdint>
 
 #include "pstrace.hpp"
 #include "PSEnum.hpp"
@@ -29,10 +30,27 @@ namespace pse {
 /// Cost model for the ordering of configuration of the PS algorithm.
 /// @see Note Spelling Conventions in Behind Bars (page 85).
 /// this abstract class defines the cost update interface.
+///
+/// Every cost value caches a sort key: its components packed, in the order
+/// of comparison, into one integer. When the keys of two costs of the same
+/// type are defined, the comparison operators reduce to an integer
+/// comparison, without virtual call.
+/// The key is recomputed after every update and sum.
 class Cost
 {
     
 public: // construction
+
+    /// undefined sort key, when one component overflows its field.
+    static const uint64_t NOKEY;
+
+    /// null cost, with key 0.
+    Cost();
+
+    /// copy of the key.
+    Cost(const Cost& rhs);
+
+    virtual ~Cost();
     
     /// create a new null cost value.
     virtual std::shared_ptr<Cost> shared_zero() const = 0;
@@ -97,6 +115,11 @@ public: // operators, update
     /// @param rhs a cost to add.
     Cost& operator+=(const Cost& rhs);
 
+    /// difference operator. update this cost by removing rhs,
+    /// inverse of +=.
+    /// @param rhs a cost to remove. it must have been added to this cost.
+    Cost& operator-=(const Cost& rhs);
+
 protected: // comparison operators
     
     /// cost equality.
@@ -111,6 +134,10 @@ protected: // comparison operators
     /// @param rhs a cost to add.
     virtual Cost& add(const Cost& rhs) = 0;
 
+    /// difference of costs. update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    virtual Cost& sub(const Cost& rhs) = 0;
+
     /// a distance value, in percent of the smallest cost between this and rhs.
     /// @return 0 if this and rhs are not comparable for this measure,
     /// a negative value (percent) is this is larger to rhs,
@@ -139,6 +166,12 @@ protected: // comparison operators templates and static
     template<typename T>
     Cost& add(const Cost& rhs);
 
+    /// difference of costs. update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    /// @see used by -=
+    template<typename T>
+    Cost& sub(const Cost& rhs);
+
     /// a distance value, in percent of the smallest cost between this and rhs.
     /// @return 0 if this and rhs are not comparable for this measure,
     /// a negative value (percent) is this is larger to rhs,
@@ -174,19 +207,78 @@ public: // operators, update
     /// the received pitch (before processing it). Notename::Undef if the pitch
     /// was never assiated a name in the configuration's state.
     /// @return wether an update was effectively performed.
-    virtual bool update(const enum NoteName& name,
-                        const enum Accid& accid,
-                        bool printed,
-                        const Ton& gton,
-                        const Ton& lton = Ton(),
-                        const enum NoteName& prev_name = NoteName::Undef) = 0;
-    
+    bool update(const enum NoteName& name,
+                const enum Accid& accid,
+                bool printed,
+                const Ton& gton,
+                const Ton& lton = Ton(),
+                const enum NoteName& prev_name = NoteName::Undef);
+
+protected: // update and sort key
+
+    /// update the components of this cost.
+    /// @see update for the parameters.
+    virtual bool updateCost(const enum NoteName& name,
+                            const enum Accid& accid,
+                            bool printed,
+                            const Ton& gton,
+                            const Ton& lton = Ton(),
+                            const enum NoteName& prev_name = NoteName::Undef) = 0;
+
+    /// components of this cost packed in the order of comparison,
+    /// such that equality and strict inequality of costs correspond to
+    /// the equality and strict inequality of keys.
+    /// @return NOKEY if one component is too large for its field.
+    virtual uint64_t packKey() const = 0;
+
+    /// recompute the cached sort key.
+    /// must be called after every modification of the components.
+    void rekey();
+
+    /// shift the given key and store the given value in its lower bits.
+    /// @param key key under construction.
+    /// @param val value to add in key.
+    /// @param width number of bits for val.
+    /// @return whether val fits in width bits.
+    static bool pack(uint64_t& key, size_t val, unsigned int width);
+
 public: // access and debug
+
+    /// sort key of this cost value or NOKEY.
+    inline uint64_t key() const { return _key; }
+
+    /// whether the sort key of this cost value is defined.
+    inline bool packed() const { return (_key != NOKEY); }
+
+    /// first component of this cost in the order of comparison.
+    /// It is a small integer, non-decreasing along the transitions
+    /// of the best path search, used to index the buckets of PSCQueue.
+    /// @return 0 by default (one bucket).
+    virtual size_t primary() const;
+
+    /// value of this cost compared by dist, for the approximate equality.
+    /// It is additive (the magnitude of a sum of costs is the sum of their
+    /// magnitudes) and larger than or equal to the first component.
+    /// @return primary() by default.
+    virtual double magnitude() const;
+
+    /// every cost of the same type with a magnitude larger than or equal to
+    /// the given bound is at a distance larger than the given threshold
+    /// from this cost.
+    /// @param lb a lower bound of magnitude.
+    /// @param d a distance in percent, positive or null.
+    /// @see dist
+    bool far(double lb, double d) const;
     
     /// Cost type of this cost value.
     virtual CostType type() const = 0;
     
     virtual void print(std::ostream& o) const;
+
+private: // data
+
+    /// cached sort key.
+    uint64_t _key;
     
 };
 
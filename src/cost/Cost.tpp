@@ -77,6 +77,20 @@ Cost& Cost::add(const Cost& rhs)
 }
 
 
+template<typename T>
+Cost& Cost::sub(const Cost& rhs)
+{
+    // check if the dynamic types match
+    assert(typeid(rhs) == typeid(T));
+
+    // cast to the concrete types; thanks to the check above this is safe
+    const T& rhs_T = static_cast<const T&>(rhs);
+
+    // redirect to T operator
+    return static_cast<T*>(this)->T::sub(rhs_T);
+}
+
+
 template<typename T>
 double Cost::pdist(const Cost& rhs) const
 {
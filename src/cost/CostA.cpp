@@ -16,12 +16,14 @@ namespace pse {
 
 
 CostA::CostA():
+Cost(),
 _accid(0),
 _inconsist(0)
 { }
 
 
 CostA::CostA(const CostA& rhs):
+Cost(rhs),
 _accid(rhs._accid),
 _inconsist(rhs._inconsist)
 { }
@@ -54,6 +56,16 @@ CostA& CostA::add(const CostA& rhs)
 }
 
 
+CostA& CostA::sub(const CostA& rhs)
+{
+    assert(rhs._accid <= _accid);
+    assert(rhs._inconsist <= _inconsist);
+    _accid -= rhs._accid;
+    _inconsist -= rhs._inconsist;
+    return *this;
+}
+
+
 double CostA::pdist(const CostA& rhs) const
 {
     return Cost::dist((double) _accid, (double) rhs._accid);
@@ -109,9 +121,9 @@ bool CostA::updateInconsistency(const enum NoteName& prev_name,
 
 
 // update cost when accident for the name was updated
-bool CostA::update(const enum NoteName& name, const enum Accid& accid,
-                   bool print, const Ton& gton, const Ton& lton,
-                   const enum NoteName& prev_name)
+bool CostA::updateCost(const enum NoteName& name, const enum Accid& accid,
+                       bool print, const Ton& gton, const Ton& lton,
+                       const enum NoteName& prev_name)
 {
     bool reti = updateInconsistency(prev_name, name);
     bool reta = updateAccid(name, accid, print, gton, lton);
@@ -120,6 +132,22 @@ bool CostA::update(const enum NoteName& name, const enum Accid& accid,
 }
 
 
+uint64_t CostA::packKey() const
+{
+    uint64_t key = 0;
+    if (Cost::pack(key, _accid, 32))
+        return key;
+    else
+        return Cost::NOKEY;
+}
+
+
+size_t CostA::primary() const
+{
+    return _accid;
+}
+
+
 CostType CostA::type() const
 {
     // if (_discount)
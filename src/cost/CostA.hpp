@@ -62,6 +62,10 @@ public: // operators called in Cost
     /// @param rhs a cost to add.
     CostA& add(const CostA& rhs);
 
+    /// update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    CostA& sub(const CostA& rhs);
+
     /// a distance value, in percent of the smaller cost.
     /// used for approximate equality.
     /// @warning only used for selection of global (rowcost comparison).
@@ -84,6 +88,11 @@ protected: // operators
     Cost& add(const Cost& rhs) override
     { return Cost::add<CostA>(rhs); }
 
+    /// update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    Cost& sub(const Cost& rhs) override
+    { return Cost::sub<CostA>(rhs); }
+
     /// a distance value, in percent of the smaller cost.
     /// used for approximate equality.
     /// @warning only used for selection of global (rowcost comparison).
@@ -102,7 +111,7 @@ protected: // operators
     // @param rhs a cost to compare to.
     double tiebreak_pdist(const CostA& rhs) const;
     
-public: // update
+protected: // update
 
     /// update this cost for doing a transition renaming one note (single
     /// or in chord) with the given parameters and in a given hypothetic global
@@ -119,11 +128,14 @@ public: // update
     /// the received pitch (before processing it). Notename::Undef if the pitch
     /// was never assiated a name in the configuration's state.
     /// @return wether an update was effectively performed.
-    bool update(const enum NoteName& name,
-                const enum Accid& accid,
-                bool print,
-                const Ton& gton, const Ton& lton = Ton(),
-                const enum NoteName& prev_name = NoteName::Undef) override;
+    bool updateCost(const enum NoteName& name,
+                    const enum Accid& accid,
+                    bool print,
+                    const Ton& gton, const Ton& lton = Ton(),
+                    const enum NoteName& prev_name = NoteName::Undef) override;
+
+    /// sort key: number of accidentals.
+    uint64_t packKey() const override;
 
 protected: // update member
 
@@ -155,6 +167,9 @@ public: // access and debug
     /// accessor for debug.
     inline size_t get_accid() const { return _accid; }
 
+    /// number of accidentals (first component of comparison).
+    size_t primary() const override;
+
     /// Cost type of this const value.
     virtual CostType type() const override;
     
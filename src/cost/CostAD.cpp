@@ -47,6 +47,15 @@ Cost& CostAD::add(const CostAD& rhs)
 }
 
 
+Cost& CostAD::sub(const CostAD& rhs)
+{
+    CostAT::sub(rhs);
+    assert(rhs._dist <= _dist);
+    _dist -= rhs._dist;
+    return *this;
+}
+
+
 bool CostAD::updateDist(const enum NoteName& name, const enum Accid& accid,
                         bool print, const Ton& gton, const Ton& lton)
 {
@@ -82,19 +91,44 @@ bool CostAD::updateDist(const enum NoteName& name, const enum Accid& accid,
 }
 
 
-bool CostAD::update(const enum NoteName& name,
-                    const enum Accid& accid,
-                    bool print,
-                    const Ton& gton, const Ton& lton,
-                    const enum NoteName& prev_name)
+bool CostAD::updateCost(const enum NoteName& name,
+                        const enum Accid& accid,
+                        bool print,
+                        const Ton& gton, const Ton& lton,
+                        const enum NoteName& prev_name)
 {
-    bool reta = CostAT::update(name, accid, print, gton, lton, prev_name);
+    bool reta = CostAT::updateCost(name, accid, print, gton, lton, prev_name);
     bool retd = updateDist(name, accid, print, gton, lton);
 
     return reta or retd;
 }
 
 
+// 16 bits for accids, 12 bits for dist and each tie-break component.
+uint64_t CostAD::packKeyDist() const
+{
+    uint64_t key = 0;
+    if (_tblex)
+    {
+        if (Cost::pack(key, _accid, 16) and
+            Cost::pack(key, _dist, 12) and
+            Cost::pack(key, _cflat + _double, 12) and
+            Cost::pack(key, _chromharm, 12) and
+            Cost::pack(key, _color, 12))
+            return key;
+    }
+    else
+    {
+        if (Cost::pack(key, _accid, 16) and
+            Cost::pack(key, _dist, 12) and
+            Cost::pack(key, _tbsum, 12) and
+            Cost::pack(key, _chromharm, 12))
+            return key;
+    }
+    return Cost::NOKEY;
+}
+
+
 void CostAD::print(std::ostream& o) const
 {
     CostAT::print(o);
@@ -234,6 +268,7 @@ void CostAD::update_tonale(const enum NoteName& name,
     {
         _color += 1;
     }
+    rekey();
 }
 
 
@@ -346,6 +381,7 @@ void CostAD::update99(const enum NoteName& name,
     {
         _color += 1;
     }
+    rekey();
 }
 
 
@@ -58,13 +58,17 @@ public: // operators called in Cost
     /// update this cost by adding rhs componentwise.
     /// @param rhs a cost to add.
     Cost& add(const CostAD& rhs);
+
+    /// update this cost by removing rhs componentwise.
+    /// @param rhs a cost to remove, previously added to this cost.
+    Cost& sub(const CostAD& rhs);
     
     // a distance value, in percent of the bigger cost.
     // used for approximate equality.
     // @todo RM already defined in Cost
     // virtual double pdist(const CostAD& rhs) const = 0;
        
-public: // update
+protected: // update
     
     /// update this cost for doing a transition renaming one note (single
     /// or in chord) with the given parameters and in a given hypothetic global
@@ -80,12 +84,14 @@ public: // update
     /// the received pitch (before processing it). Notename::Undef if the pitch
     /// was never assiated a name in the configuration's state.
     /// @return wether an update was effectively performed.
-    bool update(const enum NoteName& name,
-                const enum Accid& accid,
-                bool print,
-                const Ton& gton, const Ton& lton = Ton(),
-                const enum NoteName& prev_name = NoteName::Undef) override;
+    bool updateCost(const enum NoteName& name,
+                    const enum Accid& accid,
+                    bool print,
+                    const Ton& gton, const Ton& lton = Ton(),
+                    const enum NoteName& prev_name = NoteName::Undef) override;
     
+public: // update variants
+
     /// version of the TENOR article
     virtual void update_tonale(const enum NoteName& name,
                                const enum Accid& accid,
@@ -113,6 +119,12 @@ protected: // update
                             const enum Accid& accid,
                             bool print,
                             const Ton& gton, const Ton& lton = Ton());
+
+    /// sort key for the lexicographic orderings with dist as second
+    /// component: number of accidentals, dist, and the tie-break
+    /// components, in the order of tiebreak_smaller.
+    /// @see CostADlex and CostADplex.
+    uint64_t packKeyDist() const;
     
     
 public: // access, debug
@@ -57,6 +57,20 @@ bool CostADlex::smaller(const CostADlex& rhs) const
  }
 
 
+// same as CostAD::sub
+Cost& CostADlex::sub(const CostADlex& rhs)
+{
+    CostAD::sub(rhs);
+    return *this;
+}
+
+
+double CostADlex::magnitude() const
+{
+    return (double) _accid + _dist;
+}
+
+
 /// @todo TBR sum of dists ?
 double CostADlex::pdist(const CostADlex& rhs) const
 {
@@ -71,6 +71,11 @@ public: // operators called in Cost
     /// @see same as CostAD
     Cost& add(const CostADlex& rhs);
 
+    /// difference operator. update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    /// @see same as CostAD
+    Cost& sub(const CostADlex& rhs);
+
     /// a distance value, in percent of the bigger cost.
     /// used for approximate equality.
     /// @warning only used for selection of global (rowcost comparison).
@@ -92,6 +97,11 @@ protected: // operators
     /// @param rhs a cost to add.
     Cost& add(const Cost& rhs) override
     { return Cost::add<CostADlex>(rhs); }
+
+    /// update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    Cost& sub(const Cost& rhs) override
+    { return Cost::sub<CostADlex>(rhs); }
     
     /// a distance value, in percent of the smaller cost.
     /// used for approximate equality.
@@ -99,7 +109,14 @@ protected: // operators
     double pdist(const Cost& rhs) const override
     { return Cost::pdist<CostADlex>(rhs); }
 
+    /// sort key: accidentals, dist, tie-break components.
+    uint64_t packKey() const override
+    { return packKeyDist(); }
+
 public: // access, debug
+
+    /// sum of the number of accidents and the distance, compared by dist.
+    double magnitude() const override;
     
     /// Cost type of this const value.
     virtual CostType type() const override;
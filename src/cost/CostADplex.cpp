@@ -61,6 +61,14 @@ Cost& CostADplex::add(const CostADplex& rhs)
 }
 
 
+// same as CostAD::sub
+Cost& CostADplex::sub(const CostADplex& rhs)
+{
+    CostAD::sub(rhs);
+    return *this;
+}
+
+
 double CostADplex::pdist(const CostADplex& rhs) const
 {
     // _accid is the sum of nb of accids and dist
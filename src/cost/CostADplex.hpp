@@ -67,6 +67,11 @@ public: // operators called in Cost
     /// @param rhs a cost to add.
     Cost& add(const CostADplex& rhs);
 
+    /// difference operator. update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    /// @see same as CostAD
+    Cost& sub(const CostADplex& rhs);
+
     /// a distance value, in percent of the bigger cost.
     /// used for approximate equality.
     /// @warning only used for selection of global (rowcost comparison).
@@ -88,12 +93,21 @@ protected: // operators
     /// @param rhs a cost to add.
     Cost& add(const Cost& rhs) override
     { return Cost::add<CostADplex>(rhs); }
+
+    /// update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    Cost& sub(const Cost& rhs) override
+    { return Cost::sub<CostADplex>(rhs); }
     
     /// a distance value, in percent of the smaller cost.
     /// used for approximate equality.
     /// @warning only used for selection of global (rowcost comparison).
     double pdist(const Cost& rhs) const override
     { return Cost::pdist<CostADplex>(rhs); }
+
+    /// sort key: accidentals, dist, tie-break components.
+    uint64_t packKey() const override
+    { return packKeyDist(); }
            
 public: // debug
     
@@ -67,6 +67,14 @@ Cost& CostADplus::add(const CostADplus& rhs)
 }
 
 
+// same as CostAD::sub
+Cost& CostADplus::sub(const CostADplus& rhs)
+{
+    CostAD::sub(rhs);
+    return *this;
+}
+
+
 // TBR
 double CostADplus::pdist(const CostADplus& rhs) const
 {
@@ -95,13 +103,13 @@ size_t CostADplus::accids() const
 }
 
 
-bool CostADplus::update(const enum NoteName& name, const enum Accid& accid,
-                        bool print, const Ton& gton, const Ton& lton,
-                        const enum NoteName& prev_name)
+bool CostADplus::updateCost(const enum NoteName& name, const enum Accid& accid,
+                            bool print, const Ton& gton, const Ton& lton,
+                            const enum NoteName& prev_name)
 {
     size_t olddist(_dist);
     // update accid and dist
-    bool ret = CostAD::update(name, accid, print, gton, lton, prev_name);
+    bool ret = CostAD::updateCost(name, accid, print, gton, lton, prev_name);
     // dist has been increased (by new dists)
     assert(olddist <= _dist);
     // _accid was increased only by new accids, add the new dists
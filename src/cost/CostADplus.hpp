@@ -71,6 +71,11 @@ public: // operators called in Cost
     /// @see same as CostAD
     Cost& add(const CostADplus& rhs);
 
+    /// difference operator. update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    /// @see same as CostAD
+    Cost& sub(const CostADplus& rhs);
+
     /// a distance value, in percent of the bigger cost.
     /// used for approximate equality.
     /// @warning only used for selection of global (rowcost comparison).
@@ -92,6 +97,11 @@ protected: // operators
     /// @param rhs a cost to add.
     Cost& add(const Cost& rhs) override
     { return Cost::add<CostADplus>(rhs); }
+
+    /// update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    Cost& sub(const Cost& rhs) override
+    { return Cost::sub<CostADplus>(rhs); }
     
     /// a distance value, in percent of the smaller cost.
     /// used for approximate equality.
@@ -99,7 +109,7 @@ protected: // operators
     double pdist(const Cost& rhs) const override
     { return Cost::pdist<CostADplus>(rhs); }
         
-public: // update
+protected: // update
     
     /// update this cost for doing a transition renaming one note (single
     /// or in chord) with the given parameters and in a given hypothetic global
@@ -116,11 +126,11 @@ public: // update
     /// was never assiated a name in the configuration's state.
     /// @return wether an update was effectively performed.
     /// @see perform the update of CostAD and add dist to accid.
-    bool update(const enum NoteName& name,
-                const enum Accid& accid,
-                bool print,
-                const Ton& gton, const Ton& lton = Ton(),
-                const enum NoteName& prev_name = NoteName::Undef) override;
+    bool updateCost(const enum NoteName& name,
+                    const enum Accid& accid,
+                    bool print,
+                    const Ton& gton, const Ton& lton = Ton(),
+                    const enum NoteName& prev_name = NoteName::Undef) override;
 
 protected: // access
     
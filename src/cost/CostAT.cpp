@@ -73,6 +73,23 @@ CostAT& CostAT::add(const CostAT& rhs)
 }
 
 
+CostAT& CostAT::sub(const CostAT& rhs)
+{
+    assert(_tbsum == _color + _cflat + _double);
+    assert(rhs._tbsum == rhs._color + rhs._cflat + rhs._double);
+    // remove accids
+    CostA::sub(rhs);
+    // remove Tie Breaking components
+    assert(rhs._tbsum <= _tbsum);
+    _chromharm -= rhs._chromharm;
+    _color -= rhs._color;
+    _cflat -= rhs._cflat;
+    _double -= rhs._double;
+    _tbsum -= rhs._tbsum;
+    return *this;
+}
+
+
 // is only used for selection of global (rowcost comparison)
 double CostAT::pdist(const CostAT& rhs) const
 {
@@ -508,11 +525,11 @@ bool CostAT::updateDouble(const enum NoteName& name, const enum Accid& accid,
 
 
 // update cost when accident for the name was updated
-bool CostAT::update(const enum NoteName& name, const enum Accid& accid,
-                    bool printed, const Ton& gton, const Ton& lton,
-                    const enum NoteName& prev_name)
+bool CostAT::updateCost(const enum NoteName& name, const enum Accid& accid,
+                        bool printed, const Ton& gton, const Ton& lton,
+                        const enum NoteName& prev_name)
 {
-    bool ret = CostA::update(name, accid, printed, gton, lton, prev_name);
+    bool ret = CostA::updateCost(name, accid, printed, gton, lton, prev_name);
 
     // update only for printed accidentals
     if (printed)
@@ -529,6 +546,30 @@ bool CostAT::update(const enum NoteName& name, const enum Accid& accid,
 }
 
 
+// 16 bits per component, in the order of
+// tiebreak_smaller_lex00 and tiebreak_smaller_sum.
+uint64_t CostAT::packKey() const
+{
+    uint64_t key = 0;
+    if (_tblex)
+    {
+        if (Cost::pack(key, _accid, 16) and
+            Cost::pack(key, _cflat + _double, 16) and
+            Cost::pack(key, _chromharm, 16) and
+            Cost::pack(key, _color, 16))
+            return key;
+    }
+    else
+    {
+        if (Cost::pack(key, _accid, 16) and
+            Cost::pack(key, _tbsum, 16) and
+            Cost::pack(key, _chromharm, 16))
+            return key;
+    }
+    return Cost::NOKEY;
+}
+
+
 CostType CostAT::type() const
 {
     if (_tblex)
@@ -65,6 +65,10 @@ public: // operators called in Cost
     /// cumulated sum operator. update this cost by adding rhs.
     /// @param rhs a cost to add.
     virtual CostAT& add(const CostAT& rhs);
+
+    /// difference operator. update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    virtual CostAT& sub(const CostAT& rhs);
     
     /// a distance value, in percent of the smaller cost.
     /// used for approximate equality.
@@ -87,6 +91,11 @@ protected: // operators
     /// @param rhs a cost to add.
     Cost& add(const Cost& rhs) override
     { return Cost::add<CostAT>(rhs); }
+
+    /// update this cost by removing rhs.
+    /// @param rhs a cost to remove, previously added to this cost.
+    Cost& sub(const Cost& rhs) override
+    { return Cost::sub<CostAT>(rhs); }
     
     /// a distance value, in percent of the smaller cost.
     /// used for approximate equality.
@@ -181,7 +190,7 @@ protected: // operators
     /// @param rhs a cost to compare to.
     double tiebreak_pdist(const CostAT& rhs) const;
 
-public: // update
+protected: // update
 
     /// update this cost for doing a transition renaming one note (single
     /// or in chord) with the given parameters and in a given hypothetic global
@@ -198,11 +207,15 @@ public: // update
     /// the received pitch (before processing it). Notename::Undef if the pitch
     /// was never assiated a name in the configuration's state.
     /// @return wether an update was effectively performed.
-    bool update(const enum NoteName& name,
-                const enum Accid& accid,
-                bool print,
-                const Ton& gton, const Ton& lton = Ton(),
-                const enum NoteName& prev_name = NoteName::Undef) override;
+    bool updateCost(const enum NoteName& name,
+                    const enum Accid& accid,
+                    bool print,
+                    const Ton& gton, const Ton& lton = Ton(),
+                    const enum NoteName& prev_name = NoteName::Undef) override;
+
+    /// sort key: number of accidentals followed by the tie-break
+    /// components, in the order of tiebreak_smaller.
+    uint64_t packKey() const override;
 
 protected: // update members
 
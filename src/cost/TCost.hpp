@@ -59,6 +59,9 @@ protected: // comparison
     /// override Cost::add
     Cost& add(const Cost& rhs);
 
+    /// override Cost::sub
+    Cost& sub(const Cost& rhs);
+
     /// override Cost::pdist
     double pdist(const Cost& rhs) const;
     
@@ -50,6 +50,20 @@ Cost& TCost<T>::add(const Cost& rhs)
 }
 
 
+template<typename T>
+Cost& TCost<T>::sub(const Cost& rhs)
+{
+    // check if the dynamic types match
+    assert(typeid(rhs) == typeid(T));
+
+    // cast to the concrete types; thanks to the check above this is safe
+    const T& rhs_T = static_cast<const T&>(rhs);
+
+    // redirect to T operator
+    return T::sub(rhs_T);
+}
+
+
 template<typename T>
 double TCost<T>::pdist(const Cost& rhs) const
 {
@@ -0,0 +1,186 @@
+//
+//  PSPool.cpp
+//  pse
+//
+//  Created by agent on 17/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+
+#include <algorithm>
+
+#include "PSPool.hpp"
+
+
+namespace pse {
+
+
+PSPool::PSPool(size_t threads):
+_threads((threads == 0)?hardware():threads),
+_workers(),
+_blocks(_threads),
+_task(nullptr),
+_generation(0),
+_pending(0),
+_stop(false),
+_error(),
+_failed(false),
+_mutex(),
+_start(),
+_done(),
+_running()
+{
+    assert(_threads > 0);
+    for (Block& b : _blocks)
+        b.range = 0;
+    // the calling thread of run is worker 0
+    _workers.reserve(_threads - 1);
+    for (size_t w = 1; w < _threads; ++w)
+        _workers.emplace_back(&PSPool::loop, this, w);
+}
+
+
+PSPool::~PSPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _start.notify_all();
+    for (std::thread& t : _workers)
+        t.join();
+}
+
+
+size_t PSPool::hardware()
+{
+    unsigned int n = std::thread::hardware_concurrency();
+    return (n == 0)?1:n;
+}
+
+
+void PSPool::run(size_t n,
+                 const std::function<void(size_t, size_t)>& task)
+{
+    // sequential
+    if (_threads == 1 or n <= 1)
+    {
+        for (size_t k = 0; k < n; ++k)
+            task(k, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> running(_running);
+    assert(n <= UINT32_MAX);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        assert(_task == nullptr);
+        assert(_pending == 0);
+        _task = &task;
+        _error = nullptr;
+        _failed = false;
+        // contiguous blocks of tasks
+        for (size_t w = 0; w < _threads; ++w)
+        {
+            uint64_t lo = (n * w) / _threads;
+            uint64_t hi = (n * (w + 1)) / _threads;
+            _blocks[w].range = (lo << 32) | hi;
+        }
+        _pending = _threads - 1;
+        ++_generation;
+    }
+    _start.notify_all();
+    work(0);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]{ return _pending == 0; });
+        _task = nullptr;
+        error = _error;
+        _error = nullptr;
+    }
+    TRACE("PSPool: {} tasks run on {} workers", n, _threads);
+    if (error)
+        std::rethrow_exception(error);
+}
+
+
+void PSPool::loop(size_t w)
+{
+    size_t seen = 0; // last run
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _start.wait(lock, [this, seen]
+                        { return _stop or _generation != seen; });
+            if (_stop)
+                return;
+            seen = _generation;
+        }
+        work(w);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            assert(_pending > 0);
+            --_pending;
+            if (_pending == 0)
+                _done.notify_one();
+        }
+    }
+}
+
+
+void PSPool::work(size_t w)
+{
+    assert(w < _threads);
+    assert(_task);
+    size_t k;
+    while (not _failed)
+    {
+        // own tasks in order, then the last tasks of the other workers
+        bool found = take(w, k, false);
+        for (size_t i = 1; i < _threads and not found; ++i)
+            found = take((w + i) % _threads, k, true);
+        if (not found)
+            return;
+        try
+        {
+            (*_task)(k, w);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (not _error)
+                _error = std::current_exception();
+            _failed = true;
+        }
+    }
+}
+
+
+bool PSPool::take(size_t w, size_t& k, bool last)
+{
+    assert(w < _blocks.size());
+    std::atomic<uint64_t>& range = _blocks[w].range;
+    uint64_t r = range.load();
+    while (true)
+    {
+        uint64_t lo = r >> 32;
+        uint64_t hi = r & UINT32_MAX;
+        if (lo >= hi)
+            return false;
+        uint64_t next = last?((lo << 32) | (hi - 1)):(((lo + 1) << 32) | hi);
+        if (range.compare_exchange_weak(r, next))
+        {
+            k = (size_t) (last?(hi - 1):lo);
+            return true;
+        }
+    }
+}
+
+
+} // end namespace pse
+
+/// @}
@@ -0,0 +1,149 @@
+//
+//  PSPool.hpp
+//  pse
+//
+//  Created by agent on 17/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+
+#ifndef PSPool_hpp
+#define PSPool_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <functional>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstdint>
+
+#include "pstrace.hpp"
+
+
+namespace pse {
+
+/// pool of worker threads for running families of independent tasks
+/// indexed by 0..n-1.
+/// The workers are started with the pool and kept alive from one family
+/// of tasks to the next, until the pool is destroyed.
+/// The tasks are scheduled by work stealing: every worker first runs the
+/// tasks of its own block of indices, in increasing order, and then steals
+/// the last tasks of the blocks of the other workers, so that tasks of
+/// unequal durations are balanced over the workers.
+/// The tasks must write their results at positions determined by their
+/// index, hence the results do not depend on the scheduling.
+class PSPool
+{
+public:
+
+    /// pool of given number of workers.
+    /// @param threads number of workers.
+    /// 0 for the number of hardware threads available.
+    /// with 1 worker, the tasks are run in the calling thread.
+    /// Otherwise, the calling thread of run is one of the workers,
+    /// and threads-1 threads are started.
+    PSPool(size_t threads = 1);
+
+    /// a pool cannot be copied.
+    PSPool(const PSPool& rhs) = delete;
+
+    /// stop and join the workers.
+    ~PSPool();
+
+    /// a pool cannot be copied.
+    PSPool& operator=(const PSPool& rhs) = delete;
+
+    /// number of workers of this pool.
+    inline size_t threads() const { return _threads; }
+
+    /// number of hardware threads available, at least 1.
+    static size_t hardware();
+
+    /// run the given task for all indices in 0..n-1 and return when all
+    /// the tasks are completed.
+    /// @param n number of tasks.
+    /// @param task function called with the index of task in 0..n-1
+    /// and the index of the worker running it in 0..threads()-1.
+    /// it must be thread-safe for distinct task indices.
+    /// If a task throws an exception, the tasks not started are skipped,
+    /// and the first exception is rethrown in the calling thread.
+    /// Concurrent calls are run one after the other.
+    /// @warning must not be called by a task of this pool.
+    void run(size_t n, const std::function<void(size_t, size_t)>& task);
+
+private:
+
+    /// block of indices of tasks not started of one worker,
+    /// packed in one word: first index (high half) and end (low half).
+    struct alignas(64) Block
+    {
+        std::atomic<uint64_t> range;
+    };
+
+    /// number of workers.
+    const size_t _threads;
+
+    /// workers 1..threads-1 (the worker 0 is the calling thread of run).
+    std::vector<std::thread> _workers;
+
+    /// blocks of tasks, one per worker.
+    std::vector<Block> _blocks;
+
+    /// tasks of the current run, null between runs.
+    const std::function<void(size_t, size_t)>* _task;
+
+    /// number of the current run, for waking up the workers.
+    size_t _generation;
+
+    /// number of workers still running tasks of the current run,
+    /// excepted the calling thread.
+    size_t _pending;
+
+    /// whether the workers must stop.
+    bool _stop;
+
+    /// first exception thrown by a task of the current run.
+    std::exception_ptr _error;
+
+    /// whether a task of the current run has thrown an exception.
+    std::atomic<bool> _failed;
+
+    /// for the fields of the current run.
+    std::mutex _mutex;
+
+    /// signal of a new run or of stop to the workers.
+    std::condition_variable _start;
+
+    /// signal of the end of the tasks of the workers.
+    std::condition_variable _done;
+
+    /// for concurrent calls to run.
+    std::mutex _running;
+
+    /// main loop of the worker of given index.
+    void loop(size_t w);
+
+    /// run the tasks of the current run with the worker of given index,
+    /// its own tasks first and then tasks stolen from the other workers.
+    void work(size_t w);
+
+    /// take the next task of the block of the given worker.
+    /// @param w index of a worker.
+    /// @param k index of the task taken.
+    /// @param last whether the last task is taken instead of the first one.
+    /// @return whether a task was taken.
+    bool take(size_t w, size_t& k, bool last);
+
+};
+
+
+} // namespace pse
+
+#endif /* PSPool_hpp */
+
+/// @}
@@ -0,0 +1,131 @@
+//
+//  MinPlus.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include "MinPlus.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+namespace pse {
+
+namespace util {
+
+// static
+const int32_t MinPlus::INF;
+
+// static
+const size_t MinPlus::LANES;
+
+
+size_t MinPlus::argmin_scalar(const int32_t* p, const int32_t* w, size_t n,
+                              int32_t& best)
+{
+    assert(p);
+    assert(w);
+    best = INF;
+    int32_t bestp = INF;
+    size_t ibest = n;
+    for (size_t k = 0; k < n; ++k)
+    {
+        if (p[k] == INF)
+            continue;
+        assert(0 <= w[k]);
+        assert(p[k] <= INF - w[k]);
+        int32_t c = p[k] + w[k];
+        // in case of tie, keep the smaller predecessor cost,
+        // and then the smaller index
+        if (c < best or (c == best and p[k] < bestp))
+        {
+            best = c;
+            bestp = p[k];
+            ibest = k;
+        }
+    }
+    return ibest;
+}
+
+
+#if defined(__AVX2__)
+
+size_t MinPlus::argmin(const int32_t* p, const int32_t* w, size_t n,
+                       int32_t& best)
+{
+    assert(p);
+    assert(w);
+    const size_t np = padded(n);
+    const __m256i inf = _mm256_set1_epi32(INF);
+    const __m256i step = _mm256_set1_epi32((int32_t) LANES);
+    // best cost, predecessor cost and index in each lane
+    __m256i bc = inf;
+    __m256i bp = inf;
+    __m256i bi = _mm256_set1_epi32((int32_t) n);
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (size_t k = 0; k < np; k += LANES)
+    {
+        __m256i vp = _mm256_loadu_si256((const __m256i*) (p + k));
+        __m256i vw = _mm256_loadu_si256((const __m256i*) (w + k));
+        // INF is absorbing
+        __m256i c = _mm256_blendv_epi8(_mm256_add_epi32(vp, vw), inf,
+                                       _mm256_cmpeq_epi32(vp, inf));
+        // c < bc or (c == bc and vp < bp).
+        // the indices increase in each lane, ties keep the smaller index.
+        __m256i upd = _mm256_or_si256(_mm256_cmpgt_epi32(bc, c),
+                      _mm256_and_si256(_mm256_cmpeq_epi32(c, bc),
+                                       _mm256_cmpgt_epi32(bp, vp)));
+        bc = _mm256_blendv_epi8(bc, c, upd);
+        bp = _mm256_blendv_epi8(bp, vp, upd);
+        bi = _mm256_blendv_epi8(bi, idx, upd);
+        idx = _mm256_add_epi32(idx, step);
+    }
+    
+    // reduction of the lanes
+    alignas(32) int32_t lc[LANES];
+    alignas(32) int32_t lp[LANES];
+    alignas(32) int32_t li[LANES];
+    _mm256_store_si256((__m256i*) lc, bc);
+    _mm256_store_si256((__m256i*) lp, bp);
+    _mm256_store_si256((__m256i*) li, bi);
+    best = INF;
+    int32_t bestp = INF;
+    size_t ibest = n;
+    for (size_t l = 0; l < LANES; ++l)
+    {
+        if (lc[l] == INF)
+            continue;
+        if (lc[l] < best or
+            (lc[l] == best and
+             (lp[l] < bestp or (lp[l] == bestp and (size_t) li[l] < ibest))))
+        {
+            best = lc[l];
+            bestp = lp[l];
+            ibest = li[l];
+        }
+    }
+    assert(ibest <= n);
+    return ibest;
+}
+
+#else
+
+size_t MinPlus::argmin(const int32_t* p, const int32_t* w, size_t n,
+                       int32_t& best)
+{
+    return argmin_scalar(p, w, n, best);
+}
+
+#endif
+
+
+} // namespace util
+
+} // namespace pse
+
+/// @}
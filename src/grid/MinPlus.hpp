@@ -0,0 +1,69 @@
+//
+//  MinPlus.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef MinPlus_hpp
+#define MinPlus_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <cstdint>
+#include <limits>
+
+
+namespace pse {
+
+namespace util {
+
+/// kernels of min-plus products on dense vectors of 32 bits costs,
+/// for the Viterbi algorithms on grids of tonalities.
+/// The vectors are padded to a multiple of LANES elements.
+/// Compiled with AVX2 instructions when they are available (__AVX2__),
+/// with a scalar fallback otherwise.
+class MinPlus
+{
+public:
+
+    /// infinite cost. it is absorbing for the sums in kernels.
+    static const int32_t INF = std::numeric_limits<int32_t>::max();
+
+    /// number of 32 bits costs processed in parallel.
+    static const size_t LANES = 8;
+
+    /// size of a vector of n costs, padded to a multiple of LANES.
+    static inline size_t padded(size_t n)
+    { return ((n + LANES - 1) / LANES) * LANES; }
+
+    /// best predecessor in a min-plus product.
+    /// @param p vector of predecessor costs, of length padded(n).
+    /// the padding elements must be INF.
+    /// @param w vector of transition weights, of length padded(n).
+    /// the weights must be non-negative and small enough for the sums
+    /// with finite costs to be smaller than INF.
+    /// @param n number of predecessors.
+    /// @param best receive the minimum of p[k] + w[k], for p[k] finite,
+    /// or INF if all the p[k] are INF.
+    /// @return the index k of a minimum, with priority in case of tie
+    /// to the smaller p[k] and then to the smaller index,
+    /// or n if all the p[k] are INF.
+    static size_t argmin(const int32_t* p, const int32_t* w, size_t n,
+                         int32_t& best);
+
+    /// scalar version of argmin.
+    static size_t argmin_scalar(const int32_t* p, const int32_t* w, size_t n,
+                                int32_t& best);
+
+};
+
+} // namespace util
+
+} // namespace pse
+
+#endif /* MinPlus_hpp */
+
+/// @}
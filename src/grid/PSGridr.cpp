@@ -57,25 +57,9 @@ void PSGr::init(const PST& tab)
             {
                 current.push_back(TonIndex::UNDEF);
             }
-            // in the first column (first measure)
-            else if (_content.size() == 1)
-            {
-                // estimation locals by mean of ranks
-                std::vector<size_t> ties; // empty
-                extractRank(vec, ties, i, i); // global and prev
-                current.push_back(breakTieRank(vec, ties, i, i));
-            }
-            // otherwise, consider previous column
             else
             {
-                assert(j > 0);
-                assert(j-1 < _content.size());
-                assert(i < _content.at(j-1).size());
-                size_t iprev = _content.at(j-1).at(i);
-                // estimation locals by mean of ranks
-                std::vector<size_t> ties; // empty
-                extractRank(vec, ties, i, iprev); // global = i
-                current.push_back(breakTieRank(vec, ties, i, iprev));
+                current.push_back(estimate(vec, i, j));
             }
             assert(current.back() == TonIndex::UNDEF ||
                    current.back() < _index.size());
@@ -85,6 +69,69 @@ void PSGr::init(const PST& tab)
 }
 
 
+size_t PSGr::estimate(const PSV& vec, size_t i, size_t j)
+{
+    assert(_index.isGlobal(i));
+    assert(j < _content.size());
+    // in the first column (first measure): previous local is the global
+    size_t iprev = i;
+    // otherwise, consider previous column
+    if (j > 0)
+    {
+        assert(i < _content.at(j-1).size());
+        iprev = _content.at(j-1).at(i);
+    }
+    // estimation locals by mean of ranks
+    std::vector<size_t> ties; // empty
+    extractRank(vec, ties, i, iprev); // global = i
+    return breakTieRank(vec, ties, i, iprev);
+}
+
+
+size_t PSGr::update(const PST& tab, const std::set<size_t>& bars,
+                    std::set<size_t>& changed)
+{
+    assert(tab.size() == _content.size());
+    // number of cells recomputed
+    size_t n = 0;
+    if (bars.empty())
+        return n;
+    
+    for (size_t i = 0; i < _index.size(); ++i)
+    {
+        if (!_index.isGlobal(i))
+            continue;
+        // the cell (i, j) depends only on the column j of tab and the
+        // cell (i, j-1): recompute the cells of modified columns and the
+        // cells following a changed cell, until no more change.
+        std::set<size_t>::const_iterator it = bars.cbegin();
+        size_t j = *it;
+        while (j < _content.size())
+        {
+            assert(i < _content[j].size());
+            const size_t former = _content[j][i];
+            _content[j][i] = estimate(tab.column(j), i, j);
+            ++n;
+            bool change = (_content[j][i] != former);
+            if (change)
+                changed.insert(j);
+            ++j;
+            // jump to the next modified column
+            if (! change)
+            {
+                it = bars.lower_bound(j);
+                if (it == bars.cend())
+                    break;
+                j = *it;
+            }
+        }
+    }
+    TRACE("PSGr update: {} cells recomputed, {} columns changed",
+          n, changed.size());
+    return n;
+}
+
+
 void PSGr::extractRank(const PSV& vec, std::vector<size_t>& ties,
                       size_t ig, size_t iprev)
 {
@@ -35,6 +35,19 @@ public: // construction
     PSGr(const PST& tab);
     
     virtual ~PSGr();
+
+    /// re-spelling: update this grid after the recomputation of some
+    /// columns of the table used for its construction.
+    /// Only the cells of the modified columns, and the cells following
+    /// a cell changed in the same row, are recomputed.
+    /// @param tab pitch spelling table used to build this grid,
+    /// with the same global tonalities as at the construction of this grid.
+    /// @param bars numbers of the columns of tab recomputed.
+    /// @param changed set of column numbers, completed with the numbers of
+    /// the columns of this grid changed by the update.
+    /// @return the number of cells recomputed.
+    size_t update(const PST& tab, const std::set<size_t>& bars,
+                  std::set<size_t>& changed);
     
 private: // construction
     
@@ -47,6 +60,14 @@ private: // construction
     /// fill this table of local tons.
     // @param flag whether the local estimation is done with rank means.
     void init(const PST& tab); 
+
+    /// estimate the local tonality of the cell of given row and column,
+    /// from the previous cell in the row.
+    /// @param vec column of tab for the measure j.
+    /// @param i index of assumed global tonality (row).
+    /// @param j measure number (column). The columns before j
+    /// must have been computed.
+    size_t estimate(const PSV& vec, size_t i, size_t j);
     
     /// select a local tonality for a measure,
     /// by computing the mean of ranks of tonalities
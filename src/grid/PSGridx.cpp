@@ -8,11 +8,12 @@
 #include "PSGridx.hpp"
 #include "PSTable.hpp"
 
+#include <limits>
+#include <algorithm>
+#include <tuple>
 
-namespace pse {
 
-// static
-size_t PSGx::COST_INFINITE = -1;
+namespace pse {
 
 // static
 size_t PSGx::PRED_UNDEF = -1;
@@ -27,9 +28,44 @@ const std::array<size_t, 3> PSGx::COEFF = {2, 1, 1};
 //{ }
 
 
-PSGx::PSGx(const PST& tab, bool singleton):
-PSG(tab)
+PSGx::PSGx(const PST& tab, bool singleton, size_t k, size_t lag):
+PSG(tab),
+_k(k),
+_paths(),
+_costs(),
+_lag(lag),
+_globals(),
+_weber(),
+_wglobal(),
+_pcosts(),
+_window(),
+_next(0)
 {
+    assert(k > 0);
+    assert(lag == 0 or (k == 1 and not singleton));
+    _paths.resize(_index.size());
+    _costs.resize(_index.size());
+
+    // online mode: the grid is initially empty,
+    // the columns of tab are processed by extend.
+    if (lag > 0)
+    {
+        TRACE("PSGridx: online grid with lag {}", lag);
+        for (size_t ig = 0; ig < _index.size(); ++ig)
+            if (_index.isGlobal(ig))
+                _globals.push_back(ig);
+        if (_globals.empty())
+        {
+            WARN("Grid computation: no global tons, the grid is empty.");
+            return;
+        }
+        weights(_globals, _weber, _wglobal);
+        _pcosts.assign(_globals.size() * util::MinPlus::padded(_index.size()),
+                       util::MinPlus::INF);
+        extend(tab);
+        return;
+    }
+
     init_empty(tab);
     
     // no tons, no grid.
@@ -54,14 +90,17 @@ PSG(tab)
     else
     {
         TRACE("PSGride: computing grid for global tons");
+        std::vector<size_t> globals;
         for (size_t ig = 0; ig < _index.size(); ++ig)
         {
             if (_index.isGlobal(ig))
             {
                 TRACE("PSGridx: computing grid row {} ({})", ig, _index.ton(ig));
-                init(tab, ig);
+                globals.push_back(ig);
             }
         }
+        if (not globals.empty())
+            init(tab, globals);
     }
 }
 
@@ -70,314 +109,382 @@ PSGx::~PSGx()
 { }
 
 
+size_t PSGx::paths(size_t i) const
+{
+    assert(i < _paths.size());
+    return _paths[i].size();
+}
+
+
+const std::vector<size_t>& PSGx::path(size_t i, size_t r) const
+{
+    assert(i < _paths.size());
+    assert(r < _paths[i].size());
+    return _paths[i][r];
+}
+
+
+size_t PSGx::pathCost(size_t i, size_t r) const
+{
+    assert(i < _costs.size());
+    assert(r < _costs[i].size());
+    return _costs[i][r];
+}
+
+
 void PSGx::init_singleton(const PST& tab)
 {
-    init(tab, TonIndex::UNDEF);
+    init(tab, std::vector<size_t>(1, TonIndex::UNDEF));
 }
 
 
-void PSGx::init(const PST& tab, size_t ig)
+void PSGx::init(const PST& tab, const std::vector<size_t>& globals)
 {
     assert(tab.size() > 0);
-
-    // tabulation of ranks of tons / measure from the cost of tab
-    std::vector<std::vector<size_t>> ranks;
-    for (size_t j = 0; j < tab.size(); ++j)
+    assert(not globals.empty());
+    const size_t nt = _index.size();          // number of tons
+    const size_t np = util::MinPlus::padded(nt);
+    const size_t nr = globals.size();          // number of rows computed
+    const size_t nb = tab.size();              // number of bars
+    assert(nt < std::numeric_limits<uint16_t>::max());
+    bool modal = (globals.front() == TonIndex::UNDEF);
+    assert(not modal or nr == 1);
+
+    // dense matrices of weights for the distance to previous
+    // and of ranks wrt the global ton of each row
+    std::vector<int32_t> weber;
+    std::vector<int32_t> wglobal;
+    weights(globals, weber, wglobal);
+
+    // first column: first non-empty measure in modal case
+    size_t j0 = 0;
+    if (modal)
     {
-        const PSV& barj = tab.column(j);
-        assert(barj.size() == _index.size());
-        ranks.emplace_back();
-        if (barj.first() == barj.stop()) // empty bars: no rank to compute
+        while (j0 < nb and tab.column(j0).first() == tab.column(j0).stop())
+            ++j0;
+        // should not happen (all bars empty)
+        if (j0 == nb)
         {
-            // leave empty column
-        }
-        else
-        {
-            assert(ranks.back().empty());
-            barj.ranks(ranks.back());
-            assert(ranks.back().size() == _index.size());
+            WARN("Gridx: failure in computation of best path");
+            return;
         }
     }
-    assert(ranks.size() == tab.size());
-    
-    // tonindex * measures-table of best-path costs
-    std::vector<std::vector<size_t>> costs;
 
-    // tonindex * measures-table of predecessors in best path.
-    std::vector<std::vector<size_t>> preds;
-    
-    // initialize with empty columns
-    for (size_t j = 0; j < tab.size(); ++j)
+    // the grid is the best paths of rank 0 of the k-best Viterbi,
+    // computed in the same pass as the k best paths.
+    if (_k > 1)
     {
-        costs.emplace_back();
-        preds.emplace_back();
+        kbest(tab, j0, globals, weber, wglobal);
+        return;
     }
-    
+
+    // rows * tons tables of best-path costs, for the previous
+    // and current columns.
+    std::vector<int32_t> pcosts(nr * np, util::MinPlus::INF);
+    std::vector<int32_t> costs(nr * np, util::MinPlus::INF);
+
+    // bars * rows * tons table of predecessors in best paths.
+    // the columns until j0 have no predecessors.
+    std::vector<uint16_t> preds(nb * nr * nt, 0);
+
     // fill the first column
-    size_t j = 0;
-    if (ig == TonIndex::UNDEF) // modal case
-    {
-        j = first(tab, ranks, costs, preds);
-    }
-    else
-    {
-        assert(ig < _index.size());
-        j = first(tab, ranks,  costs, preds, ig);
-    }
-    
+    first(tab, j0, globals, costs);
+
     // fill the whole table with best-path costs and preds
-    for (; j < tab.size();)
-    {
-        j = column(j, tab, ranks, costs, preds, ig);
-    }
-    
-    // tonal: fill the row ig
-    // modal: fill the first row
-    // @todo other ton ?
-    if (ig == TonIndex::UNDEF)
-        ig = 0;
-
-    // extract the best path
-    assert(costs.size() == tab.size());
-    assert(preds.size() == tab.size());
-    assert(_content.size() == tab.size());
-
-    if (costs.back().empty() or preds.back().empty())
+    for (size_t j = j0+1; j < nb; ++j)
     {
-        WARN("Gridx: failure in computation of best path");
-        return;
+        costs.swap(pcosts);
+        column(tab, j, weber, wglobal, pcosts, costs, &(preds[j*nr*nt]));
     }
-    // index of row (ton) with best (cumulated) cost in last column
-    size_t i = bestCost(costs.back(), ig);
-    
-    for (size_t jm = 1; jm <= tab.size(); ++jm)
+
+    // extract the best paths
+    assert(_content.size() == nb);
+    for (size_t r = 0; r < nr; ++r)
     {
-        j = tab.size() - jm;
-        assert(i < _index.size());
-        assert(i != TonIndex::UNDEF);
-        assert(j < _content.size());
-        assert(ig < _content.at(j).size());
-        _content[j][ig] = i;
-        if (preds.at(j).empty())
+        // tonal: fill the row ig
+        // modal: fill the first row
+        size_t ig = modal?0:globals[r];
+        // index of row (ton) with best (cumulated) cost in last column
+        size_t i = bestCost(&(costs[r*np]), nt, globals[r]);
+        if (i == PRED_UNDEF)
+        {
+            WARN("Gridx: failure in computation of best path");
             continue;
-        else
+        }
+        _costs[ig].assign(1, (size_t) costs[r*np+i]);
+        _paths[ig].assign(1, std::vector<size_t>(nb, TonIndex::UNDEF));
+        std::vector<size_t>& best = _paths[ig].front();
+        for (size_t jm = 1; jm <= nb; ++jm)
         {
-            assert(i < preds.at(j).size());
-            i = preds.at(j).at(i);
+            size_t j = nb - jm;
+            assert(i < nt);
+            assert(j < _content.size());
+            assert(ig < _content.at(j).size());
+            _content[j][ig] = i;
+            best[j] = i;
+            if (j > j0)
+                i = preds[(j*nr + r)*nt + i];
         }
     }
 }
 
 
+void PSGx::weights(const std::vector<size_t>& globals,
+                   std::vector<int32_t>& weber,
+                   std::vector<int32_t>& wglobal) const
+{
+    assert(not globals.empty());
+    const size_t nt = _index.size();
+    const size_t np = util::MinPlus::padded(nt);
+    const size_t nr = globals.size();
+    bool modal = (globals.front() == TonIndex::UNDEF);
+
+    // dense matrix of weights for the distance to previous
+    // weber[i*np+ip] for the transition from ip to i.
+    weber.assign(nt * np, 0);
+    for (size_t i = 0; i < nt; ++i)
+        for (size_t ip = 0; ip < nt; ++ip)
+            weber[i*np+ip] = (int32_t) (COEFF[1] * _index.rankWeber(ip, i));
+
+    // dense matrix of ranks wrt the global ton of each row
+    // wglobal[r*nt+i] is the rank of i wrt to the global of row r.
+    wglobal.assign(nr * nt, 0);
+    for (size_t r = 0; r < nr; ++r)
+        if (not modal)
+            for (size_t i = 0; i < nt; ++i)
+                wglobal[r*nt+i] = (int32_t) _index.rankWeber(globals[r], i);
+}
 
-// modal (singleton) case
-size_t PSGx::first(const PST& tab,
-                   const std::vector<std::vector<size_t>>& ranks,
-                   std::vector<std::vector<size_t>>& costs,
-                   std::vector<std::vector<size_t>>& preds)
 
+bool PSGx::outdated() const
 {
-    assert(tab.size() > 0);
-    assert(ranks.size() == tab.size());
-    assert(costs.size() == tab.size());
-    assert(preds.size() == tab.size());
-    
-    // search for the first non-empty measure (column nb j)
-    for (size_t j = 0; j < tab.size(); ++j)
+    assert(_lag > 0);
+    size_t r = 0; // rows of _globals, in the order of the index
+    for (size_t ig = 0; ig < _index.size(); ++ig)
     {
-        const PSV& bar = tab.column(j);
-        assert(bar.size() == _index.size());
-        
-        // skip empty bars
-        // these columns of the grid will remain TonIndex::UNDEF
-        if (bar.first() == bar.stop())
+        if (not _index.isGlobal(ig))
+            continue;
+        if (r == _globals.size() or _globals[r] != ig)
+            return true;
+        ++r;
+    }
+    return (r != _globals.size());
+}
+
+
+size_t PSGx::extend(const PST& tab, bool last)
+{
+    assert(_lag > 0);
+    assert(tab.rowNb() == _index.size());
+    assert(not outdated());
+    if (_globals.empty())
+        return 0;
+    const size_t nt = _index.size();
+    const size_t np = util::MinPlus::padded(nt);
+    const size_t nr = _globals.size();
+    assert(nt < std::numeric_limits<uint16_t>::max());
+    const size_t n = _content.size();
+
+    // the last column of tab can still change, unless last
+    size_t stop = tab.size();
+    if (not last and stop > 0)
+        --stop;
+    std::vector<int32_t> costs(nr * np, util::MinPlus::INF);
+    while (_next < stop)
+    {
+        if (_next == 0)
         {
-            // columns in costs and preds remain empty
-            assert(costs.at(j).empty());
-            assert(preds.at(j).empty());
+            first(tab, 0, _globals, costs);
         }
         else
         {
-            // rank of each bag in the column j (one for each ton)
-            const std::vector<size_t>& rankj(ranks.at(j));
-            assert(rankj.size() == _index.size());
-            std::vector<size_t>& costj(costs.at(j));
-            assert(costj.empty());
-            for (size_t i = 0; i < rankj.size(); ++i)
-            {
-                // initial cost = rank
-                costj.push_back(rankj.at(i));
-            }
-            // column in preds remains empty
-            assert(preds.at(j).empty());
-            return j+1;
+            _window.emplace_back(nr * nt, 0);
+            column(tab, _next, _weber, _wglobal, _pcosts, costs,
+                   _window.back().data());
         }
+        _pcosts.swap(costs);
+        ++_next;
+        // the local tons of the bars lag columns before are fixed
+        while (_window.size() >= _lag)
+            fix();
     }
-    // should not happen (all bars empty)
-    return tab.size();
+
+    // no lookahead after the last column: fix all the remaining bars
+    if (last)
+    {
+        while (_content.size() < _next)
+            fix();
+    }
+    return _content.size() - n;
 }
 
 
-// tonal case: start from global ton gton
-size_t PSGx::first(const PST& tab,
-                   const std::vector<std::vector<size_t>>& ranks,
-                   std::vector<std::vector<size_t>>& costs,
-                   std::vector<std::vector<size_t>>& preds, size_t ig)
+void PSGx::fix()
 {
-    assert(tab.size() > 0);
-    assert(ranks.size() == tab.size());
-    assert(costs.size() == tab.size());
-    assert(preds.size() == tab.size());
+    const size_t nt = _index.size();
+    const size_t np = util::MinPlus::padded(nt);
+    assert(_content.size() + _window.size() + 1 == _next);
+    assert(_pcosts.size() == _globals.size() * np);
+    _content.emplace_back(nt, TonIndex::UNDEF);
+    std::vector<size_t>& col = _content.back();
+    for (size_t r = 0; r < _globals.size(); ++r)
+    {
+        size_t ig = _globals[r];
+        // end of best path in the last column processed
+        size_t i = bestCost(&(_pcosts[r*np]), nt, ig);
+        if (i == PRED_UNDEF)
+        {
+            WARN("Gridx: failure in computation of best path");
+            continue;
+        }
+        // back to the first column not fixed
+        for (auto it = _window.crbegin(); it != _window.crend(); ++it)
+            i = (*it)[r*nt + i];
+        assert(i < nt);
+        col[ig] = i;
+    }
+    if (not _window.empty())
+        _window.pop_front();
+}
+
+
+void PSGx::first(const PST& tab, size_t j,
+                 const std::vector<size_t>& globals,
+                 std::vector<int32_t>& costs) const
+{
+    assert(j < tab.size());
+    const size_t nt = _index.size();
+    const size_t np = util::MinPlus::padded(nt);
+    assert(costs.size() == globals.size() * np);
 
     // first measure
-    const PSV& bar = tab.column(0);
-    assert(bar.size() == _index.size());
-    std::vector<size_t>& costj(costs.at(0));
+    const PSV& bar = tab.column(j);
+    assert(bar.size() == nt);
     
-    // empty bar (no spelling cost values)
-    if (bar.first() == bar.stop())
+    // rank of each bag in the column j (one for each ton)
+    // empty if the bar is empty (no spelling cost values)
+    std::vector<size_t> rankj;
+    bar.ranks(rankj);
+    assert(rankj.empty() or rankj.size() == nt);
+
+    for (size_t r = 0; r < globals.size(); ++r)
     {
-        for (size_t i = 0; i < _index.size(); ++i)
+        int32_t* costr = &(costs[r*np]);
+        size_t ig = globals[r];
+        // modal (singleton) case: initial cost = rank
+        if (ig == TonIndex::UNDEF)
         {
-            costj.push_back(COST_INFINITE);
+            assert(rankj.size() == nt);
+            for (size_t i = 0; i < nt; ++i)
+                costr[i] = (int32_t) rankj[i];
         }
-        assert(ig < costj.size());
-        costj.at(ig) = 0;
-        // column in preds remains empty
-        assert(preds.at(0).empty());
-    }
-    else
-    {
-        // rank of each bag in the column 0 (one for each ton)
-        const std::vector<size_t>& rankj(ranks.at(0));
-        assert(rankj.size() == _index.size());
-        for (size_t i = 0; i < _index.size(); ++i)
+        // tonal case, empty bar: start from global ton ig
+        else if (rankj.empty())
+        {
+            assert(ig < nt);
+            for (size_t i = 0; i < nt; ++i)
+                costr[i] = util::MinPlus::INF;
+            costr[ig] = 0;
+        }
+        // tonal case: initial cost = rank + dist to ig
+        else
         {
-            // initial cost = rank + dist to ig
-            costj.push_back((COEFF[1]+COEFF[2]) * _index.rankWeber(ig, i) +
-                             COEFF[0] * rankj.at(i));
+            assert(ig < nt);
+            for (size_t i = 0; i < nt; ++i)
+                costr[i] = (int32_t) ((COEFF[1]+COEFF[2]) *
+                                      _index.rankWeber(ig, i) +
+                                      COEFF[0] * rankj[i]);
         }
-        // column in preds remains empty
-        assert(preds.at(0).empty());
     }
-    return 1;
 }
 
 
-size_t PSGx::column(size_t j, const PST& tab,
-                    const std::vector<std::vector<size_t>>& ranks,
-                    std::vector<std::vector<size_t>>& costs,
-                    std::vector<std::vector<size_t>>& preds,
-                    size_t ig)
+void PSGx::column(const PST& tab, size_t j,
+                  const std::vector<int32_t>& weber,
+                  const std::vector<int32_t>& wglobal,
+                  const std::vector<int32_t>& pcosts,
+                  std::vector<int32_t>& costs,
+                  uint16_t* preds) const
 {
-    assert(tab.size() > 0);
-    assert(ranks.size() == tab.size());
-    assert(costs.size() == tab.size());
-    assert(preds.size() == tab.size());
     assert(0 < j and j < tab.size());
-    assert(j-1 < costs.size());
-    assert(j-1 < preds.size());
-    assert(ig == TonIndex::UNDEF or ig < _index.size());
-
-    // best path costs so far (until the measure preceeding j)
-    const std::vector<size_t>& pcosts = costs.at(j-1);
-    assert(pcosts.size() == _index.size());
-    assert(costs.at(j).empty());
-    assert(preds.at(j).empty());
-
-    // rank of each bag in the column j (one for each ton)
-    const std::vector<size_t>& rankj(ranks.at(j));
+    const size_t nt = _index.size();
+    const size_t np = util::MinPlus::padded(nt);
+    const size_t nr = wglobal.size() / nt;
+    assert(weber.size() == nt * np);
+    assert(pcosts.size() == nr * np);
+    assert(costs.size() == nr * np);
+    assert(preds);
 
     // measure j
     const PSV& barj = tab.column(j);
-    assert(barj.size() == _index.size());
-    bool empty_bar = (barj.first() == barj.stop());
-    assert(empty_bar or rankj.size() == _index.size());
-    assert(!empty_bar or rankj.empty());
+    assert(barj.size() == nt);
 
-    // process column j
-    for (size_t i = 0; i < _index.size(); ++i)
-    {
-        // continue in the same local tonality
-        if (empty_bar)
-        {
-            size_t predcost = pcosts.at(i);
-            if (ig != TonIndex::UNDEF) predcost += _index.rankWeber(ig, i);
-            assert(_index.rankWeber(i, i) == 0);
-            costs.at(j).push_back(predcost);
-            preds.at(j).push_back(i);
-            continue;
-        }
+    // rank of each bag in the column j (one for each ton)
+    std::vector<size_t> rankj;
+    barj.ranks(rankj);
+    bool empty_bar = rankj.empty();
+    assert(empty_bar == (barj.first() == barj.stop()));
+    assert(empty_bar or rankj.size() == nt);
 
-        // search best predecessor
-        size_t best_cost = COST_INFINITE;
-        size_t best_pred = PRED_UNDEF;
-        size_t best_predcost = COST_INFINITE;
-        // rank of spelling cost for ton i at bar j
-        /// @todo rank or cost value?
-        size_t ri = empty_bar?0:(COEFF[0] * rankj.at(i));
-        // rank of i for distance to global
-        if (ig != TonIndex::UNDEF) ri += COEFF[2] * _index.rankWeber(ig, i);
-        // select a best predecessor for i
-        for (size_t ip = 0; ip < _index.size(); ++ip)
+    for (size_t r = 0; r < nr; ++r)
+    {
+        // best path costs so far (until the measure preceeding j)
+        const int32_t* pcostr = &(pcosts[r*np]);
+        const int32_t* wglobr = &(wglobal[r*nt]);
+        int32_t* costr = &(costs[r*np]);
+        uint16_t* predr = preds + r*nt;
+        for (size_t i = 0; i < nt; ++i)
         {
-            if (pcosts.at(ip) == COST_INFINITE)
-                continue;
-            size_t predcost = pcosts.at(ip);
-            /// @todo distWeber or rankWeber
-            size_t cost = predcost + COEFF[1] * _index.rankWeber(ip, i) + ri;
-            
-            // in case of tie, we keep the smaller best_pred
-            // hence we need a wise ordering of tons in the ton index.
-            if (best_cost == COST_INFINITE or cost < best_cost)
-            {
-                best_cost = cost;
-                best_pred = ip;
-                best_predcost = predcost;
-            }
-            // tie break
-            else if (cost == best_cost and
-            (best_predcost == COST_INFINITE or predcost < best_predcost))
+            // continue in the same local tonality
+            if (empty_bar)
             {
-                best_pred = ip;
-                best_predcost = predcost;
+                assert(_index.rankWeber(i, i) == 0);
+                costr[i] = (pcostr[i] == util::MinPlus::INF)?
+                           util::MinPlus::INF:(pcostr[i] + wglobr[i]);
+                predr[i] = (uint16_t) i;
+                continue;
             }
-            // otherwise ignore
+            // select a best predecessor for i.
+            // in case of tie, we keep the best predecessor of smaller cost
+            // and then of smaller index,
+            // hence we need a wise ordering of tons in the ton index.
+            int32_t best;
+            size_t ip = util::MinPlus::argmin(pcostr, &(weber[i*np]), nt, best);
+            assert(ip < nt);
+            assert(best != util::MinPlus::INF);
+            // rank of spelling cost for ton i at bar j
+            /// @todo rank or cost value?
+            // and rank of i for distance to global
+            costr[i] = best + (int32_t) (COEFF[0] * rankj[i]) +
+                              (int32_t) COEFF[2] * wglobr[i];
+            predr[i] = (uint16_t) ip;
         }
-        assert(best_cost != COST_INFINITE);
-        assert(best_pred != PRED_UNDEF);
-        costs.at(j).push_back(best_cost);
-        preds.at(j).push_back(best_pred);
+        // padding
+        for (size_t i = nt; i < np; ++i)
+            costr[i] = util::MinPlus::INF;
     }
-    assert(costs.at(j).size() == _index.size());
-    assert(preds.at(j).size() == _index.size());
-
-    return j+1;
 }
 
 
-size_t PSGx::bestCost(const std::vector<size_t>& col, size_t ig)
+size_t PSGx::bestCost(const int32_t* col, size_t n, size_t ig) const
 {
-    size_t best_cost = COST_INFINITE;
+    int32_t best_cost = util::MinPlus::INF;
     size_t ibest = PRED_UNDEF;
     
     size_t ties = 0;
-    for (size_t i = 0; i < col.size(); ++i)
+    for (size_t i = 0; i < n; ++i)
     {
-        if (best_cost == COST_INFINITE or col.at(i) < best_cost)
+        if (col[i] < best_cost)
         {
-            best_cost = col.at(i);
+            best_cost = col[i];
             ibest = i;
             ties = 1;
         }
-        else if (best_cost != COST_INFINITE and col.at(i) == best_cost)
+        else if (best_cost != util::MinPlus::INF and col[i] == best_cost)
         {
             ties++;
         }
     }
-    assert(best_cost != COST_INFINITE);
-    assert(ibest != PRED_UNDEF);
-    assert(ties > 0);
     if (ties > 1)
     {
         if (ig == TonIndex::UNDEF)
@@ -396,4 +503,159 @@ size_t PSGx::bestCost(const std::vector<size_t>& col, size_t ig)
 }
 
 
+void PSGx::kbest(const PST& tab, size_t j0,
+                 const std::vector<size_t>& globals,
+                 const std::vector<int32_t>& weber,
+                 const std::vector<int32_t>& wglobal)
+{
+    const size_t nt = _index.size();
+    const size_t np = util::MinPlus::padded(nt);
+    const size_t nr = globals.size();
+    const size_t nb = tab.size();
+    const size_t k = _k;
+    assert(1 < k and k < std::numeric_limits<uint16_t>::max());
+    assert(j0 < nb);
+    bool modal = (globals.front() == TonIndex::UNDEF);
+    const int32_t INF = util::MinPlus::INF;
+
+    // rows * tons * k tables of the costs of the candidates, sorted for
+    // each ton, for the previous and current columns.
+    std::vector<int32_t> pcosts(nr * nt * k, INF);
+    std::vector<int32_t> costs(nr * nt * k, INF);
+
+    // rows * tons * k tables of predecessors of candidates, one per bar,
+    // allocated when the bar is processed. it is left empty for the bars
+    // until j0 and for the empty bars, where the predecessor of a
+    // candidate is the candidate of same ton and rank.
+    std::vector<std::vector<KPred>> preds(nb);
+
+    // first column: one candidate per ton, with the costs of init
+    std::vector<int32_t> first_costs(nr * np, INF);
+    first(tab, j0, globals, first_costs);
+    for (size_t r = 0; r < nr; ++r)
+        for (size_t i = 0; i < nt; ++i)
+            costs[(r*nt + i)*k] = first_costs[r*np + i];
+
+    // candidate for a ton: cost, cost of predecessor, predecessor.
+    // they are ordered like in MinPlus::argmin: by cost, then
+    // cost of predecessor, then index of predecessor (and rank).
+    using Cand = std::tuple<int32_t, int32_t, uint16_t, uint16_t>;
+    std::vector<Cand> cands;
+    cands.reserve(nt * k);
+
+    for (size_t j = j0+1; j < nb; ++j)
+    {
+        costs.swap(pcosts);
+        const PSV& barj = tab.column(j);
+        std::vector<size_t> rankj;
+        barj.ranks(rankj);
+        bool empty_bar = rankj.empty();
+        assert(empty_bar or rankj.size() == nt);
+        if (not empty_bar)
+            preds[j].assign(nr * nt * k, KPred{0, 0});
+        for (size_t r = 0; r < nr; ++r)
+        {
+            const int32_t* wglobr = &(wglobal[r*nt]);
+            for (size_t i = 0; i < nt; ++i)
+            {
+                const size_t ri = (r*nt + i)*k;
+                int32_t* costi = &(costs[ri]);
+                // continue in the same local tonality
+                if (empty_bar)
+                {
+                    for (size_t q = 0; q < k; ++q)
+                        costi[q] = (pcosts[ri+q] == INF)?INF:
+                                   (pcosts[ri+q] + wglobr[i]);
+                    continue;
+                }
+                KPred* predi = &(preds[j][ri]);
+                cands.clear();
+                for (size_t ip = 0; ip < nt; ++ip)
+                {
+                    const int32_t w = weber[i*np+ip];
+                    for (size_t q = 0; q < k; ++q)
+                    {
+                        int32_t pc = pcosts[(r*nt + ip)*k + q];
+                        if (pc == INF)
+                            break; // candidates of ip are sorted
+                        cands.emplace_back(pc + w, pc,
+                                           (uint16_t) ip, (uint16_t) q);
+                    }
+                }
+                size_t nc = std::min(k, cands.size());
+                std::partial_sort(cands.begin(), cands.begin() + nc,
+                                  cands.end());
+                const int32_t plus = (int32_t) (COEFF[0] * rankj[i]) +
+                                     (int32_t) COEFF[2] * wglobr[i];
+                for (size_t q = 0; q < k; ++q)
+                {
+                    if (q < nc)
+                    {
+                        costi[q] = std::get<0>(cands[q]) + plus;
+                        predi[q] = KPred{std::get<2>(cands[q]),
+                                         std::get<3>(cands[q])};
+                    }
+                    else
+                        costi[q] = INF;
+                }
+            }
+        }
+    }
+
+    // extract the k best paths of every row
+    for (size_t r = 0; r < nr; ++r)
+    {
+        size_t ig = modal?0:globals[r];
+        // best final candidates, by cost, then index of ton and rank,
+        // like in bestCost.
+        cands.clear();
+        for (size_t i = 0; i < nt; ++i)
+            for (size_t q = 0; q < k; ++q)
+            {
+                int32_t c = costs[(r*nt + i)*k + q];
+                if (c == INF)
+                    break;
+                cands.emplace_back(c, 0, (uint16_t) i, (uint16_t) q);
+            }
+        size_t nc = std::min(k, cands.size());
+        if (nc == 0)
+        {
+            WARN("Gridx: failure in computation of best path");
+            continue;
+        }
+        std::partial_sort(cands.begin(), cands.begin() + nc, cands.end());
+        _paths[ig].assign(nc, std::vector<size_t>(nb, TonIndex::UNDEF));
+        _costs[ig].resize(nc);
+        for (size_t n = 0; n < nc; ++n)
+        {
+            _costs[ig][n] = (size_t) std::get<0>(cands[n]);
+            size_t i = std::get<2>(cands[n]);
+            size_t q = std::get<3>(cands[n]);
+            std::vector<size_t>& path = _paths[ig][n];
+            for (size_t jm = 1; jm <= nb; ++jm)
+            {
+                size_t j = nb - jm;
+                assert(i < nt);
+                assert(q < k);
+                path[j] = i;
+                // same ton and rank in empty bars
+                if (j > j0 and not preds[j].empty())
+                {
+                    const KPred& p = preds[j][(r*nt + i)*k + q];
+                    i = p.ton;
+                    q = p.rank;
+                }
+            }
+        }
+        // the best path is the row of the grid
+        assert(_content.size() == nb);
+        for (size_t j = 0; j < nb; ++j)
+        {
+            assert(ig < _content.at(j).size());
+            _content[j][ig] = _paths[ig].front()[j];
+        }
+    }
+}
+
+
 } // end namespace pse
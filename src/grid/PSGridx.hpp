@@ -14,17 +14,27 @@
 #include <assert.h>
 #include <memory>
 #include <vector>
+#include <deque>
 #include <stack>
 #include <queue>   // std::priority_queue
 
 #include "pstrace.hpp"
 #include "utils.hpp"
 #include "PSGrid.hpp"
+#include "MinPlus.hpp"
 
 
 namespace pse {
 
 /// Construction of a grid from a table with an exhaustive Viterbi algorithm.
+/// The tons of every bar form a layered DAG, and the best paths for all the
+/// rows (global tons) are computed together by forward dynamic programming,
+/// one column at a time.
+/// Optionally, the k best paths of every row are also computed
+/// (k-best Viterbi), the first one being the path in the grid.
+/// In online mode, the grid is extended with the columns appended to the
+/// table, and the local tons of a bar are fixed after a given number of
+/// columns of lookahead (fixed-lag Viterbi).
 class PSGx : public PSG
 {
     
@@ -35,7 +45,15 @@ public: // construction
     /// @param singleton compute only one row of the grid, of index 0,
     /// without assumed global topnality. Otherwise, compute all rows
     /// associated to global tonalities in the tone index.
-    PSGx(const PST& tab, bool singleton=false);
+    /// @param k number of best paths computed for every row.
+    /// must be strictly positive. The best path is the one in the grid.
+    /// @param lag 0 for the computation of the grid on all the columns of
+    /// tab. Otherwise, online mode, for the rows of the global tons only
+    /// (k must be 1): the grid is computed on the columns of tab, except
+    /// the last one, and extended with extend(). The local tons of a bar
+    /// are fixed, i.e. a column is added to the grid, when the best paths
+    /// have been computed for the lag next bars.
+    PSGx(const PST& tab, bool singleton=false, size_t k=1, size_t lag=0);
 
     /// a grid cannot be copied
     PSGx(const PSGx& rhs) = delete;
@@ -46,6 +64,54 @@ public: // construction
     /// a grid cannot be copied
     PSGx& operator=(const PSGx& rhs) = delete;
 
+public: // online mode
+
+    /// online mode: extend this grid with the columns of the given table
+    /// not processed yet. The time of an extension does not depend on
+    /// the number of columns already processed.
+    /// @param tab the table used to construct this grid, extended since.
+    /// @param last whether no more notes will be added to the table.
+    /// If false, the last column of tab is not processed, since it can
+    /// still change. If true, all the columns are processed, and the local
+    /// tons of all bars are fixed, without lookahead for the last bars.
+    /// @return the number of columns added to this grid.
+    /// @warning this grid must have been constructed in online mode.
+    size_t extend(const PST& tab, bool last=false);
+
+    /// online mode: number of bars of lookahead for fixing the local tons
+    /// of a bar, 0 if this grid was computed in one pass.
+    inline size_t lag() const { return _lag; }
+
+    /// online mode: whether the global flags of the index have changed
+    /// since the construction of this grid. In this case, the rows of this
+    /// grid are not the global tons anymore and it must be rebuilt.
+    bool outdated() const;
+
+public: // k-best paths
+
+    /// number of best paths computed for a row of this grid.
+    /// @param i index in the TonIndex of an assumed global tonality,
+    /// or 0 for a singleton grid.
+    /// @return at most the k given to the constructor,
+    /// 0 if the computation failed for row i or i is not a global ton.
+    size_t paths(size_t i) const;
+
+    /// one of the best paths computed for a row of this grid.
+    /// @param i index in the TonIndex of an assumed global tonality,
+    /// or 0 for a singleton grid.
+    /// @param r rank of the path, must be smaller than paths(i).
+    /// @return the index of local ton for every measure. The path of rank 0
+    /// is the row i of this grid.
+    const std::vector<size_t>& path(size_t i, size_t r) const;
+
+    /// cost of one of the best paths computed for a row of this grid.
+    /// @param i index in the TonIndex of an assumed global tonality,
+    /// or 0 for a singleton grid.
+    /// @param r rank of the path, must be smaller than paths(i).
+    /// @return the cost of the path of rank r. The costs are increasing
+    /// with the rank (not strictly in case of ties).
+    size_t pathCost(size_t i, size_t r) const;
+
 private: // construction
     
     /// coefficients for the compution of best baths.
@@ -54,81 +120,143 @@ private: // construction
     /// 2. rank for distance to global in row.
     static const std::array<size_t, 3> COEFF;
     
-    /// compute one row of this grid of local tons, corresponding to
-    /// the given global ton, using the given spelling table.
+    /// compute the rows of this grid of local tons corresponding to
+    /// the given global tons, in one pass over the given spelling table.
     /// @param tab spelling table filled with spelling costs.
-    /// @param ig global ton of the index of tab, or TonIndex::UNDEF.
-    /// in the latter case, compute one unique row of index 0 of this grid
-    /// of local tons, for modal case (no global tonality).
-    void init(const PST& tab, size_t ig);
+    /// @param globals global tons of the index of tab, or the singleton
+    /// { TonIndex::UNDEF }. In the latter case, compute one unique row
+    /// of index 0 of this grid of local tons, for modal case
+    /// (no global tonality).
+    void init(const PST& tab, const std::vector<size_t>& globals);
 
     /// compute one unique row of index 0 of this grid of local tons,
     /// for modal case (no global tonality).
     void init_singleton(const PST& tab);
 
-    // use the default ordering > (and ==) on Grid States
-    // PSGQueue q = PSGQueue(PSGlex());
-    
-    /// compute the first column of nodes of best paths (cells),
-    /// according to the spelling costs in the first column of the given table,
-    /// for a modal construction of the grid (no global tonality).
-    /// @param tab spelling table filled with spelling costs.
-    /// must be non empty (nb bars > 0).
-    /// @param ranks precomputed rankings of each column of tab.
-    /// @param costs table of best-path costs.
-    /// @param preds table of of predecessors in best paths.
-    /// @return the number of the next column to proceed.
-    size_t first(const PST& tab,
-               const std::vector<std::vector<size_t>>& ranks,
-               std::vector<std::vector<size_t>>& costs,
-               std::vector<std::vector<size_t>>& preds);
-
-    /// compute the first column of nodes of best paths (cells),
-    /// according to the spelling costs in the first column of the given table
-    /// and the given assumed global ton.
+    /// dense matrices of weights for the computation of best paths.
+    /// @param globals global tons for the rows, or { TonIndex::UNDEF }.
+    /// @param weber receive the weights of the distance to previous,
+    /// weber[i*np+ip] for the transition from ip to i, where np is the
+    /// padded number of tons.
+    /// @param wglobal receive the ranks of each ton wrt the global ton
+    /// of each row, wglobal[r*nt+i] for the ton i and row r.
+    void weights(const std::vector<size_t>& globals,
+                 std::vector<int32_t>& weber,
+                 std::vector<int32_t>& wglobal) const;
+
+    /// online mode: fix the local tons of the first bar not fixed,
+    /// by backtracking from the best path costs of the last column
+    /// processed, and add one column to this grid.
+    void fix();
+
+    /// compute the first column of best path costs, for every row.
     /// @param tab spelling table filled with spelling costs.
     /// must be non empty (nb bars > 0).
-    /// @param ranks precomputed rankings of each column of tab.
-    /// @param costs table of best-path costs.
-    /// @param preds table of of predecessors in best paths.
-    /// @return the number of the next column to proceed.
-    size_t first(const PST& tab,
-                 const std::vector<std::vector<size_t>>& ranks,
-                 std::vector<std::vector<size_t>>& costs,
-                 std::vector<std::vector<size_t>>& preds,
-                 size_t ig);
-
-    /// compute one columb of best path nodes.
-    /// @param j column number.
-    /// must be larger or equal to 1.
-    /// must be smaller than the siae of tab (number of measures)
+    /// @param j number of the first column. In the modal case, it is the
+    /// first non-empty measure. In the tonal case, it is 0.
+    /// @param globals global tons for the rows, or { TonIndex::UNDEF }.
+    /// @param costs best path costs for every row,
+    /// dense matrix with one line of padded length for each row.
+    void first(const PST& tab, size_t j,
+               const std::vector<size_t>& globals,
+               std::vector<int32_t>& costs) const;
+
+    /// compute one column of best path costs and predecessors,
+    /// for every row, with a min-plus product.
     /// @param tab spelling table filled with spelling costs.
-    /// must be non empty (nb bars > 0).
-    /// @param ranks precomputed rankings of each column of tab.
-    /// @param costs table of best-path costs.
-    /// must have a column j-1.
-    /// @param preds table of of predecessors in best paths.
-    /// must have a column j-1.
-    /// @param ig global ton of current index of tab, or TonIndex::UNDEF.
-    /// @return the number of the next column to proceed.
-    size_t column(size_t j, const PST& tab,
-                  const std::vector<std::vector<size_t>>& ranks,
-                  std::vector<std::vector<size_t>>& costs,
-                  std::vector<std::vector<size_t>>& preds,
-                  size_t ig);
+    /// @param j column number. must be smaller than the size of tab.
+    /// @param weber dense matrix of the distance weights,
+    /// weber[i*TP+ip] for the transition from ip to i.
+    /// @param wglobal dense matrix of the ranks of each ton wrt
+    /// the global ton of each row.
+    /// @param pcosts best path costs until the column j-1, for every row.
+    /// @param costs receive the best path costs until the column j,
+    /// for every row.
+    /// @param preds receive the predecessors of the column j, for every row.
+    void column(const PST& tab, size_t j,
+                const std::vector<int32_t>& weber,
+                const std::vector<int32_t>& wglobal,
+                const std::vector<int32_t>& pcosts,
+                std::vector<int32_t>& costs,
+                uint16_t* preds) const;
 
     /// index of best cost in a column.
     /// @param col on column in the table of best-path costs.
-    /// @para ig current assumed global ton, for feedback.
+    /// @param n number of costs in col.
+    /// @param ig current assumed global ton, for feedback.
     /// @return the index of the best cost in col,
-    /// with priority to smaller index in case of tie.
-    size_t bestCost(const std::vector<size_t>& col, size_t ig);
+    /// with priority to smaller index in case of tie,
+    /// or PRED_UNDEF if all the costs are infinite.
+    size_t bestCost(const int32_t* col, size_t n, size_t ig) const;
+
+    /// compute the k best paths of the rows of this grid
+    /// corresponding to the given global tons, by a k-best Viterbi
+    /// in one pass over the given spelling table, and fill these rows
+    /// with the best paths.
+    /// The tie semantics is the one of the 1-best Viterbi of init:
+    /// the best path of each row is the same as with k = 1.
+    /// Used only for k > 1. The predecessors of the candidates are stored
+    /// per bar, and not for the empty bars.
+    /// @param tab spelling table filled with spelling costs.
+    /// @param j0 number of the first column, as in init.
+    /// @param globals global tons of the index of tab, or the singleton
+    /// { TonIndex::UNDEF }.
+    /// @param weber dense matrix of the distance weights, as in init.
+    /// @param wglobal dense matrix of the ranks wrt the globals, as in init.
+    void kbest(const PST& tab, size_t j0,
+               const std::vector<size_t>& globals,
+               const std::vector<int32_t>& weber,
+               const std::vector<int32_t>& wglobal);
+
+private: // data
+
+    /// number of best paths computed for every row.
+    size_t _k;
+
+    /// best paths of every row, by increasing cost.
+    /// one vector of paths per ton of the index (empty if not a global).
+    std::vector<std::vector<std::vector<size_t>>> _paths;
+
+    /// costs of the best paths of every row.
+    std::vector<std::vector<size_t>> _costs;
+
+    /// online mode: number of bars of lookahead, 0 for one pass mode.
+    size_t _lag;
+
+    /// online mode: global tons of the rows computed.
+    std::vector<size_t> _globals;
+
+    /// online mode: weights of the distance to previous.
+    /// @see weights
+    std::vector<int32_t> _weber;
+
+    /// online mode: ranks wrt the global ton of each row.
+    /// @see weights
+    std::vector<int32_t> _wglobal;
+
+    /// online mode: best path costs until the last column processed,
+    /// for every row.
+    std::vector<int32_t> _pcosts;
+
+    /// online mode: predecessors of the columns processed after the
+    /// first bar not fixed, from the oldest to the last column processed.
+    /// there are at most lag of them.
+    std::deque<std::vector<uint16_t>> _window;
+
+    /// online mode: number of columns of the table processed.
+    size_t _next;
+
+    /// predecessor of a candidate in the k-best Viterbi:
+    /// ton in previous column and rank of candidate of that ton.
+    struct KPred
+    {
+        uint16_t ton;
+        uint16_t rank;
+    };
     
     
 private: // static constants
     
-    static size_t COST_INFINITE;
-
     static size_t PRED_UNDEF;
     
     // content of a cell at ton i and measure j (pimpl)
@@ -0,0 +1,110 @@
+//
+//  PSBarView.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include "PSBarView.hpp"
+
+
+namespace pse {
+
+
+PSBarView::PSBarView(PSEnum& e, size_t i0, size_t i1):
+PSEnum(i0, i1),
+_container(e),
+_pcs(0),
+_chords()
+{
+    assert(i0 != ID_INF);
+    assert(i1 != ID_INF);
+    assert(i0 <= i1);
+    size_t n = i1 - i0;
+    _midi.reserve(n);
+    _bars.reserve(n);
+    _simult.reserve(n);
+    _names.reserve(n);
+    _accids.reserve(n);
+    _octs.reserve(n);
+    _durn.reserve(n);
+    _durd.reserve(n);
+    _prints.reserve(n);
+    for (size_t i = i0; i < i1; ++i)
+    {
+        _midi.push_back(e.midipitch(i));
+        _bars.push_back(e.measure(i));
+        _simult.push_back(e.simultaneous(i));
+        _names.push_back(e.name(i));
+        _accids.push_back(e.accidental(i));
+        _octs.push_back(e.octave(i));
+        _durn.push_back(e.duration_num(i));
+        _durd.push_back(e.duration_den(i));
+        _prints.push_back(e.printed(i));
+        _pcs |= (1 << (_midi.back() % 12));
+    }
+    _chords = PSChords(*this);
+}
+
+
+PSBarView::PSBarView(const PSBarView& rhs):
+PSEnum(rhs),
+_container(rhs._container),
+_midi(rhs._midi),
+_bars(rhs._bars),
+_simult(rhs._simult),
+_names(rhs._names),
+_accids(rhs._accids),
+_octs(rhs._octs),
+_durn(rhs._durn),
+_durd(rhs._durd),
+_prints(rhs._prints),
+_pcs(rhs._pcs),
+_chords(rhs._chords)
+{ }
+
+
+PSBarView::~PSBarView()
+{ }
+
+
+std::unique_ptr<PSEnum> PSBarView::clone() const
+{
+    return std::unique_ptr<PSBarView>(new PSBarView(*this));
+}
+
+
+std::unique_ptr<PSEnum> PSBarView::clone(size_t i0, size_t i1) const
+{
+    assert(first() <= i0);
+    assert(i0 <= i1);
+    assert(i1 <= stop());
+    return std::unique_ptr<PSBarView>(new PSBarView(_container, i0, i1));
+}
+
+
+std::unique_ptr<PSEnum> PSBarView::clone(size_t i0) const
+{
+    return clone(i0, stop());
+}
+
+
+void PSBarView::reset(size_t i0, size_t i1)
+{
+    ERROR("PSBarView: cannot reset bounds to {}-{}", i0, i1);
+}
+
+
+void PSBarView::rename(size_t i, const enum NoteName& name,
+                       const enum Accid& accid, int oct, bool printed)
+{
+    assert(inside(i));
+    _container.rename(i, name, accid, oct, printed);
+}
+
+
+} // end namespace pse
+
+/// @}
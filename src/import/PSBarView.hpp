@@ -0,0 +1,181 @@
+//
+//  PSBarView.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef PSBarView_hpp
+#define PSBarView_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <memory>
+#include <vector>
+
+#include "pstrace.hpp"
+#include "NoteName.hpp"
+#include "Accid.hpp"
+#include "PSEnum.hpp"
+#include "PSChords.hpp"
+
+
+namespace pse {
+
+
+/// contiguous copy of the input notes of an interval in a given enumerator,
+/// typically one bar, for the best path search in this bar.
+/// The accessors are not virtual in this final class, they read directly
+/// the copied arrays, when called on an object of static type PSBarView.
+/// Passed as a PSEnum, the accesses cost one virtual call,
+/// instead of two for a PSWindow (window and embedding enumerator).
+/// @warning the names, accidentals, octaves and print flags are those of
+/// the notes at construction of the view (constraints on input notes).
+/// They are not updated when the notes are renamed.
+class PSBarView final : public PSEnum
+{
+public: // construction
+
+    /// contiguous copy of the given interval of notes in an enumerator.
+    /// @param e embedding enumerator. it is only referenced for the renaming
+    /// of notes.
+    /// @param i0 index of the first note of the view. must be inside e.
+    /// @param i1 index of the note after the last note of the view.
+    /// must be larger than or equal to i0 and inside e or e.stop().
+    PSBarView(PSEnum& e, size_t i0, size_t i1);
+
+    /// copy constructor.
+    PSBarView(const PSBarView& rhs);
+
+    /// destructor.
+    ~PSBarView();
+
+    /// clone this view.
+    std::unique_ptr<PSEnum> clone() const override;
+
+    /// clone this view and update the bounds with new values.
+    /// @param i0 new index of the first note. must be inside this view.
+    /// @param i1 new index of the note after the last note.
+    /// must be larger than or equal to i0 and inside this view or stop().
+    std::unique_ptr<PSEnum> clone(size_t i0, size_t i1) const override;
+
+    /// clone this view and update the left bound with a new value.
+    /// @param i0 new index of the first note. must be inside this view.
+    std::unique_ptr<PSEnum> clone(size_t i0) const override;
+
+public: // access
+
+    /// midi key number in 0..128 of the note at the given index.
+    /// @param i index of a note. must be inside this view.
+    inline unsigned int midipitch(size_t i) const override
+    { assert(i - _first < _midi.size()); return _midi[i - _first]; }
+
+    /// number of the measure containing the note at the given index.
+    /// @param i index of a note. must be inside this view.
+    inline long measure(size_t i) const override
+    { assert(i - _first < _bars.size()); return _bars[i - _first]; }
+
+    /// whether the note at the given index is simultaneous with the next note.
+    /// @param i index of a note. must be inside this view.
+    inline bool simultaneous(size_t i) const override
+    { assert(i - _first < _simult.size()); return _simult[i - _first]; }
+
+    /// name of the note at the given index, at construction of this view.
+    /// @param i index of a note. must be inside this view.
+    inline enum NoteName name(size_t i) const override
+    { assert(i - _first < _names.size()); return _names[i - _first]; }
+
+    /// accidental of the note at the given index, at construction of this view.
+    /// @param i index of a note. must be inside this view.
+    inline enum Accid accidental(size_t i) const override
+    { assert(i - _first < _accids.size()); return _accids[i - _first]; }
+
+    /// octave of the note at the given index, at construction of this view.
+    /// @param i index of a note. must be inside this view.
+    inline int octave(size_t i) const override
+    { assert(i - _first < _octs.size()); return _octs[i - _first]; }
+
+    /// duration of the note at the given index, in number of bars.
+    /// @param i index of a note. must be inside this view.
+    inline long duration_num(size_t i) const override
+    { assert(i - _first < _durn.size()); return _durn[i - _first]; }
+    inline long duration_den(size_t i) const override
+    { assert(i - _first < _durd.size()); return _durd[i - _first]; }
+
+    /// print flag of the note at the given index, at construction
+    /// of this view.
+    /// @param i index of a note. must be inside this view.
+    inline bool printed(size_t i) const override
+    { assert(i - _first < _prints.size()); return _prints[i - _first]; }
+
+    /// set of the pitch classes of the notes of this view,
+    /// pitch class p is in the set iff bit p is 1.
+    inline uint16_t pcset() const { return _pcs; }
+
+    /// table of the chords of this view, built at construction.
+    inline const PSChords& chords() const { return _chords; }
+
+public: // modification
+
+    /// the bounds of a view cannot be changed.
+    void reset(size_t i0, size_t i1) override;
+
+    /// rename the note at the given index in the embedding enumerator.
+    /// this view is not updated.
+    /// @param i index of a note in this view.
+    /// @param name note name in 'A'..'G'.
+    /// @param accid accidental in [-2, 2] where 1 is a half tone
+    /// @param oct octave number in Pitch::OCTAVE_MIN and Pitch::OCTAVE_MAX.
+    /// @param printed whether the accidental must be printed.
+    void rename(size_t i,
+                const enum NoteName& name, const enum Accid& accid,
+                int oct, bool printed) override;
+
+private: // data
+
+    /// embedding enumerator, for renaming.
+    PSEnum& _container;
+
+    /// copy of the MIDI keys of the notes.
+    std::vector<unsigned int> _midi;
+
+    /// copy of the bar numbers of the notes.
+    std::vector<long> _bars;
+
+    /// copy of the simultaneity flags of the notes.
+    std::vector<bool> _simult;
+
+    /// copy of the names of the notes.
+    std::vector<enum NoteName> _names;
+
+    /// copy of the accidentals of the notes.
+    std::vector<enum Accid> _accids;
+
+    /// copy of the octaves of the notes.
+    std::vector<int> _octs;
+
+    /// copy of the duration numerators of the notes.
+    std::vector<long> _durn;
+
+    /// copy of the duration denominators of the notes.
+    std::vector<long> _durd;
+
+    /// copy of the print flags of the notes.
+    std::vector<bool> _prints;
+
+    /// 12 bits set of the pitch classes of the notes.
+    uint16_t _pcs;
+
+    /// chords of the notes.
+    PSChords _chords;
+
+};
+
+
+} // namespace pse
+
+#endif /* PSBarView_hpp */
+
+/// @}
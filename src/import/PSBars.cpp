@@ -0,0 +1,40 @@
+//
+//  PSBars.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include "PSBars.hpp"
+
+
+namespace pse {
+
+
+PSBars::PSBars(const PSEnum& e):
+_offsets()
+{
+    size_t n0 = e.first();
+    size_t n1 = e.open()?(e.first() + e.size()):e.stop();
+    for (size_t i = n0; i < n1; ++i)
+    {
+        long bar = e.measure(i);
+        assert(0 <= bar);
+        assert(_offsets.empty() or (size_t) bar + 1 >= _offsets.size());
+        // bars up to the bar of i start at i (empty bars before it)
+        while (_offsets.size() <= (size_t) bar)
+            _offsets.push_back(i);
+    }
+    _offsets.push_back(n1);
+}
+
+
+PSBars::~PSBars()
+{ }
+
+
+} // end namespace pse
+
+/// @}
@@ -0,0 +1,74 @@
+//
+//  PSBars.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef PSBars_hpp
+#define PSBars_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <vector>
+
+#include "pstrace.hpp"
+#include "PSEnum.hpp"
+
+
+namespace pse {
+
+
+/// index of the bars of an enumerator of notes, in compressed form:
+/// the notes of the bar number b are the notes of index in
+/// first(b)..stop(b) (excluded) in the enumerator.
+/// It is built in one pass over the notes, and replaces the scans
+/// of the notes for finding the bounds of bars.
+/// The empty bars before the last bar are indexed, with first(b) == stop(b)
+/// the index of the first note of the next non-empty bar.
+class PSBars
+{
+public:
+
+    /// index of the bars of the notes of the given enumerator.
+    /// @param e an enumerator of notes.
+    /// the bar numbers of its notes must be positive and non-decreasing.
+    /// @warning e is not referenced by this index.
+    PSBars(const PSEnum& e);
+
+    ~PSBars();
+
+    /// number of bars indexed, from 0 to the bar of the last note.
+    /// 0 if the enumerator is empty.
+    inline size_t size() const { return _offsets.size() - 1; }
+
+    /// index of the first note of the given bar.
+    /// @param b a bar number. must be smaller than size().
+    inline size_t first(size_t b) const
+    { assert(b+1 < _offsets.size()); return _offsets[b]; }
+
+    /// index of the note after the last note of the given bar.
+    /// @param b a bar number. must be smaller than size().
+    inline size_t stop(size_t b) const
+    { assert(b+1 < _offsets.size()); return _offsets[b+1]; }
+
+    /// whether the given bar contains no note.
+    /// @param b a bar number. must be smaller than size().
+    inline bool empty(size_t b) const { return first(b) == stop(b); }
+
+private:
+
+    /// _offsets[b] is the index of the first note of bar b,
+    /// and the last element is the index of the note after the last note.
+    std::vector<size_t> _offsets;
+
+};
+
+
+} // end namespace pse
+
+#endif /* PSBars_hpp */
+
+/// @}
@@ -15,15 +15,21 @@ namespace pse {
 
 PSRawEnum::PSRawEnum(size_t i0, size_t i1):
 PSEnum(i0, i1), // empty
-_notes(new std::vector<int>), // empty initial vector
-_barnum(new std::vector<int>),
-_simult(new std::vector<bool>),
-_durations(new std::vector<PSRatio>),
+_notes(new std::vector<int64_t>), // empty initial vector
+_barnum(new std::vector<int64_t>),
+_simult(new std::vector<uint8_t>),
+_durnum(new std::vector<int64_t>),
+_durden(new std::vector<int64_t>),
 _names(new std::vector<enum NoteName>),
 _accids(new std::vector<enum Accid>),
 _octs(new std::vector<int>),
-_prints(new std::vector<bool>)
-{ }
+_prints(new std::vector<bool>),
+_given(new std::vector<bool>),
+_dirty(new std::set<size_t>),
+_buffers(new PSNoteBuffers)
+{
+    bind(); // view of the empty input lists
+}
 
 
 //PSRawEnum::PSRawEnum(const std::vector<int>& notes,
@@ -43,11 +49,15 @@ PSEnum(e), // copy
 _notes(e._notes),  // shallow copy of pointer
 _barnum(e._barnum),
 _simult(e._simult),
-_durations(e._durations),
+_durnum(e._durnum),
+_durden(e._durden),
 _names(e._names),
 _accids(e._accids),
 _octs(e._octs),
-_prints(e._prints)
+_prints(e._prints),
+_given(e._given),
+_dirty(e._dirty),
+_buffers(e._buffers)
 //_notes(new std::vector<int>(*(e._notes))),  // vector copy (same vector elements)
 //_barnum(new std::vector<int>(*(e._barnum))),
 //_simult(new std::vector<bool>(*(e._simult))),
@@ -59,11 +69,15 @@ _prints(e._prints)
     assert(e._notes);
     assert(e._barnum);
     assert(e._simult);
-    assert(e._durations);
+    assert(e._durnum);
+    assert(e._durden);
     assert(e._names);
     assert(e._accids);
     assert(e._octs);
     assert(e._prints);
+    assert(e._given);
+    assert(e._dirty);
+    assert(e._buffers);
 }
 
 
@@ -78,20 +92,28 @@ PSEnum(e, i0),
 _notes(e._notes),  // shallow copy of pointer
 _barnum(e._barnum),
 _simult(e._simult),
-_durations(e._durations),
+_durnum(e._durnum),
+_durden(e._durden),
 _names(e._names),
 _accids(e._accids),
 _octs(e._octs),
-_prints(e._prints)
+_prints(e._prints),
+_given(e._given),
+_dirty(e._dirty),
+_buffers(e._buffers)
 {
     assert(e._notes);
     assert(e._barnum);
     assert(e._simult);
-    assert(e._durations);
+    assert(e._durnum);
+    assert(e._durden);
     assert(e._names);
     assert(e._accids);
     assert(e._octs);
     assert(e._prints);
+    assert(e._given);
+    assert(e._dirty);
+    assert(e._buffers);
 }
 
 
@@ -106,20 +128,28 @@ PSEnum(e, i0, i1),
 _notes(e._notes),  // shallow copy of pointer
 _barnum(e._barnum),
 _simult(e._simult),
-_durations(e._durations),
+_durnum(e._durnum),
+_durden(e._durden),
 _names(e._names),
 _accids(e._accids),
 _octs(e._octs),
-_prints(e._prints)
+_prints(e._prints),
+_given(e._given),
+_dirty(e._dirty),
+_buffers(e._buffers)
 {
     assert(e._notes);
     assert(e._barnum);
     assert(e._simult);
-    assert(e._durations);
+    assert(e._durnum);
+    assert(e._durden);
     assert(e._names);
     assert(e._accids);
     assert(e._octs);
     assert(e._prints);
+    assert(e._given);
+    assert(e._dirty);
+    assert(e._buffers);
 }
 
 
@@ -141,26 +171,67 @@ bool PSRawEnum::sanity_check() const
     if (_notes == nullptr)        return false;
     if (_barnum == nullptr)       return false;
     if (_simult == nullptr)       return false;
-    if (_durations == nullptr)    return false;
+    if (_durnum == nullptr)       return false;
+    if (_durden == nullptr)       return false;
     if (_names == nullptr)        return false;
     if (_accids == nullptr)       return false;
     if (_octs == nullptr)         return false;
+    if (_prints == nullptr)       return false;
+    if (_given == nullptr)        return false;
+    if (_dirty == nullptr)        return false;
+    if (_buffers == nullptr)      return false;
+    if (buffered() and not _notes->empty()) return false;
     if (_barnum->size() != _notes->size()) return false;
-    if (_simult->size() != _notes->size()) return false;
-    if (_durations->size() != _notes->size()) return false;
-    if (_names->size()  != _notes->size()) return false;
-    if (_accids->size() != _notes->size()) return false;
-    if (_octs->size()   != _notes->size()) return false;
-    if (_prints->size() != _notes->size()) return false;
+    if (_durnum->size() != _notes->size()) return false;
+    if (_durden->size() != _notes->size()) return false;
+    size_t n = nbNotes();
+    if (not buffered() and _notes->size() != n) return false;
+    if (n > 0 and _buffers->simult == nullptr) return false;
+    if (_buffers->simult == _simult->data() and _simult->size() != n)
+        return false;
+    if (_names->size()  != n) return false;
+    if (_accids->size() != n) return false;
+    if (_octs->size()   != n) return false;
+    if (_prints->size() != n) return false;
+    if (_given->size()  != n) return false;
     return true;
 }
 
 
+void PSRawEnum::bind()
+{
+    assert(_buffers);
+    _buffers->size = _notes->size();
+    _buffers->midi = _notes->data();
+    _buffers->bars = _barnum->data();
+    _buffers->simult = _simult->data();
+    _buffers->dur_num = _durnum->data();
+    _buffers->dur_den = _durden->data();
+    _buffers->owner.reset();
+}
+
+
+bool PSRawEnum::buffered() const
+{
+    assert(_buffers);
+    assert(_notes);
+    // the view is bound to the input lists, unless set() was called
+    return (_buffers->midi != _notes->data());
+}
+
+
+size_t PSRawEnum::nbNotes() const
+{
+    assert(_buffers);
+    return _buffers->size;
+}
+
+
 size_t PSRawEnum::size() const
 {
     assert(sanity_check());
     if (open())
-        return _notes->size() - first();
+        return nbNotes() - first();
     else
         return stop() - first();
 }
@@ -168,41 +239,47 @@ size_t PSRawEnum::size() const
 
 unsigned int PSRawEnum::midipitch(size_t i) const
 {
-    assert(_notes);
-    assert(i < _notes->size());
-    return _notes->at(i);
+    assert(i < _buffers->size);
+    return _buffers->midi[i];
 }
 
 
 long PSRawEnum::measure(size_t i) const
 {
-    assert(_barnum);
-    assert(i < _barnum->size());
-    return _barnum->at(i);
+    assert(i < _buffers->size);
+    return _buffers->bars[i];
 }
 
 
 bool PSRawEnum::simultaneous(size_t i) const
 {
-    assert(_simult);
-    assert(i < _simult->size());
-    return _simult->at(i);
+    assert(i < _buffers->size);
+    assert(_buffers->simult);
+    return (_buffers->simult[i] != 0);
 }
 
 
 long PSRawEnum::duration_num(size_t i) const
 {
-    assert(_durations);
-    assert(i < _durations->size());
-    return _durations->at(i).numerator();
+    assert(i < _buffers->size);
+    if (_buffers->dur_num == nullptr)
+        return 0;
+    else if (_buffers->dur_den == nullptr)
+        return _buffers->dur_num[i];
+    else // normalized
+        return PSRatio(_buffers->dur_num[i],
+                       _buffers->dur_den[i]).numerator();
 }
 
 
 long PSRawEnum::duration_den(size_t i) const
 {
-    assert(_durations);
-    assert(i < _durations->size());
-    return _durations->at(i).denominator();
+    assert(i < _buffers->size);
+    if (_buffers->dur_num == nullptr or _buffers->dur_den == nullptr)
+        return 1;
+    else // normalized
+        return PSRatio(_buffers->dur_num[i],
+                       _buffers->dur_den[i]).denominator();
 }
 
 
@@ -267,8 +344,10 @@ void PSRawEnum::reset(size_t i0, size_t i1)
     _barnum->clear();
     assert(_simult);
     _simult->clear();
-    assert(_durations);
-    _durations->clear();
+    assert(_durnum);
+    _durnum->clear();
+    assert(_durden);
+    _durden->clear();
     assert(_names);
     _names->clear();
     assert(_accids);
@@ -277,6 +356,11 @@ void PSRawEnum::reset(size_t i0, size_t i1)
     _octs->clear();
     assert(_prints);
     _prints->clear();
+    assert(_given);
+    _given->clear();
+    assert(_dirty);
+    _dirty->clear();
+    bind(); // view of the empty input lists
 }
 
 
@@ -297,6 +381,11 @@ void PSRawEnum::add(int midi, int bar, bool simult, const PSRatio& dur,
     assert((accid == Accid::Undef) == (name == NoteName::Undef));
     assert((oct == Pitch::UNDEF_OCTAVE) == (name == NoteName::Undef));
     assert(Pitch::check_octave(oct));
+    if (buffered())
+    {
+        ERROR("PSRawEnum add: cannot add a note to a view of buffers");
+        return;
+    }
 
     // note is a MIDI key
     assert(MidiNum::check_midi(midi));
@@ -314,9 +403,11 @@ void PSRawEnum::add(int midi, int bar, bool simult, const PSRatio& dur,
     assert(_simult);
     _simult->push_back(simult);
 
-    // duration
-    assert(_durations);
-    _durations->push_back(dur);
+    // duration (normalized)
+    assert(_durnum);
+    _durnum->push_back(dur.numerator());
+    assert(_durden);
+    _durden->push_back(dur.denominator());
     
     assert(_names);
     assert(_accids);
@@ -331,21 +422,150 @@ void PSRawEnum::add(int midi, int bar, bool simult, const PSRatio& dur,
         _names->push_back(NoteName::Undef);
         _accids->push_back(Accid::Undef);
         _octs->push_back(Pitch::UNDEF_OCTAVE);
+        _given->push_back(false);
     }
     else
     {
         _names->push_back(name); // NoteName::Undef
         _accids->push_back(accid); // Accid::Undef
         _octs->push_back(oct); // Pitch::UNDEF_OCTAVE
+        _given->push_back(name != NoteName::Undef);
     }
     assert(_prints);
     _prints->push_back(printed); // false
+    bind(); // the input lists may have been reallocated
 
     if (! open() && (_notes->size() > _stop))
         _stop = _notes->size();
 }
 
 
+bool PSRawEnum::set(const PSNoteBuffers& buf)
+{
+    assert(sanity_check());
+    if (buf.size > 0 and (buf.midi == nullptr or buf.bars == nullptr))
+    {
+        ERROR("PSRawEnum set: missing buffer of MIDI keys or bar numbers");
+        return false;
+    }
+    if ((buf.dur_num == nullptr) and (buf.dur_den != nullptr))
+    {
+        ERROR("PSRawEnum set: denominators of durations without numerators");
+        return false;
+    }
+
+    // single pass of checks, no copy
+    for (size_t i = 0; i < buf.size; ++i)
+    {
+        if (buf.midi[i] < 0 or buf.midi[i] > 128 or
+            not MidiNum::check_midi((unsigned int) buf.midi[i]))
+        {
+            ERROR("PSRawEnum set: note {}: invalid MIDI key {}",
+                  i, buf.midi[i]);
+            return false;
+        }
+        if (buf.bars[i] < 0 or (i > 0 and buf.bars[i] < buf.bars[i-1]))
+        {
+            ERROR("PSRawEnum set: note {}: invalid bar number {}",
+                  i, buf.bars[i]);
+            return false;
+        }
+        if (buf.dur_den != nullptr and buf.dur_den[i] == 0)
+        {
+            ERROR("PSRawEnum set: note {}: null duration denominator", i);
+            return false;
+        }
+    }
+    
+    bool o = open();
+    reset(0, o?PSEnum::ID_INF:buf.size); // clear the input lists
+    if (buf.size > 0) // empty view = view of the empty input lists
+    {
+        *_buffers = buf;
+        // the accessors read the simultaneity flags without test
+        if (buf.simult == nullptr)
+        {
+            _simult->assign(buf.size, 0);
+            _buffers->simult = _simult->data();
+        }
+    }
+    _names->assign(buf.size, NoteName::Undef);
+    _accids->assign(buf.size, Accid::Undef);
+    _octs->assign(buf.size, Pitch::UNDEF_OCTAVE);
+    _prints->assign(buf.size, false);
+    _given->assign(buf.size, false);
+    assert(sanity_check());
+    return true;
+}
+
+
+bool PSRawEnum::modify(size_t i, int midi, bool simult)
+{
+    assert(sanity_check());
+    if (buffered())
+    {
+        ERROR("PSRawEnum modify: cannot modify a note of a view of buffers");
+        return false;
+    }
+    if (outside(i))
+    {
+        ERROR("PSRawEnum modify: note {} out of range", i);
+        return false;
+    }
+    assert(MidiNum::check_midi(midi));
+    assert(i < _notes->size());
+    _notes->at(i) = midi;
+    _simult->at(i) = simult;
+
+    // the spelling of the modified note is reset,
+    // and the spellings of the notes of the bar estimated by rename,
+    // which are not constraints for the next spelling.
+    _given->at(i) = false;
+    const int64_t bar = _barnum->at(i);
+    size_t i0 = i;
+    while (i0 > 0 and _barnum->at(i0-1) == bar)
+        --i0;
+    size_t i1 = i + 1;
+    while (i1 < _notes->size() and _barnum->at(i1) == bar)
+        ++i1;
+    resetSpellings(i0, i1);
+    TRACE("PSRawEnum modify: note {} in bar {}", i, bar);
+    _dirty->insert((size_t) bar);
+    return true;
+}
+
+
+void PSRawEnum::resetSpellings(size_t i0, size_t i1)
+{
+    assert(sanity_check());
+    assert(i0 <= i1);
+    assert(i1 <= nbNotes());
+    for (size_t k = i0; k < i1; ++k)
+    {
+        if (_given->at(k))
+            continue;
+        _names->at(k) = NoteName::Undef;
+        _accids->at(k) = Accid::Undef;
+        _octs->at(k) = Pitch::UNDEF_OCTAVE;
+        _prints->at(k) = false;
+    }
+}
+
+
+const std::set<size_t>& PSRawEnum::dirty() const
+{
+    assert(_dirty);
+    return *_dirty;
+}
+
+
+void PSRawEnum::clean()
+{
+    assert(_dirty);
+    _dirty->clear();
+}
+
+
 void PSRawEnum::addlong(int midi, int bar, bool simult,
                         long dur_num, long dur_den)
 {
@@ -366,12 +586,12 @@ void PSRawEnum::rename(size_t i,
                        bool altprint)
 {
     assert(_notes);
-    assert(i < _notes->size());
+    assert(i < nbNotes());
     // int m = MidiNum::to_midi(n, a, o);
-    if (MidiNum::to_midi(n, a, o) != _notes->at(i))
+    if (MidiNum::to_midi(n, a, o) != midipitch(i))
     {
         ERROR("PSRawEnum: MIDI pitch {} cannot be named by {}{} {}",
-              _notes->at(i), n, a, o);
+              midipitch(i), n, a, o);
         return;
     }
 
@@ -409,7 +629,8 @@ void PSRawEnum::rename(size_t i,
 
 void PSRawEnum::rename(size_t i, const enum NoteName& n, bool altprint)
 {
-    int m = _notes->at(i);
+    assert(i < nbNotes());
+    int m = midipitch(i);
     enum Accid a = MidiNum::class_to_accid(m%12, n);
     if (a == Accid::Undef)
     {
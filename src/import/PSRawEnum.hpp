@@ -17,6 +17,8 @@
 #include <assert.h>
 #include <memory>
 #include <vector>
+#include <set>
+#include <cstdint>
 
 #include "pstrace.hpp"
 #include "PSRational.hpp"
@@ -37,9 +39,44 @@ namespace pse {
 //   pybind accessors to this path (for name and accid)
 
 
+/// view of contiguous buffers of input notes, external (e.g. NumPy arrays)
+/// or owned by an enumerator.
+/// The external buffers are not copied, they must not be modified while they
+/// are viewed by an enumerator.
+struct PSNoteBuffers
+{
+    /// number of notes in every buffer.
+    size_t size = 0;
+
+    /// MIDI key of each note, in 0..128.
+    const int64_t* midi = nullptr;
+
+    /// bar number of each note, positive and non-decreasing.
+    const int64_t* bars = nullptr;
+
+    /// simultaneity of each note with the next note (non-zero if the note
+    /// is simultaneous with the next note).
+    /// optional (null if no note is simultaneous with the next note).
+    const uint8_t* simult = nullptr;
+
+    /// numerator of duration of each note, in fraction of bars.
+    /// optional (null for durations 0).
+    const int64_t* dur_num = nullptr;
+
+    /// denominator of duration of each note, in fraction of bars.
+    /// optional (null for denominators 1).
+    const int64_t* dur_den = nullptr;
+
+    /// owner of the buffers, kept alive as long as they are viewed.
+    /// optional.
+    std::shared_ptr<const void> owner;
+};
+
+
 /// Implementation of a basic PSEnum, with
 /// - input buffer of notes (MIDI pitches and associated bar number),
-///   filled manually, with the add() function
+///   filled manually, with the add() function,
+///   or viewed in external buffers, set with the set() function
 /// - output buffers of note names, accidentals, octaves and print flags,
 ///   filled by callback of the rename() function.
 struct PSRawEnum : public PSEnum
@@ -241,6 +278,51 @@ public: // modification : add, rename and rewrite passing notes
                  bool simult=false,
                  long dur_num=0, long dur_den=1);
     
+    /// replace the list of enumerated notes by a view of the given
+    /// external buffers, without copy.
+    /// The output buffers (names, accidentals, octaves, print flags)
+    /// are reset to undef values.
+    /// @param buf external buffers of input notes.
+    /// @return whether the buffers are well formed and were set.
+    /// in case of failure, this enumerator is unchanged.
+    /// @warning the interval of this enumerator is reset to
+    /// 0..buf.size, or left bounded by 0 if it is open.
+    /// @warning notes cannot be added with add() to a view of buffers.
+    bool set(const PSNoteBuffers& buf);
+
+    /// the input notes of this enumerator are viewed in external buffers.
+    /// @see set()
+    bool buffered() const;
+
+    /// replace the input note of given index by a note in the same bar,
+    /// for the re-spelling of a modified score.
+    /// The bar of the note is marked as dirty, and the spellings estimated
+    /// for the notes of this bar (by rename) are reset to undef values,
+    /// as well as the spelling of the modified note.
+    /// @param i index of a note. must be inside the interval of this enumerator.
+    /// @param midi new MIDI key of the note. must be in 0..128.
+    /// @param simult whether the note is simultaneous with the next note.
+    /// @return whether the note was modified.
+    /// @warning the notes of a view of buffers cannot be modified.
+    /// @see dirty()
+    bool modify(size_t i, int midi, bool simult=false);
+
+    /// reset to undef values the spellings estimated by rename for the
+    /// notes in the given interval. The spellings given with the notes
+    /// (constraints) are kept.
+    /// @param i0 index of the first note of the interval.
+    /// @param i1 index of the note after the last note of the interval.
+    /// must be larger than or equal to i0.
+    void resetSpellings(size_t i0, size_t i1);
+
+    /// numbers of the bars containing a note modified since the
+    /// last call to clean().
+    /// @see modify()
+    const std::set<size_t>& dirty() const;
+
+    /// unmark all the dirty bars, e.g. after they are re-spelled.
+    void clean();
+
     /// record new NoteName, Accid, Octave, print flag for the note of given index.
     /// @param i index of a note. must be inside the interval of this enumerator.
     /// @param n note name in 'A'..'G'.
@@ -272,19 +354,24 @@ private: // data (shared by all copies of this enumerator)
        
     /// list of MIDI pitch of all notes in input.
     /// entered with method add().
-    std::shared_ptr<std::vector<int>> _notes;
+    std::shared_ptr<std::vector<int64_t>> _notes;
 
     /// list of bar number to which belongs each input note.
     /// entered with method add().
-    std::shared_ptr<std::vector<int>> _barnum;
+    std::shared_ptr<std::vector<int64_t>> _barnum;
     
     /// list of simultaneity with next note, for each input note
-    /// entered with method add().
-    std::shared_ptr<std::vector<bool>> _simult;
+    /// entered with method add(), or all zero for external buffers
+    /// without simultaneity.
+    std::shared_ptr<std::vector<uint8_t>> _simult;
     
-    /// list of durations of input notes.
+    /// list of numerators of the durations (normalized) of input notes.
+    /// entered with method add().
+    std::shared_ptr<std::vector<int64_t>> _durnum;
+
+    /// list of denominators of the durations (normalized) of input notes.
     /// entered with method add().
-    std::shared_ptr<std::vector<PSRatio>> _durations;
+    std::shared_ptr<std::vector<int64_t>> _durden;
     
     /// list of the estimated best note name (in 0..6) for each input note.
     /// copy of the values of the PSPaths (best paths) in the columns of table,
@@ -307,6 +394,26 @@ private: // data (shared by all copies of this enumerator)
     /// temporaly stored by rename, because the input notes are const protected.
     std::shared_ptr<std::vector<bool>> _prints;
 
+    /// for each input note, whether its name, accidental and octave
+    /// were given with the note (constraint), and not estimated by rename.
+    std::shared_ptr<std::vector<bool>> _given;
+
+    /// numbers of the bars containing a note modified with modify().
+    std::shared_ptr<std::set<size_t>> _dirty;
+
+    /// view of the input notes read by the accessors: either the above
+    /// input lists, or external buffers set with set().
+    /// It is updated at every change of the input lists, such that the
+    /// accessors read it without testing the origin of the notes.
+    /// @see set()
+    std::shared_ptr<PSNoteBuffers> _buffers;
+
+    /// point the view of input notes to the above input lists.
+    void bind();
+
+    /// number of input notes, in the input lists or in the external buffers.
+    size_t nbNotes() const;
+
     bool sanity_check() const;
        
 };
@@ -16,9 +16,14 @@ SpellerEnum(0, false, Algo::PS13, dflag),
 _scales(),       // empty vector
 _Kpre(kpre),
 _Kpost(kpost),
-_global()        // Undef Ton
+_global(),       // Undef Ton
+_hist(),
+_left(0),
+_right(0),
+_next(0)
 {
     init_scales();
+    restart();
 }
 
 
@@ -71,51 +76,111 @@ bool PS13::spell()
 {
     // step 1: name all notes in enumerator
     assert(_enum);
-    for (size_t n = _enum->first(); n < _enum->stop(); ++n)
+    restart();
+    stream(true);
+    assert(_enum->open() or _next == _enum->stop());
+    return true;
+}
+
+
+void PS13::restart()
+{
+    assert(_enum);
+    _hist.fill(0);
+    _left = _enum->first();
+    _right = _enum->first();
+    _next = _enum->first();
+}
+
+
+size_t PS13::stream(bool last)
+{
+    assert(_enum);
+    size_t efirst = _enum->first();
+    size_t estop = _enum->open()?(efirst + _enum->size()):_enum->stop();
+    assert(efirst <= _next);
+    assert(_next <= estop);
+    size_t n0 = _next;
+    for (; _next < estop; ++_next)
+    {
+        // the Kpost notes after next are not all known yet
+        if (not last and estop - _next < _Kpost)
+            break;
+        slide(_next, estop);
+        spellNote(_next);
+    }
+    return _next - n0;
+}
+
+
+void PS13::slide(size_t n, size_t stop)
+{
+    assert(_enum);
+    size_t efirst = _enum->first();
+    assert(efirst <= n);
+    assert(n < stop);
+    // bounds of the window [n-Kpre, n+Kpost)
+    size_t left = (n - efirst >= _Kpre)?(n - _Kpre):efirst;
+    size_t right = (stop - n >= _Kpost)?(n + _Kpost):stop;
+    assert(_left <= left);
+    assert(_right <= right);
+    for (; _right < right; ++_right)
     {
-        // pitch class of n
-        int nm = _enum->midipitch(n);
-        assert(MidiNum::check_midi(nm)); // assert(0 <= nm); assert(nm <= 128);
-        unsigned int nc = nm % 12;
-
-        // counter for each candidate name for note n
-        std::array<size_t, 7> nname;
-        nname.fill(0);
-        int maxi = -1; // name in 0..6 with maximal count
-        enum NoteName maxName = NoteName::Undef;
-        
-        // for all pitch class
-        for (int p = 0; p < 11; ++p)
+        unsigned int mp = _enum->midipitch(_right);
+        assert(MidiNum::check_midi(mp));
+        ++_hist[mp%12];
+    }
+    for (; _left < left; ++_left)
+    {
+        unsigned int mp = _enum->midipitch(_left);
+        assert(MidiNum::check_midi(mp));
+        assert(_hist[mp%12] > 0);
+        --_hist[mp%12];
+    }
+}
+
+
+void PS13::spellNote(size_t n)
+{
+    assert(_enum);
+    // pitch class of n
+    int nm = _enum->midipitch(n);
+    assert(MidiNum::check_midi(nm)); // assert(0 <= nm); assert(nm <= 128);
+    unsigned int nc = nm % 12;
+
+    // counter for each candidate name for note n
+    std::array<size_t, 7> nname;
+    nname.fill(0);
+    int maxi = -1; // name in 0..6 with maximal count
+    enum NoteName maxName = NoteName::Undef;
+    
+    // for all pitch class
+    for (int p = 0; p < 11; ++p)
+    {
+        // degree of n in the chromatic harmonic scale of p
+        size_t deg = (p <= nc)?(nc - p):(12-p+nc);
+        assert(0 <= deg); // debug
+        assert(deg < 12);
+        // name of n in chromatic harmonic scale of p
+        const enum NoteName nn = _scales[p].name(deg);
+        assert(nn != NoteName::Undef);
+        int nni = toint(nn);
+        assert(0 <= nni);
+        assert(nni < 7);
+        // number of occurrences of p in the window of n
+        nname[nni] += _hist[p];
+        if (maxi == -1 || nname[nni] > nname[maxi])
         {
-            
-            // degree of n in the chromatic harmonic scale of p
-            size_t deg = (p <= nc)?(nc - p):(12-p+nc);
-            assert(0 <= deg); // debug
-            assert(deg < 12);
-            // name of n in chromatic harmonic scale of p
-            const enum NoteName nn = _scales[p].name(deg);
-            assert(nn != NoteName::Undef);
-            int nni = toint(nn);
-            assert(0 <= nni);
-            assert(nni < 7);
-            //size_t cpn = count(p, n);
-            nname[nni] += count(p, n);
-            if (maxi == -1 || nname[nni] > nname[maxi])
-            {
-                maxi = nni;
-                maxName = nn;
-            }
+            maxi = nni;
+            maxName = nn;
         }
-        // set name of n to maxi
-        assert(0 <= maxi);
-        assert(maxi < 7);
-        assert(maxName != NoteName::Undef);
-        assert(_enum);
-        _enum->rename(n, maxName);
-        DEBUGU("PS13: rename {} with {}", n, maxName);
     }
-    
-    return true;
+    // set name of n to maxi
+    assert(0 <= maxi);
+    assert(maxi < 7);
+    assert(maxName != NoteName::Undef);
+    _enum->rename(n, maxName);
+    DEBUGU("PS13: rename {} with {}", n, maxName);
 }
 
 
@@ -127,36 +192,6 @@ bool PS13::rename(size_t n)
 }
 
 
-size_t PS13::count(int c, size_t n) const
-{
-    assert(_enum);
-    return _enum->count(c, n, _Kpre, _Kpost);
-    // assert(0 <= c);
-    // assert(c < 12);
-    // assert(! _enum.open());
-    // assert(! _enum.empty());
-    // size_t efirst = _enum.first();
-    // size_t estop = _enum.stop();
-    // assert(efirst <= n);
-    // assert(n <= _enum.stop());
-    // size_t left = (n - efirst >= _Kpre)?(n - _Kpre):efirst;
-    // size_t right = (estop - n >= _Kpost)?(n + _Kpost):estop;
-    // assert(left <= right);
-    // unsigned int cpt = 0;
-    // for (size_t i = left; i < right; ++i)
-    // {
-    //     assert(efirst <= i);
-    //     assert(i < estop);
-    //     unsigned int mp = _enum.midipitch(i);
-    //     assert(0 <= mp);
-    //     assert(mp <= 128);
-    //     if (mp%12 == c)
-    //         ++cpt;
-    // }
-    // return cpt;
-}
-
-
 size_t PS13::globals() const
 {
     return 0;
@@ -66,6 +66,23 @@ public:
     /// compute the best pitch spelling for the input notes.
     /// @return whether computation was succesfull.
     bool spell() override;
+
+    /// streaming mode: spell the input notes not spelled yet whose window
+    /// of Kpost next notes is complete, i.e. the notes of index n such that
+    /// n + Kpost is at most the number of notes added so far.
+    /// The spellings are the same as with spell() on the whole sequence.
+    /// @param last whether all the notes have been added.
+    /// In this case, all the remaining notes are spelled.
+    /// @return the number of notes spelled by this call.
+    /// @warning restart() must be called when the notes are reset.
+    size_t stream(bool last = false);
+
+    /// number of input notes spelled in streaming mode.
+    /// they are the notes of index smaller than first() + spelled().
+    inline size_t spelled() const { return _next - _enum->first(); }
+
+    /// restart the streaming from the first input note.
+    void restart();
     
     /// rename all notes read by this speller.
     /// For PS13, it is just a call to spell().
@@ -108,10 +125,31 @@ private: // data
     // one estimated local tonality for each note.
     // std::vector<Ton> _locals;
 
-    /// count the number of occurrences of the pitch-class c in [n-Kpre, n+Kpost)
-    size_t count(int c, size_t n) const;
-    
+    /// histogram of the pitch classes of the notes in the window
+    /// [_left, _right), updated incrementally when the window slides.
+    std::array<size_t, 12> _hist;
+
+    /// first note of the current window.
+    size_t _left;
+
+    /// note after the last note of the current window.
+    size_t _right;
+
+    /// index of the next note to spell in streaming mode.
+    size_t _next;
+
     void init_scales();
+
+    /// slide the window to [n-Kpre, n+Kpost) restricted to [first, stop),
+    /// and update the histogram with the notes entering and leaving it.
+    /// @param n index of a note, not smaller than the previous one.
+    /// @param stop index of the note after the last input note.
+    void slide(size_t n, size_t stop);
+
+    /// rename the note of given index with the name maximizing the sum
+    /// of the counts of the pitch classes in the current window.
+    /// @param n index of a note. the window must have been slided to n.
+    void spellNote(size_t n);
         
 };
 
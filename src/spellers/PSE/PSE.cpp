@@ -9,6 +9,7 @@
 #include "CostA.hpp"
 #include "CostADplus.hpp"
 #include "CostADlex.hpp"
+#include "PSGridr.hpp"
 
 namespace pse {
 
@@ -33,6 +34,14 @@ Speller2Pass(nbTons, Algo::PSE, dflag)
 }
 
 
+PSE::PSE(std::shared_ptr<TonIndex> id, bool dflag):
+Speller2Pass(id, Algo::PSE, dflag)
+{
+    assert(id);
+    assert(not id->empty());
+}
+
+
 PSE::~PSE()
 {
     TRACE("delete PSE");
@@ -47,6 +56,15 @@ PSE::~PSE()
 
 /// @todo add steps rewrite passing notes
 bool PSE::spell()
+{
+    // CostA seed0, CostADplus seed1
+    //CostADlex seed0;
+    //CostADlex seed1;
+    return spell(CostType::ACCID, CostType::ADplus);
+}
+
+
+bool PSE::spell(CostType ct0, CostType ct1)
 {
     //DEBUGU("Speller respell: nb tonalities in table: {}", _table.nbTons());
     if (nbTons() == 0)
@@ -60,23 +78,71 @@ bool PSE::spell()
             addTon(ks, ModeName::Minor);
     }
 
-    //    if (finit)
-    //    {
-    //        for (auto ton : TONS) _tons.push_back(ton); // vector copy default tons
-    //        _rowcost.assign(nbtons(), 0);
-    //        _frowcost.assign(nbtons(), false);
-    //    }
-
-    CostA      seed0; // zero
-    CostADplus seed1; // zero
-    //CostADlex seed0;
-    //CostADlex seed1;
+    std::unique_ptr<Cost> seed0 = unique_zero(ct0); // zero
+    std::unique_ptr<Cost> seed1 = unique_zero(ct1); // zero
+    if (seed0 == nullptr or seed1 == nullptr)
+    {
+        ERROR("PSE spell: undefined cost type {} {}", ct0, ct1);
+        return false;
+    }
     // diff0=0, diff1=0, rename_flag1=false, rewrite_flag1=false
-    return Speller2Pass::spell(seed0, seed1, 100, 0, false, false);
+    return Speller2Pass::spell(*seed0, *seed1, 100, 0, false, false);
+}
+
+
+size_t PSE::stream(bool last, size_t lag)
+{
+    if (lag == 0)
+    {
+        ERROR("PSE stream: lag must be strictly positive");
+        return 0;
+    }
+    if (nbTons() == 0)
+    {
+        WARN("Speller stream: no tonality added, use default 30 tonality array");
+        for (int ks = -7; ks <= 7; ++ks)
+            addTon(ks, ModeName::Major);
+        for (int ks = -7; ks <= 7; ++ks)
+            addTon(ks, ModeName::Minor);
+    }
+    std::unique_ptr<Cost> seed0 = unique_zero(CostType::ACCID);
+    std::unique_ptr<Cost> seed1 = unique_zero(CostType::ADplus);
+    assert(seed0);
+    assert(seed1);
+    size_t n0 = spelled();
+    // diff0=100, diff1=0, like spell
+    Speller2Pass::stream(*seed0, *seed1, lag, 100, 0, last, true);
+    assert(n0 <= spelled());
+    return spelled() - n0;
 }
 
 
 
+bool PSE::respell()
+{
+    if (_table1 == nullptr or dynamic_cast<PSGr*>(_grid) == nullptr)
+    {
+        WARN("PSE respell: not spelled, spell from scratch");
+        return spell();
+    }
+    std::set<size_t> bars(rawenum().dirty()); // copy
+    if (bars.empty())
+    {
+        TRACE("PSE respell: no modified bar");
+        return true;
+    }
+    rawenum().clean();
+    // diff0=100, diff1=0, like spell
+    if (Speller2Pass::respell(bars, 100, 0))
+        return true;
+    WARN("PSE respell: update failed, spell from scratch");
+    // the spellings estimated by rename are not constraints
+    rawenum().resetSpellings(rawenum().first(),
+                             rawenum().first() + rawenum().size());
+    return spell();
+}
+
+
 // TBR not used
 //std::array<const PSState, PSV::NBTONS> PSV::ASTATES =
 //{
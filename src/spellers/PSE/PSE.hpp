@@ -21,6 +21,7 @@
 #include "Ton.hpp"
 #include "TonIndex.hpp"
 #include "Cost.hpp"
+#include "CostType.hpp"
 #include "PSRawEnum.hpp"
 #include "Speller2pass.hpp"
 #include "PSTable.hpp"
@@ -41,6 +42,14 @@ public:
     /// @param dflag debug mode.
     /// @see PSTable
     PSE(size_t nbTons=0, bool dflag=true);
+
+    /// constructor with a given array of tonalities.
+    /// initially empty list of notes to spell.
+    /// @param id a Ton Index. must be closed and not empty.
+    /// the global tonalities selected by the speller are stored in it,
+    /// it must not be shared by spellers running concurrently.
+    /// @param dflag debug mode.
+    PSE(std::shared_ptr<TonIndex> id, bool dflag=false);
     
     /// destructor
     virtual ~PSE();
@@ -52,6 +61,40 @@ public:
     /// compute the best pitch spelling for the input notes.
     /// @return whether computation was succesfull.
     bool spell() override;
+
+    /// compute the best pitch spelling for the input notes,
+    /// with the given types of costs.
+    /// @param ct0 type of cost for the first table.
+    /// @param ct1 type of cost for the second table.
+    /// @return whether computation was succesfull.
+    bool spell(CostType ct0, CostType ct1);
+
+    /// streaming mode: spell the input notes added since the last call,
+    /// in the bars whose local tonalities are fixed, i.e. the bars followed
+    /// by lag complete bars. A bar is complete when a note of a next bar
+    /// has been added. The time of one call does not depend on the number
+    /// of bars already spelled, except when the estimated global tonality
+    /// changes: the notes already spelled are then renamed with the new one.
+    /// @param last whether all the notes have been added.
+    /// In this case, all the remaining notes are spelled.
+    /// @param lag number of bars of lookahead. must be strictly positive.
+    /// @return the number of notes spelled by this call.
+    /// @warning the spellings can differ from the ones of spell(),
+    /// which selects the local tonalities on the whole sequence of notes.
+    /// @warning restart() must be called when the notes are reset.
+    size_t stream(bool last = false, size_t lag = 2);
+
+    /// re-spelling after the modification of input notes with modify():
+    /// only the columns of the tables for the modified bars, and for the
+    /// bars whose local tonalities change, are recomputed, and the grid is
+    /// recomputed from the first modified bar.
+    /// The notes are spelled from scratch if spell() was not called before,
+    /// or if the global flags of the index have changed since.
+    /// @return whether computation was succesfull.
+    /// @warning rename() must be called after re-spelling.
+    /// @warning modify() only replaces a note by another note in the same
+    /// bar. spell() must be called after notes are inserted or deleted.
+    bool respell();
     
     // Estimation of tonalities
         
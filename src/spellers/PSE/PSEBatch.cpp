@@ -0,0 +1,141 @@
+//
+//  PSEBatch.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+
+#include "PSEBatch.hpp"
+#include "PSE.hpp"
+#include "MidiNum.hpp"
+
+
+namespace pse {
+
+
+PSEBatch::PSEBatch(size_t nbTons, CostType ct0, CostType ct1,
+                   size_t threads, bool memo):
+_index(new TonIndex((nbTons == 0)?30:nbTons)), // closed
+_ct0(ct0),
+_ct1(ct1),
+_threads(threads),
+_pool(new PSPool(threads)),
+_memo(memo?std::make_shared<PSBMemo>(PSBMemo::CAPACITY):nullptr)
+{
+    assert(_index);
+    if (nbTons == 0)
+    {
+        WARN("PSEBatch: no tonality, use default 30 tonality array");
+    }
+    assert(_index->closed());
+}
+
+
+PSEBatch::~PSEBatch()
+{
+    TRACE("delete PSEBatch");
+    if (_memo)
+    {
+        TRACE("PSEBatch: {} bag searches cached, hit rate {}",
+              _memo->size(), _memo->hitRate());
+    }
+}
+
+
+std::vector<PSESpelling>
+PSEBatch::spell(const std::vector<PSENotes>& parts) const
+{
+    std::vector<PSESpelling> res(parts.size());
+    _pool->run(parts.size(), [this, &parts, &res](size_t k, size_t)
+    {
+        spell(parts[k], res[k]);
+    });
+    return res;
+}
+
+
+// static
+bool PSEBatch::check(const PSENotes& part, std::string& msg)
+{
+    if (part.bars.size() != part.midi.size() or
+        (not part.simult.empty() and part.simult.size() != part.midi.size()))
+    {
+        msg = "lists of notes of different lengths";
+        return false;
+    }
+    for (size_t i = 0; i < part.midi.size(); ++i)
+    {
+        if (part.midi[i] < 0 or part.midi[i] > 128 or
+            not MidiNum::check_midi((unsigned int) part.midi[i]))
+        {
+            msg = "note " + std::to_string(i) + ": invalid MIDI key " +
+                  std::to_string(part.midi[i]);
+            return false;
+        }
+        if (part.bars[i] < 0 or (i > 0 and part.bars[i] < part.bars[i-1]))
+        {
+            msg = "note " + std::to_string(i) + ": invalid bar number " +
+                  std::to_string(part.bars[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void PSEBatch::spell(const PSENotes& part, PSESpelling& res) const
+{
+    res.status = false;
+    std::string msg;
+    if (not check(part, msg))
+    {
+        ERROR("PSEBatch: {}", msg);
+        return;
+    }
+    if (part.midi.empty())
+    {
+        res.status = true;
+        return;
+    }
+
+    // copy of the closed array of tonalities, with initial globals
+    PSE sp(std::make_shared<TonIndex>(*_index), false);
+    if (_memo)
+        sp.setMemo(_memo);
+    for (size_t i = 0; i < part.midi.size(); ++i)
+    {
+        bool simult = (part.simult.empty())?false:part.simult[i];
+        sp.add(part.midi[i], part.bars[i], simult);
+    }
+    
+    res.status = sp.spell(_ct0, _ct1);
+    res.status = res.status and (sp.globals() > 0) and sp.rename(0);
+    if (not res.status)
+    {
+        ERROR("PSEBatch: failed to spell part of {} notes", part.midi.size());
+        return;
+    }
+
+    size_t n = sp.size();
+    res.names.reserve(n);
+    res.accids.reserve(n);
+    res.octaves.reserve(n);
+    res.printed.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        res.names.push_back(sp.name(i));
+        res.accids.push_back(sp.accidental(i));
+        res.octaves.push_back(sp.octave(i));
+        res.printed.push_back(sp.printed(i));
+    }
+    for (size_t i = 0; i < sp.globals(); ++i)
+        res.globals.push_back(sp.global(i));
+}
+
+
+} // end namespace pse
+
+/// @}
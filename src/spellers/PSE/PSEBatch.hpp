@@ -0,0 +1,159 @@
+//
+//  PSEBatch.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+
+#ifndef PSEBatch_hpp
+#define PSEBatch_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <memory>
+#include <vector>
+#include <string>
+
+#include "pstrace.hpp"
+#include "NoteName.hpp"
+#include "Accid.hpp"
+#include "Ton.hpp"
+#include "TonIndex.hpp"
+#include "CostType.hpp"
+#include "PSBMemo.hpp"
+#include "PSPool.hpp"
+
+
+namespace pse {
+
+/// notes of one part to spell in a batch.
+struct PSENotes
+{
+    /// MIDI pitch of each note.
+    std::vector<int> midi;
+
+    /// bar number of each note. same length as midi.
+    std::vector<int> bars;
+
+    /// simultaneous flag of each note (the note is simultaneous with the
+    /// next note, in the same chord). empty for no chords,
+    /// or same length as midi.
+    std::vector<bool> simult;
+};
+
+
+/// spelling of one part computed in a batch.
+struct PSESpelling
+{
+    /// whether the spelling of the part was successful.
+    bool status;
+
+    /// estimated name of each note.
+    std::vector<enum NoteName> names;
+
+    /// estimated accidental of each note.
+    std::vector<enum Accid> accids;
+
+    /// estimated octave of each note.
+    std::vector<int> octaves;
+
+    /// estimated print flag of each note.
+    std::vector<bool> printed;
+
+    /// candidate global tonalities, the first is the estimated one.
+    std::vector<Ton> globals;
+};
+
+
+/// batch spelling of many parts with PSE, on a pool of threads.
+/// The closed array of tonalities (with its tables of Weber distances)
+/// is built once, at construction of the batch.
+/// Every job spells with its own copy of this array,
+/// because the selection of global tonalities is stored in the array.
+/// The jobs can share a cache of results of bag searches, for the bars
+/// repeated in different parts (e.g. doublings).
+class PSEBatch
+{
+public:
+
+    /// batch speller.
+    /// @param nbTons default list of tonalities for all the jobs.
+    /// @see TonIndex for supported values. 0 is replaced by 30.
+    /// @param ct0 type of cost for the first table.
+    /// @param ct1 type of cost for the second table.
+    /// @param threads number of threads, 0 for hardware threads available.
+    /// @param memo whether the jobs share a cache of results of bag searches,
+    /// of capacity PSBMemo::CAPACITY. Otherwise, every job has its own cache.
+    PSEBatch(size_t nbTons = 30,
+             CostType ct0 = CostType::ACCID,
+             CostType ct1 = CostType::ADplus,
+             size_t threads = 0,
+             bool memo = true);
+
+    /// a batch speller cannot be copied.
+    PSEBatch(const PSEBatch& rhs) = delete;
+
+    ~PSEBatch();
+
+    /// a batch speller cannot be copied.
+    PSEBatch& operator=(const PSEBatch& rhs) = delete;
+
+    /// array of tonalities copied in all the jobs.
+    inline const TonIndex& index() const { return *_index; }
+
+    /// cache shared by the jobs, or null if they do not share a cache.
+    inline std::shared_ptr<const PSBMemo> memo() const { return _memo; }
+
+    /// spell concurrently all the given parts.
+    /// @param parts notes of each part.
+    /// @return the spelling of each part, in the same order as parts.
+    /// this function does not depend on the scheduling of the jobs.
+    std::vector<PSESpelling> spell(const std::vector<PSENotes>& parts) const;
+
+    /// spell one part, in the calling thread.
+    /// @param part notes of the part.
+    /// @param res spelling of the part. its status is false if the part
+    /// is not valid.
+    /// @see check
+    void spell(const PSENotes& part, PSESpelling& res) const;
+
+    /// check the notes of a part, as PSRawEnum::set: the lists have the
+    /// same length, the MIDI keys are valid, and the bar numbers are
+    /// positive and not decreasing.
+    /// @param part notes of the part.
+    /// @param msg description of the first error found, if any.
+    /// @return whether the part is valid.
+    static bool check(const PSENotes& part, std::string& msg);
+
+private:
+
+    /// array of tonalities copied in all the jobs. closed.
+    /// it is never modified.
+    std::unique_ptr<const TonIndex> _index;
+
+    /// type of cost for the first table.
+    const CostType _ct0;
+
+    /// type of cost for the second table.
+    const CostType _ct1;
+
+    /// number of threads.
+    const size_t _threads;
+
+    /// workers, kept from one batch of parts to the next.
+    std::unique_ptr<PSPool> _pool;
+
+    /// cache of results of bag searches shared by the jobs, or null.
+    std::shared_ptr<PSBMemo> _memo;
+
+};
+
+
+} // namespace pse
+
+#endif /* PSEBatch_hpp */
+
+/// @}
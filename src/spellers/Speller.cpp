@@ -45,7 +45,11 @@ _algo(algo),
 _enum(e),
 _enum_aux(e_aux),
 _table(nullptr),
-_grid(nullptr)
+_grid(nullptr),
+_memo(std::make_shared<PSBMemo>(PSBMemo::CAPACITY)),
+_automata(),    // null
+_astar(false),
+_pool()         // null
 {
     assert(e);
 }
@@ -58,7 +62,11 @@ _algo(algo),
 _enum(e),
 _enum_aux(e_aux),
 _table(nullptr),
-_grid(nullptr)
+_grid(nullptr),
+_memo(std::make_shared<PSBMemo>(PSBMemo::CAPACITY)),
+_automata(),    // null
+_astar(false),
+_pool()         // null
 {
     assert(e);
 }
@@ -152,7 +160,7 @@ bool Speller::setAuxEnumerator(PSEnum* aux)
 //
 
 bool Speller::evalTable(CostType ctype, bool tonal, bool octave, 
-                        bool chromatic, bool aux)
+                        bool chromatic, bool aux, size_t threads, double prune)
 {
     TRACE("Speller: eval table with {}, unlead={}, det={}, {} enumerator",
           ctype, tonal, chromatic, (aux?"auxiliary":"main"));
@@ -181,13 +189,14 @@ bool Speller::evalTable(CostType ctype, bool tonal, bool octave,
     std::unique_ptr<Cost> seed = unique_zero(ctype); // was sampleCost(ctype)
     assert(seed);
     _table = new PST(algo, *seed, index(), enumerator(aux),
-                     tonal, octave, _debug);
+                     tonal, octave, _debug, threads, _memo.get(),
+                     _automata.get(), _astar, prune, false, pool(threads));
     return true;
 }
 
 
 bool Speller::revalTable(CostType ctype, bool tonal, bool octave,
-                         bool chromatic, bool aux)
+                         bool chromatic, bool aux, size_t threads)
 {
     TRACE("Speller: reval table with {}, unlead={}, det={}, {} enumerator",
           ctype, tonal, chromatic, (aux?"auxiliary":"main"));
@@ -224,15 +233,17 @@ bool Speller::revalTable(CostType ctype, bool tonal, bool octave,
     assert(seed);
     _table = new PST(algo, // *table_pre,
                      *seed, index(), enumerator(aux), *_grid,
-                     tonal, octave, _debug);
+                     tonal, octave, _debug, threads, _memo.get(),
+                     _automata.get(), _astar, pool(threads));
     //assert(table_pre);
     //delete table_pre;
     return true;
 }
 
 
-bool Speller::evalGrid(const GridAlgo& algo)
+bool Speller::evalGrid(const GridAlgo& algo, size_t k)
 {
+    assert(k > 0);
     if (_grid)
     {
         WARN("Speller evalGrid: deleting current grid");
@@ -248,18 +259,29 @@ bool Speller::evalGrid(const GridAlgo& algo)
     assert(_index);
     //std::vector<bool> mask(_index->size(), true); // all true by default
 
+    // the grids use the ranks of all the cells in columns
+    if (! _table->exact())
+    {
+        TRACE("Speller evalGrid: complete the pruned rows of table");
+        _table->complete();
+    }
+
     switch (algo)
     {
         case GridAlgo::Best:
+            if (k > 1)
+                WARN("Speller evalGrid: k best paths only for exhaustive grid");
             _grid = new PSGy(*_table);
             break;
 
         case GridAlgo::Rank:
+            if (k > 1)
+                WARN("Speller evalGrid: k best paths only for exhaustive grid");
             _grid = new PSGr(*_table);
             break;
 
         case GridAlgo::Exhaustive:
-            _grid = new PSGx(*_table);
+            _grid = new PSGx(*_table, false, k);
             break;
 
         default:
@@ -288,6 +310,12 @@ size_t Speller::selectGlobals(double d, bool refine)
     //     _table->print(std::cout);
     // }
     assert(_index);
+    if (d > _table->threshold())
+    {
+        WARN("Speller selectGlobals: distance {} larger than pruning {}",
+             d, _table->threshold());
+        _table->complete();
+    }
     return _index->selectGlobals(*_table, d, refine);
 }
 
@@ -354,6 +382,36 @@ void Speller::resetGrid()
 }
 
 
+void Speller::setMemo(std::shared_ptr<PSBMemo> memo)
+{
+    _memo = memo;
+}
+
+
+void Speller::setAutomata(std::shared_ptr<PSAutomata> automata)
+{
+    _automata = automata;
+}
+
+
+void Speller::setAstar(bool flag)
+{
+    _astar = flag;
+}
+
+
+PSPool* Speller::pool(size_t threads)
+{
+    if (threads == 0)
+        threads = PSPool::hardware();
+    if (threads == 1)
+        return nullptr;
+    if (_pool == nullptr or _pool->threads() != threads)
+        _pool.reset(new PSPool(threads));
+    return _pool.get();
+}
+
+
 //
 // results feedback
 //
@@ -411,6 +469,28 @@ bool Speller::printed(size_t i, bool aux) const
 }
 
 
+size_t Speller::exportNotes(int* names, int* accids, int* octaves,
+                            bool* prints, bool aux) const
+{
+    assert(names);
+    assert(accids);
+    assert(octaves);
+    assert(prints);
+    assert(not aux or hasAuxEnumerator());
+    const PSEnum& e(enumerator(aux));
+    size_t n = e.size();
+    size_t i0 = e.first();
+    for (size_t k = 0; k < n; ++k)
+    {
+        names[k] = static_cast<int>(e.name(i0+k));
+        accids[k] = static_cast<int>(e.accidental(i0+k));
+        octaves[k] = e.octave(i0+k);
+        prints[k] = e.printed(i0+k);
+    }
+    return n;
+}
+
+
 bool Speller::locals() const
 {
     return (_grid != nullptr);
@@ -441,6 +521,78 @@ size_t Speller::ilocal(size_t i, size_t j) const
 }
 
 
+size_t Speller::gridRows() const
+{
+    return (_grid == nullptr)?0:_grid->nbTons();
+}
+
+
+size_t Speller::gridColumns() const
+{
+    return (_grid == nullptr)?0:_grid->measures();
+}
+
+
+bool Speller::exportGrid(size_t* ilocals) const
+{
+    assert(ilocals);
+    if (_grid == nullptr)
+    {
+        ERROR("Speller exportGrid: eval grid first");
+        return false;
+    }
+    size_t rows = _grid->nbTons();
+    size_t cols = _grid->measures();
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j)
+            ilocals[i*cols+j] = _grid->ilocal(i, j);
+    return true;
+}
+
+
+size_t Speller::gridPaths(size_t i) const
+{
+    const PSGx* grid = dynamic_cast<const PSGx*>(_grid);
+    if (grid == nullptr)
+    {
+        ERROR("Speller gridPaths: eval exhaustive grid first");
+        return 0;
+    }
+    else if (i >= grid->nbTons())
+    {
+        ERROR("Speller gridPaths: no ton of index {}", i);
+        return 0;
+    }
+    return grid->paths(i);
+}
+
+
+std::vector<size_t> Speller::gridPath(size_t i, size_t r) const
+{
+    if (r >= gridPaths(i))
+    {
+        ERROR("Speller gridPath: no path of rank {} for ton {}", r, i);
+        return std::vector<size_t>();
+    }
+    const PSGx* grid = dynamic_cast<const PSGx*>(_grid);
+    assert(grid);
+    return grid->path(i, r);
+}
+
+
+size_t Speller::gridPathCost(size_t i, size_t r) const
+{
+    if (r >= gridPaths(i))
+    {
+        ERROR("Speller gridPathCost: no path of rank {} for ton {}", r, i);
+        return 0;
+    }
+    const PSGx* grid = dynamic_cast<const PSGx*>(_grid);
+    assert(grid);
+    return grid->pathCost(i, r);
+}
+
+
 const Ton& Speller::local(size_t i, size_t j) const
 {
     size_t it = ilocal(i, j);
@@ -19,6 +19,9 @@
 #include "Spelli.hpp"
 #include "PSTable.hpp"
 #include "PSGrid.hpp"
+#include "PSBMemo.hpp"
+#include "PSAutomaton.hpp"
+#include "PSPool.hpp"
 
 
 // TODO
@@ -136,14 +139,22 @@ public: // spelling : computation of tables and grid
     /// are deterministic or exhaustive.
     /// @param aux wether we use the auxilliary enumerator for the evaluation.
     /// in that case it must be set.
+    /// @param threads number of threads for the computation of the table.
+    /// 0 for the number of hardware threads available.
+    /// @param prune distance threshold (in percent) for the pruned mode
+    /// of the table, 100 for no pruning. The rows too far from the best row
+    /// are not completed, they are completed on demand by evalGrid, rename,
+    /// and selectGlobals with a larger distance.
     /// @return whether computation was succesfull.
     /// @warning if the table exists it is overwritten.
     /// @see sampleCost
     /// @see PSState for the construction of the initial state
     /// and tonal/modal flag.
+    /// @see PST::exact
     bool evalTable(CostType ctype,
                    bool tonal=true, bool octave=false,
-                   bool chromatic=false, bool aux=false);
+                   bool chromatic=false, bool aux=false,
+                   size_t threads=1, double prune=100);
     
     /// construct a second spelling table, using
     /// - a first spelling table (use the same index)
@@ -158,6 +169,8 @@ public: // spelling : computation of tables and grid
     /// are deterministic.
     /// @param aux wether we use the auxilliary enumerator for the evaluation.
     /// in that case it must be set.
+    /// @param threads number of threads for the computation of the table.
+    /// 0 for the number of hardware threads available.
     /// @return whether computation was succesfull.
     /// @warning the first spelling table must have been constructed.
     /// @warning the first spelling table is deleted.
@@ -165,7 +178,8 @@ public: // spelling : computation of tables and grid
     /// and tonal/modal flag
     bool revalTable(CostType ctype,
                     bool tonal=true, bool octave=false,
-                    bool chromatic=false, bool aux=false);
+                    bool chromatic=false, bool aux=false,
+                    size_t threads=1);
     
     /// construct the grid of local tons
     /// (1 ton for each initial ton and measure) using
@@ -175,8 +189,11 @@ public: // spelling : computation of tables and grid
     /// @param algo algorithm for the computation of the grid.
     /// possible values are GridAlgo::Best, GridAlgo::Rank,
     /// GridAlgo::Exhaustive.
+    /// @param k number of best paths computed for every row of the grid,
+    /// with GridAlgo::Exhaustive only. must be strictly positive.
     /// @return whether computation was succesfull.
-    bool evalGrid(const GridAlgo& algo = GridAlgo::Rank);
+    /// @see gridPaths()
+    bool evalGrid(const GridAlgo& algo = GridAlgo::Rank, size_t k = 1);
     
     /// compute the subarray of tons selected as candidate global tonality,
     /// using the evaluated table.
@@ -220,6 +237,39 @@ public: // spelling : computation of tables and grid
 
     /// clear the current grid.
     void resetGrid();
+
+    /// set the cache of results of bag searches used for the construction
+    /// of the tables of this speller. A cache can be shared by several
+    /// spellers, e.g. for the parts of a score.
+    /// @param memo a cache, or null for no caching.
+    void setMemo(std::shared_ptr<PSBMemo> memo);
+
+    /// cache of results of bag searches used by this speller,
+    /// or null if there is none.
+    /// by default, each speller has its own cache,
+    /// of capacity PSBMemo::CAPACITY.
+    inline std::shared_ptr<PSBMemo> memo() const { return _memo; }
+
+    /// set the spelling automata used for the transitions of the bag
+    /// searches of the tables of this speller. They are built lazily
+    /// and kept from one table to the next, until their bound on the
+    /// number of states is reached.
+    /// @param automata a collection of automata, or null for computing
+    /// the transitions during the searches.
+    void setAutomata(std::shared_ptr<PSAutomata> automata);
+
+    /// spelling automata used by this speller, or null if there are none.
+    /// by default, a speller has no automata.
+    inline std::shared_ptr<PSAutomata> automata() const { return _automata; }
+
+    /// set the A* mode for the bag searches of the tables of this speller:
+    /// the searches are guided by a lower bound of the cost of the remaining
+    /// notes of the bar. The results are the same in both modes.
+    /// @param flag A* mode. default is false.
+    void setAstar(bool flag);
+
+    /// A* mode for the bag searches.
+    inline bool astar() const { return _astar; }
     
 public: // results feedback : notes
     
@@ -256,6 +306,24 @@ public: // results feedback : notes
     /// in that case it must be set.
     bool printed(size_t i, bool aux=false) const;
 
+    /// copy the estimated spelling of all the notes of the enumerator
+    /// into the given arrays, in one call.
+    /// @param names array of length at least size(aux), filled with the codes
+    /// of estimated note names (value of enum NoteName, 0 is 'C', 6 is 'B').
+    /// @param accids array of length at least size(aux), filled with the codes
+    /// of estimated accidentals (value of enum Accid).
+    /// @param octaves array of length at least size(aux), filled with the
+    /// estimated octaves.
+    /// @param prints array of length at least size(aux), filled with the
+    /// estimated print flags.
+    /// @param aux wether we consider the auxilliary enumerator.
+    /// in that case it must be set.
+    /// @return the number of notes copied, i.e. size(aux).
+    /// @warning the arrays are indexed from 0, the note at index i is
+    /// the note of index first()+i in the enumerator.
+    size_t exportNotes(int* names, int* accids, int* octaves, bool* prints,
+                       bool aux=false) const;
+
 public: // results feedback : grid
 
     /// the grid of local tonalities has been computed.
@@ -293,6 +361,43 @@ public: // results feedback : grid
     /// @warning evalGrid() must have been called.
     virtual const Ton& localNote(size_t i, size_t j) const;
 
+    /// number of rows of the grid of local tonalities, i.e. number of
+    /// assumed global tonalities, or 0 if the grid was not computed.
+    size_t gridRows() const;
+
+    /// number of columns of the grid of local tonalities, i.e. number of
+    /// measures, or 0 if the grid was not computed.
+    size_t gridColumns() const;
+
+    /// copy all the indices of estimated local tonalities of the grid
+    /// into the given array, in one call.
+    /// @param ilocals array of length at least gridRows() * gridColumns(),
+    /// filled row by row, i.e. with ilocal(i, j) at i * gridColumns() + j.
+    /// @return whether the grid has been computed and was copied.
+    /// @see ilocal() for the values copied.
+    bool exportGrid(size_t* ilocals) const;
+
+    /// number of best paths computed for one row of the grid.
+    /// @param i index in the TonIndex of an assumed global tonality.
+    /// @return at most the k given to evalGrid(), 0 if the grid was not
+    /// computed with GridAlgo::Exhaustive, or if its computation failed
+    /// for the row i.
+    size_t gridPaths(size_t i) const;
+
+    /// one of the best paths computed for one row of the grid.
+    /// @param i index in the TonIndex of an assumed global tonality.
+    /// @param r rank of the path, must be smaller than gridPaths(i).
+    /// @return the index of local ton for every measure. The path of rank 0
+    /// is the row i of the grid. Empty in case of error.
+    std::vector<size_t> gridPath(size_t i, size_t r) const;
+
+    /// cost of one of the best paths computed for one row of the grid.
+    /// @param i index in the TonIndex of an assumed global tonality.
+    /// @param r rank of the path, must be smaller than gridPaths(i).
+    /// @return the cost of the path of rank r, increasing with r,
+    /// or 0 in case of error.
+    size_t gridPathCost(size_t i, size_t r) const;
+
 public: // debug
     
     void printGrid(std::ostream& o) const;
@@ -343,6 +448,27 @@ protected: // data
     
     /// grid of local tons: 1 ton for each candidate initial ton and measure.
     PSG* _grid; // std::shared_ptr<PSG>
+
+    /// cache of results of bag searches shared by the tables,
+    /// for repeated bars. null for no caching.
+    std::shared_ptr<PSBMemo> _memo;
+
+    /// spelling automata shared by the tables.
+    /// null for computing the transitions during the searches.
+    std::shared_ptr<PSAutomata> _automata;
+
+    /// A* mode for the bag searches.
+    bool _astar;
+
+    /// workers for the computation of the tables, kept from one table
+    /// to the next. null if no table was computed with several threads.
+    std::unique_ptr<PSPool> _pool;
+
+    /// workers for the computation of a table with the given number
+    /// of threads, started the first time or when the number changes.
+    /// @param threads number of threads, 0 for hardware threads available.
+    /// @return null for 1 thread (sequential computation).
+    PSPool* pool(size_t threads);
     
     // sub-array of tons selected as candidate global tonality.
     // contains a ton index.
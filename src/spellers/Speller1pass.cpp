@@ -7,6 +7,7 @@
 
 #include "Speller1pass.hpp"
 #include "PSGridr.hpp"
+#include "PSGridx.hpp"
 
 namespace pse {
 
@@ -15,7 +16,21 @@ SpellerEnum(nbTons, false, algo, dflag), // no aux enum
 _table0(nullptr),
 _global0(nullptr),
 _time_table0(0),
-_time_grid(0)
+_time_grid(0),
+_streamed(0),
+_streamglobal(TonIndex::UNDEF)
+{ }
+
+
+Speller1Pass::Speller1Pass(std::shared_ptr<TonIndex> id,
+                           const Algo& algo, bool dflag):
+SpellerEnum(id, false, algo, dflag), // no aux enum
+_table0(nullptr),
+_global0(nullptr),
+_time_table0(0),
+_time_grid(0),
+_streamed(0),
+_streamglobal(TonIndex::UNDEF)
 { }
 
 
@@ -173,8 +188,13 @@ bool Speller1Pass::spell(const Cost& seed0, double diff0,
     
     clock_t time_start = clock();
     assert(_enum);
-    _table0 = new PST(_algo, seed0, index(), *_enum, false, _debug); // modal mode
+    // cost-only: only the row costs and ranks are needed for the globals
+    // and the grid, the best paths are searched again for renaming.
+    _table0 = new PST(_algo, seed0, index(), *_enum, false, _debug, // modal mode
+                      false, 1, _memo.get(), _automata.get(), _astar,
+                      100, true);
     _time_table0 = duration(time_start);
+    rawenum().clean(); // all the bars are spelled
     TRACE("pitch-spelling: {} bars", _table0->size());
     if (_debug)
     {
@@ -215,6 +235,10 @@ bool Speller1Pass::spell(const Cost& seed0, double diff0,
     //_grid = new PSG(*_table0, _global0->getMask()); // std::unique_ptr<PSG>
     _grid = new PSGr(*_table0); // std::unique_ptr<PSG>
     _time_grid = duration(time_start);
+    // the rows of the grid are the current global tons
+    _spellglobals.assign(nbTons(), false);
+    for (size_t i = 0; i < nbTons(); ++i)
+        _spellglobals[i] = index().isGlobal(i);
     if (_debug)
     {
         DEBUGU("time to build grid of local tonalities: {}ms", (int)_time_grid);
@@ -265,6 +289,192 @@ bool Speller1Pass::spell(const Cost& seed0, double diff0,
 }
 
 
+size_t Speller1Pass::stream(const Cost& seed0, size_t lag, double diff0,
+                            bool last, bool rename_flag)
+{
+    assert(_enum);
+    assert(lag > 0);
+    assert(diff0 >= 0);
+    PSGx* grid = nullptr;
+    if (_grid != nullptr)
+    {
+        grid = dynamic_cast<PSGx*>(_grid);
+        if (grid == nullptr or grid->lag() == 0)
+        {
+            ERROR("Speller1Pass stream: not in streaming mode, call restart");
+            return 0;
+        }
+    }
+    if (_enum->empty())
+    {
+        TRACE("pitch-spelling stream: no notes");
+        return 0;
+    }
+
+    clock_t time_start = clock();
+    if (_table0 == nullptr)
+    {
+        TRACE("pitch-spelling stream: building first pitch-spelling table");
+        // same arguments as in spell
+        _table0 = new PST(_algo, seed0, index(), *_enum, false, _debug,
+                          false, 1, _memo.get(), _automata.get(), _astar,
+                          100, true); // modal, cost-only
+    }
+    else
+    {
+        size_t n = _table0->extend();
+        TRACE("pitch-spelling stream: {} bars added to first table", n);
+    }
+    _time_table0 += duration(time_start);
+
+    time_start = clock();
+    // number of bars fixed before this call
+    const size_t n0 = (grid == nullptr)?0:grid->size();
+    // the rows of the online grid are the global tons at its construction
+    if (grid != nullptr and grid->outdated())
+    {
+        WARN("pitch-spelling stream: global tonalities changed, rebuild grid");
+        resetGrid();
+        grid = nullptr;
+        // the local tonalities of the bars spelled can change
+        _streamglobal = TonIndex::UNDEF;
+    }
+    if (grid == nullptr)
+    {
+        TRACE("pitch-spelling stream: building online grid, lag {}", lag);
+        grid = new PSGx(*_table0, false, 1, lag);
+        _grid = grid;
+        if (last)
+            grid->extend(*_table0, true);
+    }
+    else
+    {
+        grid->extend(*_table0, last);
+    }
+    // same table and lag: a rebuilt grid has at least the bars fixed before
+    assert(n0 <= grid->size());
+    size_t fixed = grid->size() - n0;
+    _time_grid += duration(time_start);
+    TRACE("pitch-spelling stream: local tonalities fixed for {} bars", fixed);
+
+    // global tonality candidates for the notes added so far
+    if (_global0 != nullptr)
+        delete _global0;
+    _global0 = new PSO(*_table0, diff0, _debug);
+    _global0->completeEnharmonics();
+
+    if (rename_flag and grid->size() > 0)
+    {
+        size_t ig = iglobalCand(0, _global0);
+        if (ig == TonIndex::UNDEF)
+        {
+            ERROR("Pitch Spelling: renaming fail: no estimated global tonality");
+            return fixed;
+        }
+        assert(ig < nbTons());
+        // the bars already spelled are renamed again with the new global
+        if (ig != _streamglobal)
+        {
+            TRACE("pitch-spelling stream: global tonality changed, rename {} bars",
+                  _streamed);
+            _streamglobal = ig;
+            _streamed = 0;
+        }
+        for (; _streamed < grid->size(); ++_streamed)
+            _table0->rename(_streamed, ig);
+    }
+    return fixed;
+}
+
+
+bool Speller1Pass::respell(std::set<size_t>& bars, double diff0)
+{
+    if (_table0 == nullptr or _grid == nullptr)
+    {
+        ERROR("Speller1Pass respell: call spell() first");
+        return false;
+    }
+    PSGr* grid = dynamic_cast<PSGr*>(_grid);
+    if (grid == nullptr)
+    {
+        ERROR("Speller1Pass respell: no rank grid (streaming mode), call spell()");
+        return false;
+    }
+    // the rows of the grid that are not computed cannot be updated
+    assert(_spellglobals.size() == nbTons());
+    for (size_t i = 0; i < nbTons(); ++i)
+    {
+        if (index().isGlobal(i) != _spellglobals[i])
+        {
+            WARN("Speller1Pass respell: global tonalities changed, call spell()");
+            return false;
+        }
+    }
+    assert(diff0 >= 0);
+    
+    clock_t time_start = clock();
+    for (size_t j : bars)
+    {
+        assert(j < _table0->size());
+        // the spellings estimated by rename are not constraints
+        const PSV& col = _table0->column(j);
+        rawenum().resetSpellings(col.first(), col.stop());
+        _table0->recompute(j);
+    }
+    _time_table0 = duration(time_start);
+    TRACE("pitch-spelling respell: {} bars recomputed in first table",
+          bars.size());
+
+    // global tonality candidates, from the updated row costs
+    if (_global0 != nullptr)
+        delete _global0;
+    _global0 = new PSO(*_table0, diff0, _debug);
+    _global0->completeEnharmonics();
+
+    // grid of local tonalities, from the first modified bar
+    time_start = clock();
+    std::set<size_t> changed;
+    grid->update(*_table0, bars, changed);
+    _time_grid = duration(time_start);
+    TRACE("pitch-spelling respell: local tonalities changed in {} bars",
+          changed.size());
+    bars.insert(changed.cbegin(), changed.cend());
+    return true;
+}
+
+
+size_t Speller1Pass::spelled() const
+{
+    if (_streamed == 0)
+        return 0;
+    assert(_table0);
+    assert(_enum);
+    assert(_streamed <= _table0->size());
+    return _table0->column(_streamed-1).stop() - _enum->first();
+}
+
+
+void Speller1Pass::restart()
+{
+    TRACE("Speller1Pass: restart streaming");
+    if (_table0)
+    {
+        delete _table0;
+        _table0 = nullptr;
+    }
+    if (_global0)
+    {
+        delete _global0;
+        _global0 = nullptr;
+    }
+    resetGrid();
+    _time_table0 = 0;
+    _time_grid = 0;
+    _streamed = 0;
+    _streamglobal = TonIndex::UNDEF;
+}
+
+
 bool Speller1Pass::rename(PST* table, const PSO* globals, size_t n)
 {
     assert(table);
@@ -16,6 +16,7 @@
 #include <assert.h>
 #include <memory>
 #include <time.h>
+#include <set>
 
 #include "pstrace.hpp"
 #include "PSTable.hpp"
@@ -38,6 +39,15 @@ public:
     Speller1Pass(size_t nbTons=0,
                  const Algo& algo=Algo::Undef, // TBR
                  bool dflag=true);
+
+    /// constructor with a given array of tonalities.
+    /// initially empty list of notes to spell.
+    /// @param id a Ton Index. must be closed.
+    /// the global tonalities selected by spelling are stored in it.
+    /// @param dflag debug mode.
+    Speller1Pass(std::shared_ptr<TonIndex> id,
+                 const Algo& algo=Algo::Undef, // TBR
+                 bool dflag=true);
     
     /// destructor
     virtual ~Speller1Pass();
@@ -94,6 +104,14 @@ public:
     /// It is ton(iglobal(n)) or an undef ton in case of error.
     /// @warning spell() must have been called.
     const Ton& global(size_t n=0) const override;
+
+    /// number of input notes spelled in streaming mode.
+    /// they are the notes of index smaller than first() + spelled().
+    size_t spelled() const;
+
+    /// restart the streaming from the first input note.
+    /// the tables, lists of global candidates and grid are deleted.
+    virtual void restart();
     
 protected: // data
     
@@ -115,6 +133,17 @@ protected: // data
     /// Time to build the grid of local tonalities
     double _time_grid;
 
+    /// number of bars spelled in streaming mode.
+    size_t _streamed;
+
+    /// index of the global tonality used for renaming the bars spelled
+    /// in streaming mode, TonIndex::UNDEF if none.
+    size_t _streamglobal;
+
+    /// global flags of the index when spell() was called. The rows of the
+    /// grid, and of the second table, are computed for these global tons.
+    std::vector<bool> _spellglobals;
+
 protected:
     
     // estimated local tonality for one candidate global tonality and one bar.
@@ -145,6 +174,52 @@ protected:
     /// @return whether computation was succesfull.
     bool spell(const Cost& seed0, double diff0=0,
                bool rename_flag=false, bool rewrite_flag=false);
+
+    /// streaming mode: update the first table, the global tonality
+    /// candidates and the grid of local tonalities with the notes added
+    /// to the enumerator since the last call. The table is extended with
+    /// the new bars, the grid is extended by a fixed-lag Viterbi, and the
+    /// local tonalities of a bar are fixed when the lag next bars are
+    /// complete. The time of one call does not depend on the number of
+    /// bars already spelled, unless the bars renamed must be renamed again.
+    /// @param seed0 seed cost used to built the PS table.
+    /// @param lag number of complete bars of lookahead for fixing the local
+    /// tonalities of a bar. must be strictly positive.
+    /// @param diff0 approximation coeff (percent) to estimate the global
+    /// ton(s) of the notes added so far.
+    /// @param last whether all the notes have been added.
+    /// In this case, the local tonalities of all the bars are fixed.
+    /// @param rename_flag whether the notes of the bars fixed by this call
+    /// must be renamed, according to the current estimated global tonality.
+    /// When this estimation changes, the bars renamed by the previous calls
+    /// are renamed again, with the new estimated global tonality.
+    /// @return the number of bars whose local tonalities were fixed by
+    /// this call.
+    /// @warning the grid is an online grid, different from the one of
+    /// spell(). restart() must be called before streaming after spell().
+    /// If the global flags of the index are changed between two calls,
+    /// the online grid is rebuilt for the new global tonalities.
+    size_t stream(const Cost& seed0, size_t lag, double diff0=0,
+                  bool last=false, bool rename_flag=false);
+    
+    /// re-spelling: update the first table, the global tonality candidates
+    /// and the grid of local tonalities computed by spell(), after the
+    /// modification of notes in the given bars.
+    /// Only the columns of the modified bars are recomputed in the table,
+    /// with an update of the row costs, and the grid is recomputed
+    /// from the first modified bar, in the rows where it changes.
+    /// @param bars numbers of the modified bars. it is completed with the
+    /// numbers of the bars whose local tonalities were changed in the grid.
+    /// @param diff0 approximation coeff (percent) to estimate the global ton(s).
+    /// must be the one given to spell().
+    /// @return whether the update was succesfull.
+    /// If not, spell() must be called. It fails when the global flags of
+    /// the index have changed since spell().
+    /// @warning the bounds of the bars must not have changed since spell():
+    /// notes can be replaced with PSRawEnum::modify(), but not inserted
+    /// or deleted.
+    /// @see PSRawEnum::modify()
+    bool respell(std::set<size_t>& bars, double diff0);
     
     /// rename all notes read by this speller,
     /// according to a given global tonality.
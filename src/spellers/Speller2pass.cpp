@@ -8,6 +8,7 @@
 /// @{
 
 #include "Speller2pass.hpp"
+#include "PSGridx.hpp"
 
 namespace pse {
 
@@ -15,7 +16,17 @@ namespace pse {
 Speller2Pass::Speller2Pass(size_t nbTons, const Algo& algo, bool dflag):
 Speller1Pass(nbTons, algo, dflag),
 _table1(nullptr),
-_global1(nullptr)
+_global1(nullptr),
+_time_table1(0)
+{ }
+
+
+Speller2Pass::Speller2Pass(std::shared_ptr<TonIndex> id,
+                           const Algo& algo, bool dflag):
+Speller1Pass(id, algo, dflag),
+_table1(nullptr),
+_global1(nullptr),
+_time_table1(0)
 { }
 
 
@@ -93,7 +104,8 @@ bool Speller2Pass::spell(const Cost& seed0, const Cost& seed1,
     
     clock_t time_start = clock();
     assert(_enum);                                                         // tonal mode
-    _table1 = new PST(_algo, seed1, index(), *_enum, *_grid, true, _debug);
+    _table1 = new PST(_algo, seed1, index(), *_enum, *_grid, true, _debug,
+                      false, 1, _memo.get(), _automata.get(), _astar);
     _time_table1 = duration(time_start);
     if (_debug)
     {
@@ -159,6 +171,124 @@ bool Speller2Pass::spell(const Cost& seed0, const Cost& seed1,
 }
 
 
+size_t Speller2Pass::stream(const Cost& seed0, const Cost& seed1, size_t lag,
+                            double diff0, double diff1,
+                            bool last, bool rename_flag1)
+{
+    // the rows of the second table are the global tons of the online grid,
+    // it is rebuilt with the grid when they change.
+    const PSGx* grid = dynamic_cast<const PSGx*>(_grid);
+    if (_table1 != nullptr and grid != nullptr and grid->lag() > 0 and
+        grid->outdated())
+    {
+        delete _table1;
+        _table1 = nullptr;
+    }
+    // first table and grid, no renaming
+    Speller1Pass::stream(seed0, lag, diff0, last, false);
+    if (_grid == nullptr or _grid->empty())
+        return 0;
+    assert(_table0);
+    assert(_global0);
+
+    clock_t time_start = clock();
+    size_t n = 0;
+    if (_table1 == nullptr)
+    {
+        TRACE("pitch-spelling stream: building second pitch-spelling table");
+        // same arguments as in spell
+        _table1 = new PST(_algo, seed1, index(), *_enum, *_grid, true, _debug,
+                          false, 1, _memo.get(), _automata.get(), _astar);
+        n = _table1->size();
+    }
+    else
+    {
+        n = _table1->extend(*_grid);
+    }
+    _time_table1 += duration(time_start);
+    assert(_table1->size() == _grid->size());
+    TRACE("pitch-spelling stream: {} bars added to second table", n);
+
+    if (_global1 != nullptr)
+        delete _global1;
+    _global1 = new PSO(*_global0, *_table1, diff1, _debug);
+
+    if (rename_flag1 and _table1->size() > 0)
+    {
+        size_t ig = iglobal(0);
+        if (ig == TonIndex::UNDEF)
+        {
+            assert(_enum);
+            ERROR("Speller: failure with spelling table {}-{}",
+                  _enum->first(), _enum->stop());
+            return n;
+        }
+        assert(ig < nbTons());
+        // the bars already spelled are renamed again with the new global
+        if (ig != _streamglobal)
+        {
+            TRACE("pitch-spelling stream: global tonality changed, rename {} bars",
+                  _streamed);
+            _streamglobal = ig;
+            _streamed = 0;
+        }
+        for (; _streamed < _table1->size(); ++_streamed)
+            _table1->column(_streamed).rename(ig);
+    }
+    return n;
+}
+
+
+bool Speller2Pass::respell(std::set<size_t>& bars, double diff0, double diff1)
+{
+    if (_table1 == nullptr)
+    {
+        ERROR("Speller2Pass respell: call spell() first");
+        return false;
+    }
+    // first table and grid
+    if (! Speller1Pass::respell(bars, diff0))
+        return false;
+    assert(_grid);
+    assert(_global0);
+    assert(_table1->size() == _grid->size());
+
+    clock_t time_start = clock();
+    for (size_t j : bars)
+    {
+        // the spellings estimated by rename are not constraints
+        const PSV& col = _table1->column(j);
+        rawenum().resetSpellings(col.first(), col.stop());
+        _table1->recompute(j, *_grid);
+    }
+    _time_table1 = duration(time_start);
+    TRACE("pitch-spelling respell: {} bars recomputed in second table",
+          bars.size());
+
+    if (_global1 != nullptr)
+        delete _global1;
+    _global1 = new PSO(*_global0, *_table1, diff1, _debug);
+    return true;
+}
+
+
+void Speller2Pass::restart()
+{
+    Speller1Pass::restart();
+    if (_table1)
+    {
+        delete _table1;
+        _table1 = nullptr;
+    }
+    if (_global1)
+    {
+        delete _global1;
+        _global1 = nullptr;
+    }
+    _time_table1 = 0;
+}
+
+
 bool Speller2Pass::rename(size_t n)
 {
     return Speller1Pass::rename(_table1, _global1, n);
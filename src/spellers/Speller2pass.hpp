@@ -31,6 +31,15 @@ public:
     Speller2Pass( size_t nbTons=0,
                  const Algo& algo=Algo::Undef, // TBR
                  bool dflag=true);
+
+    /// constructor with a given array of tonalities.
+    /// initially empty list of notes to spell.
+    /// @param id a Ton Index. must be closed.
+    /// the global tonalities selected by spelling are stored in it.
+    /// @param dflag debug mode.
+    Speller2Pass(std::shared_ptr<TonIndex> id,
+                 const Algo& algo=Algo::Undef, // TBR
+                 bool dflag=true);
     
     /// destructor
     virtual ~Speller2Pass();
@@ -87,6 +96,10 @@ public:
     /// or TonIndex::UNDEF in case of error.
     /// @warning spell() must have been called.
     size_t iglobal0(size_t n=0) const;
+
+    /// restart the streaming from the first input note.
+    /// the tables, lists of global candidates and grid are deleted.
+    void restart() override;
     
 protected: // data
     
@@ -121,6 +134,45 @@ protected:
                bool rename_flag1=false,
                bool rewrite_flag1=false);
 
+    /// streaming mode: update the two tables, the global tonality
+    /// candidates and the grid of local tonalities with the notes added
+    /// to the enumerator since the last call.
+    /// The second table is extended with the bars whose local tonalities
+    /// have been fixed in the grid.
+    /// @param seed0 seed cost used to built the first PS table
+    /// @param seed1 seed cost used to built the second PS table
+    /// @param lag number of complete bars of lookahead for fixing the local
+    /// tonalities of a bar. must be strictly positive.
+    /// @param diff0 approximation coeff (percent) for the first estimatation
+    /// of global ton(s).
+    /// @param diff1 approximation coeff (percent) for the second estimatation
+    /// of global ton(s).
+    /// @param last whether all the notes have been added.
+    /// @param rename_flag1 whether the notes of the bars added to the second
+    /// table must be renamed, according to the current estimated global
+    /// tonality.
+    /// @return the number of bars added to the second table by this call.
+    /// @see Speller1Pass::stream
+    size_t stream(const Cost& seed0, const Cost& seed1, size_t lag,
+                  double diff0=0, double diff1=0,
+                  bool last=false, bool rename_flag1=false);
+
+    /// re-spelling: update the two tables, the global tonality candidates
+    /// and the grid of local tonalities computed by spell(), after the
+    /// modification of notes in the given bars.
+    /// The columns of the second table are recomputed for the modified bars
+    /// and for the bars whose local tonalities were changed in the grid.
+    /// @param bars numbers of the modified bars. it is completed with the
+    /// numbers of the bars whose local tonalities were changed in the grid.
+    /// @param diff0 approximation coeff (percent) for the first estimatation
+    /// of global ton(s). must be the one given to spell().
+    /// @param diff1 approximation coeff (percent) for the second estimatation
+    /// of global ton(s). must be the one given to spell().
+    /// @return whether the update was succesfull.
+    /// If not, spell() must be called.
+    /// @see Speller1Pass::respell
+    bool respell(std::set<size_t>& bars, double diff0, double diff1);
+
 };
 
 
@@ -17,6 +17,13 @@ Speller(new PSRawEnum(0, 0), (aux_enum?new PSRawEnum(0, 0):nullptr),
 { }
 
 
+SpellerEnum::SpellerEnum(std::shared_ptr<TonIndex> id, bool aux_enum,
+                         const Algo& algo, bool dflag):
+Speller(new PSRawEnum(0, 0), id, (aux_enum?new PSRawEnum(0, 0):nullptr),
+        algo, dflag)
+{ }
+
+
 SpellerEnum::~SpellerEnum()
 {
     assert(_enum);
@@ -132,6 +139,30 @@ void SpellerEnum::add6(int midi, int bar, bool simultaneous,
 }
 
 
+bool SpellerEnum::setNotes(const PSNoteBuffers& buf, bool aux)
+{
+    TRACE("Speller: set {} notes", buf.size);
+    if (aux and not hasAuxEnumerator())
+    {
+        ERROR("Speller setNotes: no auxilliary enumerator");
+        return false;
+    }
+    return rawenum(aux).set(buf);
+}
+
+
+bool SpellerEnum::modify(size_t i, int midi, bool simultaneous, bool aux)
+{
+    TRACE("Speller: modify {} {}", i, midi);
+    if (aux and not hasAuxEnumerator())
+    {
+        ERROR("Speller modify: no auxilliary enumerator");
+        return false;
+    }
+    return rawenum(aux).modify(i, midi, simultaneous);
+}
+
+
 PSRawEnum& SpellerEnum::rawenum(bool aux) const
 {
     PSEnum* e = (aux?_enum_aux:_enum);
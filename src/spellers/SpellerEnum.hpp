@@ -46,6 +46,21 @@ public:
                 const Algo& algo=Algo::Undef, // TBR
                 bool dflag=false);
 
+    /// speller with one or two raw enumerators (initially empty)
+    /// of notes to spell, and a given array of tonalities.
+    /// @param id a Ton Index. must be closed.
+    /// the global tonalities selected by the speller are stored in it,
+    /// it must not be shared by spellers running concurrently.
+    /// @param aux_enum whether we consider an optional auxiliary enumerator
+    /// of alternative input notes, for the construction of the first table.
+    /// @param algo name of the algorithm implemented in speller class.
+    /// obsolete. not used anymore.
+    /// @param dflag debug mode.
+    /// @warning the enumerator must be feeded with add()
+    SpellerEnum(std::shared_ptr<TonIndex> id, bool aux_enum=false,
+                const Algo& algo=Algo::Undef, // TBR
+                bool dflag=false);
+
     // SpellEnum(const Algo& algo=Algo::Undef, size_t nbtons=0, bool dflag=false);
     
     /// destructor
@@ -164,7 +179,31 @@ public: // note enumerator
               int octave=Pitch::UNDEF_OCTAVE,
               bool printed=false, bool aux=false);
     
-private:
+    /// replace the notes to spell by a view of the given external buffers,
+    /// without copy.
+    /// @param buf external buffers of input notes.
+    /// they must stay unchanged while this speller is used.
+    /// @param aux whether the notes shall replace those of the
+    /// auxiliary enumerator.
+    /// @return whether the buffers are well formed and were set.
+    /// @see PSRawEnum::set()
+    /// @warning notes cannot be added with add() after this call,
+    /// until resetEnum().
+    bool setNotes(const PSNoteBuffers& buf, bool aux=false);
+
+    /// replace the input note of given index in the enumerator of notes
+    /// to spell by a note in the same bar. The bar is marked as dirty
+    /// for the re-spelling. Notes cannot be inserted or deleted this way:
+    /// the notes must be spelled again from scratch after such changes.
+    /// @param i index of a note in the enumerator of notes to spell.
+    /// @param midi new MIDI key of the note.
+    /// @param simultaneous whether the note is simultaneous with the next note.
+    /// @param aux whether the note is in the auxiliary enumerator.
+    /// @return whether the note was modified.
+    /// @see PSRawEnum::modify()
+    bool modify(size_t i, int midi, bool simultaneous=false, bool aux=false);
+    
+protected:
 
     /// access the internal raw note enumerator.
     /// @param aux whether we want the auxiliary enumerator.
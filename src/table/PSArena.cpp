@@ -0,0 +1,121 @@
+//
+//  PSArena.cpp
+//  pse
+//
+//  Created by agent on 17/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+
+#include "PSArena.hpp"
+
+
+namespace pse {
+
+
+const size_t PSArena::BLOCKSIZE = 65536;
+
+
+PSArena::PSArena(size_t blocksize):
+_blocksize(blocksize),
+_blocks(),  // empty
+_large(),   // empty
+_current(0),
+_offset(0),
+_live(0),
+_allocated(0)
+{
+    assert(blocksize > 0);
+}
+
+
+PSArena::~PSArena()
+{
+    TRACE("delete PSArena ({} bytes reserved)", capacity());
+    if (_live > 0)
+    {
+        ERROR("PSArena: destroyed with {} live objects", _live);
+    }
+    release();
+}
+
+
+void* PSArena::allocate(size_t bytes, size_t align)
+{
+    assert(align > 0);
+    assert((align & (align - 1)) == 0); // power of 2
+    _live++;
+    _allocated += bytes;
+
+    // segment too large for a standard block
+    if (bytes + align > _blocksize)
+    {
+        _large.emplace_back(new char[bytes + align]);
+        void* p = _large.back().get();
+        size_t space = bytes + align;
+        p = std::align(align, bytes, p, space);
+        assert(p);
+        return p;
+    }
+
+    while (true)
+    {
+        if (_current < _blocks.size())
+        {
+            void* p = _blocks[_current].get() + _offset;
+            size_t space = _blocksize - _offset;
+            if (std::align(align, bytes, p, space))
+            {
+                _offset = _blocksize - space + bytes;
+                assert(_offset <= _blocksize);
+                return p;
+            }
+            // current block full, try the next one
+            _current++;
+            _offset = 0;
+        }
+        else
+        {
+            assert(_current == _blocks.size());
+            assert(_offset == 0);
+            _blocks.emplace_back(new char[_blocksize]);
+        }
+    }
+}
+
+
+void PSArena::deallocate(void* p, size_t bytes)
+{
+    assert(p);
+    assert(_live > 0);
+    _live--;
+}
+
+
+void PSArena::reset()
+{
+    assert(_live == 0);
+    _large.clear();
+    _current = 0;
+    _offset = 0;
+    _allocated = 0;
+}
+
+
+void PSArena::release()
+{
+    reset();
+    _blocks.clear();
+}
+
+
+size_t PSArena::capacity() const
+{
+    return _blocks.size() * _blocksize;
+}
+
+
+} // end namespace pse
+
+/// @}
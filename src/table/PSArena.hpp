@@ -0,0 +1,168 @@
+//
+//  PSArena.hpp
+//  pse
+//
+//  Created by agent on 17/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+
+#ifndef PSArena_hpp
+#define PSArena_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <memory>
+#include <vector>
+
+#include "pstrace.hpp"
+
+
+namespace pse {
+
+/// monotonic memory pool for the PS configs allocated during the best path
+/// search of PS Bags.
+/// Memory is carved out of big blocks by bumping an offset,
+/// and deallocation only updates a counter of live objects.
+/// The blocks are recycled (reset) when all the objects allocated are dead,
+/// and freed when the arena is destroyed.
+/// @see PSArenaAllocator for use with std::allocate_shared.
+class PSArena
+{
+public:
+
+    /// default size of blocks, in bytes.
+    static const size_t BLOCKSIZE;
+
+    /// empty arena. no block is allocated before the first allocation.
+    /// @param blocksize size of the blocks of memory, in bytes.
+    PSArena(size_t blocksize = BLOCKSIZE);
+
+    /// an arena cannot be copied.
+    PSArena(const PSArena& rhs) = delete;
+
+    /// free all the blocks.
+    /// @warning all the objects allocated must be dead.
+    ~PSArena();
+
+    /// an arena cannot be copied.
+    PSArena& operator=(const PSArena& rhs) = delete;
+
+    /// allocate a segment of memory of given size and alignement
+    /// in the current block.
+    /// a new block is added when the current block is full.
+    /// @param bytes size of the segment allocated.
+    /// @param align alignment of the segment allocated.
+    /// must be a power of 2.
+    void* allocate(size_t bytes, size_t align);
+
+    /// mark one segment of memory as dead.
+    /// the memory is not recovered until the next reset.
+    void deallocate(void* p, size_t bytes);
+
+    /// rewind to the beginning of the first block.
+    /// the blocks are kept for the next allocations.
+    /// @warning all the objects allocated must be dead.
+    void reset();
+
+    /// free all the blocks.
+    /// @warning all the objects allocated must be dead.
+    void release();
+
+    /// number of segments allocated and not deallocated.
+    inline size_t live() const { return _live; }
+
+    /// number of bytes allocated since the last reset.
+    inline size_t allocated() const { return _allocated; }
+
+    /// number of bytes reserved in blocks.
+    size_t capacity() const;
+
+private:
+
+    /// size of standard blocks.
+    const size_t _blocksize;
+
+    /// standard blocks of size _blocksize.
+    std::vector<std::unique_ptr<char[]>> _blocks;
+
+    /// dedicated blocks for the segments larger than _blocksize.
+    /// they are freed at reset.
+    std::vector<std::unique_ptr<char[]>> _large;
+
+    /// index of current block in _blocks.
+    size_t _current;
+
+    /// offset of the next free byte in the current block.
+    size_t _offset;
+
+    /// number of segments allocated and not deallocated.
+    size_t _live;
+
+    /// number of bytes allocated since last reset.
+    size_t _allocated;
+
+};
+
+
+/// minimal allocator over a PSArena, for std::allocate_shared.
+/// The arena must outlive all the objects allocated.
+template<typename T>
+class PSArenaAllocator
+{
+public:
+
+    typedef T value_type;
+
+    explicit PSArenaAllocator(PSArena& arena) noexcept:
+    _arena(&arena)
+    { }
+
+    template<typename U>
+    PSArenaAllocator(const PSArenaAllocator<U>& rhs) noexcept:
+    _arena(rhs.arena())
+    { }
+
+    T* allocate(std::size_t n)
+    {
+        assert(_arena);
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        assert(_arena);
+        _arena->deallocate(p, n * sizeof(T));
+    }
+
+    inline PSArena* arena() const noexcept { return _arena; }
+
+private:
+
+    PSArena* _arena;
+
+};
+
+
+template<typename T, typename U>
+bool operator==(const PSArenaAllocator<T>& lhs,
+                const PSArenaAllocator<U>& rhs) noexcept
+{
+    return (lhs.arena() == rhs.arena());
+}
+
+
+template<typename T, typename U>
+bool operator!=(const PSArenaAllocator<T>& lhs,
+                const PSArenaAllocator<U>& rhs) noexcept
+{
+    return (lhs.arena() != rhs.arena());
+}
+
+
+} // namespace pse
+
+#endif /* PSArena_hpp */
+
+/// @}
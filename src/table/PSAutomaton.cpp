@@ -0,0 +1,324 @@
+//
+//  PSAutomaton.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include <type_traits>
+#include <cstring>
+
+#include "PSAutomaton.hpp"
+#include "MidiNum.hpp"
+#include "Enharmonic.hpp"
+
+
+namespace pse {
+
+
+PSAutomaton::PSAutomaton(const Cost& seed, const Ton& gton, const Ton& lton,
+                         bool octave):
+_zero(seed.shared_zero()),
+_gton(gton),
+_lton(lton),
+_octave(octave),
+_size(0),
+_rows(),
+_chords(),
+_mutex()
+{
+    assert(gton.defined());
+}
+
+
+PSAutomaton::~PSAutomaton()
+{
+    TRACE("delete PS automaton: {} states, {} rows", _size, _rows.size());
+}
+
+
+const PSAutomaton::Row& PSAutomaton::row(size_t s, unsigned int midi)
+{
+    assert(MidiNum::check_midi(midi));
+    // in modulo 12 mode, the transitions do not depend on the octave
+    unsigned int key = _octave?midi:(midi%12);
+    uint64_t k = (((uint64_t) s) << 8) | key;
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto it = _rows.find(k);
+        if (it != _rows.end())
+            return it->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    auto it = _rows.find(k); // computed meanwhile by another thread
+    if (it != _rows.end())
+        return it->second;
+    // representative in a middle octave in modulo 12 mode
+    return _rows.emplace(k, compute(s, _octave?midi:(60+key))).first->second;
+}
+
+
+const PSAutomaton::ChordTransit&
+PSAutomaton::chord(size_t s, const std::vector<unsigned int>& midis,
+                   const std::array<enum NoteName, 12>& names)
+{
+    assert(not midis.empty());
+    // key: source state, names, and keys read
+    // (pitch classes in modulo 12 mode)
+    std::string k(sizeof(size_t) + 12 + midis.size(), '\0');
+    std::memcpy(&k[0], &s, sizeof(size_t));
+    for (size_t pc = 0; pc < 12; ++pc)
+        k[sizeof(size_t) + pc] = static_cast<char>(toint(names[pc]));
+    std::vector<unsigned int> reps;
+    reps.reserve(midis.size());
+    for (size_t i = 0; i < midis.size(); ++i)
+    {
+        assert(MidiNum::check_midi(midis[i]));
+        unsigned int key = _octave?midis[i]:(midis[i]%12);
+        k[sizeof(size_t) + 12 + i] = static_cast<char>(key);
+        // representative in a middle octave in modulo 12 mode
+        reps.push_back(_octave?key:(60+key));
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto it = _chords.find(k);
+        if (it != _chords.end())
+            return it->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    auto it = _chords.find(k); // computed meanwhile by another thread
+    if (it != _chords.end())
+        return it->second;
+    return _chords.emplace(k, compute(s, reps, names)).first->second;
+}
+
+
+template<class S>
+PSAutomatonT<S>::PSAutomatonT(const Cost& seed,
+                              const Ton& gton, const Ton& lton, bool tonal):
+PSAutomaton(seed, gton, lton, std::is_same<S, PSStateO>::value),
+_states(),
+_ids()
+{
+    size_t i0 = intern(S(gton, tonal));
+    assert(i0 == INITIAL);
+}
+
+
+template<class S>
+PSAutomatonT<S>::~PSAutomatonT()
+{ }
+
+
+template<class S>
+size_t PSAutomatonT<S>::intern(const S& s)
+{
+    auto ins = _ids.emplace(s, _states.size());
+    if (ins.second)
+    {
+        _states.push_back(s);
+        _size = _states.size();
+    }
+    return ins.first->second;
+}
+
+
+template<class S>
+enum NoteName PSAutomatonT<S>::lastName(size_t s, unsigned int pc) const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    assert(s < _states.size());
+    return _states[s].lastName(pc);
+}
+
+
+template<class S>
+bool PSAutomatonT<S>::member(size_t s, const enum NoteName& name,
+                             const enum Accid& accid, int oct) const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    assert(s < _states.size());
+    return _states[s].member(name, accid, oct);
+}
+
+
+template<class S>
+PSAutomaton::Row PSAutomatonT<S>::compute(size_t s, unsigned int midi)
+{
+    assert(s < _states.size());
+    unsigned int pc = midi % 12;
+    Row r;
+    for (int j = 0; j < 3; ++j)
+    {
+        Transit& t = r[j];
+        t.name = Enharmonics::name(pc, j, false, false);
+        t.accid = Enharmonics::accid(pc, j, false, false);
+        t.print = false;
+        t.target = NOSTATE;
+        assert((t.name == NoteName::Undef) == (t.accid == Accid::Undef));
+        if (not t.defined())
+            continue;
+        assert(t.accid == MidiNum::class_to_accid(pc, t.name));
+        int oct = MidiNum::midi_to_octave(midi, t.name);
+        assert(Pitch::check_octave(oct));
+        // same steps as in the construction of a PSC1
+        S target(_states[s]); // copy
+        const enum NoteName prev_name = target.lastName(pc);
+        t.print = target.update(t.accid, t.name, oct);
+        std::shared_ptr<Cost> delta = _zero->shared_clone();
+        delta->update(t.name, t.accid, t.print, _gton, _lton, prev_name);
+        t.delta = delta;
+        t.target = intern(target);
+    }
+    return r;
+}
+
+
+template<class S>
+PSAutomaton::ChordTransit
+PSAutomatonT<S>::compute(size_t s, const std::vector<unsigned int>& midis,
+                         const std::array<enum NoteName, 12>& names)
+{
+    assert(s < _states.size());
+    ChordTransit t;
+    // same steps as in the construction of a PSC2
+    S target(_states[s]); // copy
+    std::shared_ptr<Cost> delta = _zero->shared_clone();
+    for (unsigned int m : midis)
+    {
+        const enum NoteName& name = names[m % 12];
+        assert(defined(name));
+        enum Accid accid = MidiNum::midi_to_accid(m, name);
+        assert(defined(accid));
+        int oct = MidiNum::midi_to_octave(m, name);
+        assert(Pitch::check_octave(oct));
+        const enum NoteName prev_name = target.lastName(m % 12);
+        bool print = target.update(accid, name, oct);
+        delta->update(name, accid, print, _gton, _lton, prev_name);
+        t.prints.push_back(print);
+    }
+    t.delta = delta;
+    t.target = intern(target);
+    return t;
+}
+
+
+template class PSAutomatonT<PSStateM>;
+template class PSAutomatonT<PSStateO>;
+
+
+size_t PSAutomaton::states() const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _size;
+}
+
+
+size_t PSAutomaton::rows() const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _rows.size();
+}
+
+
+size_t PSAutomaton::chords() const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _chords.size();
+}
+
+
+PSAutomata::PSAutomata(size_t bound):
+_automata(),
+_bound(bound),
+_mutex()
+{ }
+
+
+PSAutomata::~PSAutomata()
+{
+    TRACE("delete PS automata: {} automata", _automata.size());
+}
+
+
+PSAutomaton& PSAutomata::get(const Cost& seed,
+                             const Ton& gton, const Ton& lton,
+                             bool tonal, bool octave)
+{
+    std::array<int, 9> k =
+    {
+        static_cast<int>(seed.type()), tonal, octave,
+        gton.defined(),
+        gton.defined()?gton.fifths():0,
+        gton.defined()?static_cast<int>(gton.getMode()):0,
+        lton.defined(),
+        lton.defined()?lton.fifths():0,
+        lton.defined()?static_cast<int>(lton.getMode()):0
+    };
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::unique_ptr<PSAutomaton>& a = _automata[k];
+    // the type of states is selected once for the automaton
+    if (not a and octave)
+        a.reset(new PSAutomatonT<PSStateO>(seed, gton, lton, tonal));
+    else if (not a)
+        a.reset(new PSAutomatonT<PSStateM>(seed, gton, lton, tonal));
+    return *a;
+}
+
+
+size_t PSAutomata::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _automata.size();
+}
+
+
+size_t PSAutomata::states() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t n = 0;
+    for (const auto& a : _automata)
+        n += a.second->states();
+    return n;
+}
+
+
+size_t PSAutomata::rows() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t n = 0;
+    for (const auto& a : _automata)
+        n += a.second->rows();
+    return n;
+}
+
+
+bool PSAutomata::full() const
+{
+    return (_bound > 0 and states() >= _bound);
+}
+
+
+void PSAutomata::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _automata.clear();
+}
+
+
+bool PSAutomata::reclaim()
+{
+    if (not full())
+        return false;
+    TRACE("PS automata: bound {} reached, remove {} automata",
+          _bound, size());
+    clear();
+    return true;
+}
+
+
+} // end namespace pse
+
+/// @}
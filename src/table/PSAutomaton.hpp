@@ -0,0 +1,325 @@
+//
+//  PSAutomaton.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef PSAutomaton_hpp
+#define PSAutomaton_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <memory>
+#include <array>
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+
+#include "pstrace.hpp"
+#include "NoteName.hpp"
+#include "Accid.hpp"
+#include "Ton.hpp"
+#include "Cost.hpp"
+#include "PSStateP.hpp"
+
+
+namespace pse {
+
+
+/// lazily built spelling automaton for one global tonality,
+/// one local tonality and one cost type.
+/// Its states are the accidental states reachable from the
+/// initial state of the global tonality, identified by an index.
+/// The configs of the searches only store the index of their state.
+/// A transition from a state, when reading a MIDI key, is computed once,
+/// the first time it is requested, with the successor state, the name,
+/// accidental and print flag of the note, and the increment of cost.
+/// The cost increments do not depend on the cost of the source,
+/// hence a transition can be reused by every path reaching its source.
+/// In octave mode, transitions are indexed by MIDI key, otherwise by
+/// pitch class.
+/// The states are stored in the descendant PSAutomatonT, whose type
+/// of state is chosen according to the octave mode.
+/// The accesses are thread-safe.
+class PSAutomaton
+{
+public: // types
+
+    /// one transition: spelling of a note in a state.
+    struct Transit
+    {
+        /// name chosen for the note, Undef if there is no such spelling.
+        enum NoteName name;
+
+        /// accidental of the note for the name.
+        enum Accid accid;
+
+        /// whether the accidental of the note must be printed.
+        bool print;
+
+        /// index of the target state.
+        size_t target;
+
+        /// cost increment for the transition.
+        std::shared_ptr<const Cost> delta;
+
+        /// whether this transition is defined.
+        inline bool defined() const { return pse::defined(name); }
+    };
+
+    /// transitions from one state, when reading one note,
+    /// one for each enharmonic spelling (in the order of Enharmonics).
+    typedef std::array<Transit, 3> Row;
+
+    /// one chord transition: spelling of the simultaneous notes of a chord
+    /// in a state, with one name for each pitch class of the chord.
+    struct ChordTransit
+    {
+        /// whether the accidental must be printed, for each note of the
+        /// chord, in order.
+        std::vector<bool> prints;
+
+        /// index of the target state.
+        size_t target;
+
+        /// cost increment for the transition.
+        std::shared_ptr<const Cost> delta;
+    };
+
+    /// index of the initial state.
+    static const size_t INITIAL = 0;
+
+    /// undefined state index.
+    static const size_t NOSTATE = SIZE_MAX;
+
+public: // construction
+
+    /// automaton without states.
+    /// @param seed cost value of the type used for the search.
+    /// @param gton conjectured global tonality (key sig),
+    /// used to define the initial state.
+    /// @param lton conjectured local tonality, possibly undefined.
+    /// @param octave mode for the state transitions.
+    PSAutomaton(const Cost& seed, const Ton& gton, const Ton& lton,
+                bool octave);
+
+    /// an automaton cannot be copied.
+    PSAutomaton(const PSAutomaton& rhs) = delete;
+
+    virtual ~PSAutomaton();
+
+    /// an automaton cannot be copied.
+    PSAutomaton& operator=(const PSAutomaton& rhs) = delete;
+
+public: // access
+
+    /// transitions from the given state when reading the given MIDI key.
+    /// they are computed the first time.
+    /// @param s index of a state of this automaton.
+    /// @param midi MIDI key of the note read.
+    const Row& row(size_t s, unsigned int midi);
+
+    /// transition from the given state when reading the given chord
+    /// with the given names, as with the notes of the chord read one by one.
+    /// It is computed the first time.
+    /// @param s index of a state of this automaton.
+    /// @param midis MIDI keys of the simultaneous notes of the chord read,
+    /// in order. The last note of the chord (not simultaneous with the next
+    /// note) is not read by this transition.
+    /// @param names name for each pitch class of the chord,
+    /// Undef for the other pitch classes.
+    const ChordTransit& chord(size_t s, const std::vector<unsigned int>& midis,
+                              const std::array<enum NoteName, 12>& names);
+
+    /// number of states built.
+    size_t states() const;
+
+    /// number of rows of transitions built.
+    size_t rows() const;
+
+    /// number of chord transitions built.
+    size_t chords() const;
+
+    /// octave mode for the state transitions.
+    inline bool octave() const { return _octave; }
+
+    /// last name read for the given pitch class in the given state.
+    /// @param s index of a state of this automaton.
+    /// @param pc pitch class in 0..11.
+    virtual enum NoteName lastName(size_t s, unsigned int pc) const = 0;
+
+    /// whether the given accidental is associated to the given note name
+    /// in the given state.
+    /// @param s index of a state of this automaton.
+    virtual bool member(size_t s, const enum NoteName& name,
+                        const enum Accid& accid, int oct) const = 0;
+
+protected: // data
+
+    /// zero cost of the type used for the search.
+    std::shared_ptr<const Cost> _zero;
+
+    /// conjectured global tonality.
+    const Ton _gton;
+
+    /// conjectured local tonality.
+    const Ton _lton;
+
+    /// octave mode.
+    bool _octave;
+
+    /// number of states.
+    size_t _size;
+
+    /// rows of transitions, by index of source state and key read.
+    std::unordered_map<uint64_t, Row> _rows;
+
+    /// chord transitions, by index of source state, keys read and names.
+    std::unordered_map<std::string, ChordTransit> _chords;
+
+    /// for concurrent accesses.
+    mutable std::shared_mutex _mutex;
+
+protected:
+
+    /// compute the transitions from the given state when reading a note,
+    /// and add the new target states.
+    /// @warning the lock must be held for writing.
+    virtual Row compute(size_t s, unsigned int midi) = 0;
+
+    /// compute the transition from the given state when reading a chord,
+    /// and add the new target state.
+    /// @param midis MIDI keys of the notes of the chord, representatives
+    /// in a middle octave in modulo 12 mode.
+    /// @warning the lock must be held for writing.
+    virtual ChordTransit compute(size_t s,
+                                 const std::vector<unsigned int>& midis,
+                                 const std::array<enum NoteName, 12>& names) = 0;
+
+};
+
+
+/// spelling automaton with states of type S (PSStateM or PSStateO).
+template<class S>
+class PSAutomatonT : public PSAutomaton
+{
+public:
+
+    /// automaton with only the initial state.
+    /// @param seed cost value of the type used for the search.
+    /// @param gton conjectured global tonality (key sig),
+    /// used to define the initial state.
+    /// @param lton conjectured local tonality, possibly undefined.
+    /// @param tonal mode: tonal or modal, for the initial state.
+    PSAutomatonT(const Cost& seed, const Ton& gton, const Ton& lton,
+                 bool tonal);
+
+    ~PSAutomatonT();
+
+    enum NoteName lastName(size_t s, unsigned int pc) const override;
+
+    bool member(size_t s, const enum NoteName& name,
+                const enum Accid& accid, int oct) const override;
+
+protected:
+
+    Row compute(size_t s, unsigned int midi) override;
+
+    ChordTransit compute(size_t s, const std::vector<unsigned int>& midis,
+                         const std::array<enum NoteName, 12>& names) override;
+
+private:
+
+    /// states, by index.
+    std::vector<S> _states;
+
+    /// index of the states.
+    std::unordered_map<S, size_t, typename S::Hash> _ids;
+
+    /// index of the given state, added if it is new.
+    /// @warning the lock must be held for writing.
+    size_t intern(const S& s);
+
+};
+
+
+/// collection of spelling automata, one for each combination
+/// of cost type, global tonality, local tonality, tonal and octave modes,
+/// built on demand.
+/// It can be shared by all the tables of a speller.
+/// The total number of states can be bounded: when the bound is reached,
+/// the new bag searches do not use the automata, and the automata are
+/// removed at the next call to reclaim.
+/// The accesses are thread-safe.
+class PSAutomata
+{
+public:
+
+    /// @param bound maximal total number of states in the automata,
+    /// 0 for no bound. It can be exceeded by the states added by the
+    /// searches in progress when it is reached.
+    PSAutomata(size_t bound=0);
+
+    /// a collection cannot be copied.
+    PSAutomata(const PSAutomata& rhs) = delete;
+
+    ~PSAutomata();
+
+    /// a collection cannot be copied.
+    PSAutomata& operator=(const PSAutomata& rhs) = delete;
+
+    /// automaton for the given parameters, built the first time.
+    /// @see PSAutomaton constructor.
+    PSAutomaton& get(const Cost& seed, const Ton& gton, const Ton& lton,
+                     bool tonal, bool octave);
+
+    /// number of automata built.
+    size_t size() const;
+
+    /// total number of states in the automata.
+    size_t states() const;
+
+    /// total number of rows of transitions in the automata.
+    size_t rows() const;
+
+    /// maximal total number of states, 0 if there is no bound.
+    inline size_t bound() const { return _bound; }
+
+    /// whether the bound on the number of states is reached.
+    /// In this case, the automata should not be used for new searches.
+    bool full() const;
+
+    /// remove all the automata.
+    /// @warning no search must be in progress with the automata.
+    void clear();
+
+    /// remove all the automata if the bound is reached.
+    /// @return whether the automata were removed.
+    /// @warning no search must be in progress with the automata.
+    bool reclaim();
+
+private:
+
+    std::map<std::array<int, 9>, std::unique_ptr<PSAutomaton>> _automata;
+
+    /// maximal total number of states, 0 for no bound.
+    size_t _bound;
+
+    /// for concurrent accesses.
+    mutable std::mutex _mutex;
+
+};
+
+
+} // namespace pse
+
+#endif /* PSAutomaton_hpp */
+
+/// @}
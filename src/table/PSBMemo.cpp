@@ -0,0 +1,166 @@
+//
+//  PSBMemo.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include "PSBMemo.hpp"
+
+
+namespace pse {
+
+
+const size_t PSBMemo::CAPACITY = 10000;
+
+
+PSBMemo::PSBMemo(size_t capacity):
+_table(),
+_recency(),
+_capacity(capacity),
+_hits(0),
+_misses(0),
+_mutex()
+{ }
+
+
+PSBMemo::~PSBMemo()
+{
+    TRACE("delete PSB memo: {} entries, {} hits, {} misses",
+          _table.size(), _hits, _misses);
+}
+
+
+// static
+PSBMemo::Key PSBMemo::key(const PSEnum& e, const Algo& a, const Cost& seed,
+                          bool tonal, bool octave,
+                          const Ton& gton, const Ton& lton)
+{
+    assert(not e.open());
+    Key k;
+    k.data.reserve(12 + 5 * e.size());
+    k.data.push_back(static_cast<int>(a));
+    k.data.push_back(static_cast<int>(seed.type()));
+    k.data.push_back(tonal);
+    k.data.push_back(octave);
+    k.data.push_back(gton.defined());
+    k.data.push_back(gton.defined()?gton.fifths():0);
+    k.data.push_back(gton.defined()?static_cast<int>(gton.getMode()):0);
+    k.data.push_back(lton.defined());
+    k.data.push_back(lton.defined()?lton.fifths():0);
+    k.data.push_back(lton.defined()?static_cast<int>(lton.getMode()):0);
+    k.data.push_back((int) e.size());
+    for (size_t i = e.first(); i < e.stop(); ++i)
+    {
+        k.data.push_back((int) e.midipitch(i));
+        k.data.push_back(e.simultaneous(i));
+        k.data.push_back(static_cast<int>(e.name(i)));
+        k.data.push_back(static_cast<int>(e.accidental(i)));
+        k.data.push_back(e.octave(i));
+    }
+    // FNV-1a
+    uint64_t h = 14695981039346656037ULL;
+    for (int x : k.data)
+    {
+        h ^= (uint64_t) (uint32_t) x;
+        h *= 1099511628211ULL;
+    }
+    k.hash = (size_t) h;
+    return k;
+}
+
+
+std::shared_ptr<const PSBMemo::Entry> PSBMemo::find(const Key& k, bool paths)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _table.find(k);
+    if (it == _table.end() or (paths and it->second.entry->paths == nullptr))
+    {
+        ++_misses;
+        return nullptr;
+    }
+    else
+    {
+        ++_hits;
+        // most recently used
+        _recency.splice(_recency.begin(), _recency, it->second.pos);
+        return it->second.entry;
+    }
+}
+
+
+void PSBMemo::insert(const Key& k, std::shared_ptr<const Entry> entry)
+{
+    assert(entry);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto res = _table.emplace(k, Slot{ entry, _recency.end() });
+    Slot& slot = res.first->second;
+    if (res.second)
+    {
+        // the key in the table is not moved by rehashing
+        _recency.push_front(&(res.first->first));
+        slot.pos = _recency.begin();
+    }
+    else
+    {
+        // replace a result without best paths
+        if (slot.entry->paths == nullptr and entry->paths != nullptr)
+            slot.entry = entry;
+        _recency.splice(_recency.begin(), _recency, slot.pos);
+    }
+    // remove the least recently used
+    while (_capacity > 0 and _table.size() > _capacity)
+    {
+        assert(not _recency.empty());
+        auto it = _table.find(*(_recency.back()));
+        assert(it != _table.end());
+        _recency.pop_back();
+        _table.erase(it);
+    }
+}
+
+
+size_t PSBMemo::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _table.size();
+}
+
+
+size_t PSBMemo::hits() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hits;
+}
+
+
+size_t PSBMemo::misses() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _misses;
+}
+
+
+double PSBMemo::hitRate() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t n = _hits + _misses;
+    return (n == 0)?0.0:((double) _hits / (double) n);
+}
+
+
+void PSBMemo::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _table.clear();
+    _recency.clear();
+    _hits = 0;
+    _misses = 0;
+}
+
+
+} // end namespace pse
+
+/// @}
@@ -0,0 +1,186 @@
+//
+//  PSBMemo.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef PSBMemo_hpp
+#define PSBMemo_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <memory>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+#include "pstrace.hpp"
+#include "NoteName.hpp"
+#include "Accid.hpp"
+#include "AlgoName.hpp"
+#include "Ton.hpp"
+#include "Cost.hpp"
+#include "PSEnum.hpp"
+#include "PSPStore.hpp"
+
+
+namespace pse {
+
+
+/// content-addressed cache of the results of the best path searches
+/// of PS Bags, for the bars with identical contents
+/// (repeated bars, doublings in different parts).
+/// The results are indexed by the sequence of MIDI keys, simultaneity flags
+/// and forced names of the notes of the bar, and the parameters of the
+/// search: algorithm, cost type, global and local tonalities,
+/// tonal and octave modes. They are stored relatively to the first note
+/// of the bar, and can be reused for a bar at any position.
+/// The number of results stored can be bounded: when the capacity is
+/// reached, the least recently used result is removed.
+/// The accesses are thread-safe. A memo can be shared by all the columns
+/// of a table, by the tables of a speller and by the spellers of a batch.
+class PSBMemo
+{
+public: // types
+
+    /// key of a bar and search parameters.
+    struct Key
+    {
+        /// encoding of the bar and the parameters.
+        std::vector<int> data;
+
+        /// hash value of data.
+        size_t hash;
+
+        bool operator==(const Key& rhs) const
+        { return hash == rhs.hash and data == rhs.data; }
+    };
+
+    /// result of a best path search.
+    struct Entry
+    {
+        /// cost of the best paths.
+        std::shared_ptr<const Cost> cost;
+
+        /// number of best paths.
+        size_t ties;
+
+        /// compact store of the best paths, relatively to the first note
+        /// of the bar, shared by the bags built from this result.
+        /// null for a result recorded by a bag in cost-only mode.
+        std::shared_ptr<const PSPStore> paths;
+    };
+
+public: // construction
+
+    /// default capacity of the caches of spellers.
+    static const size_t CAPACITY;
+
+    /// empty cache.
+    /// @param capacity maximal number of results stored, 0 for no bound.
+    PSBMemo(size_t capacity=0);
+
+    /// a cache cannot be copied.
+    PSBMemo(const PSBMemo& rhs) = delete;
+
+    ~PSBMemo();
+
+    /// a cache cannot be copied.
+    PSBMemo& operator=(const PSBMemo& rhs) = delete;
+
+public: // access
+
+    /// key for the notes of the given enumerator and search parameters.
+    /// @param e enumerator of the notes of a bar. must not be open.
+    /// @param a name of pitch-spelling algorithm.
+    /// @param seed cost value of the type used for the search.
+    /// @param tonal mode: tonal or modal.
+    /// @param octave mode for the state transitions.
+    /// @param gton conjectured global tonality.
+    /// @param lton conjectured local tonality, possibly undefined.
+    static Key key(const PSEnum& e, const Algo& a, const Cost& seed,
+                   bool tonal, bool octave,
+                   const Ton& gton, const Ton& lton);
+
+    /// result stored for the given key.
+    /// @param paths whether the result must contain the best paths.
+    /// In this case, a result recorded in cost-only mode is not found.
+    /// @return a pointer to the result, or null if there is none.
+    /// the counters of hits and misses are updated,
+    /// and the result found becomes the most recently used.
+    std::shared_ptr<const Entry> find(const Key& k, bool paths = true);
+
+    /// store a result for the given key.
+    /// if a result is already stored for the key, it is kept,
+    /// unless it has no best paths and the given result has.
+    /// The least recently used result is removed if the capacity
+    /// is exceeded.
+    void insert(const Key& k, std::shared_ptr<const Entry> entry);
+
+    /// number of results stored.
+    size_t size() const;
+
+    /// maximal number of results stored, 0 if there is no bound.
+    inline size_t capacity() const { return _capacity; }
+
+    /// number of searches for which a result was found.
+    size_t hits() const;
+
+    /// number of searches for which no result was found.
+    size_t misses() const;
+
+    /// ratio of hits among the searches, 0 if there was no search.
+    double hitRate() const;
+
+    /// remove all the results and reset the counters.
+    void clear();
+
+private: // data
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& k) const { return k.hash; }
+    };
+
+    /// keys of the results stored, from the most recently used.
+    /// they point to the keys in the table.
+    typedef std::list<const Key*> Recency;
+
+    /// result stored and its position in the list of recently used.
+    struct Slot
+    {
+        std::shared_ptr<const Entry> entry;
+        Recency::iterator pos;
+    };
+
+    /// table of results.
+    std::unordered_map<Key, Slot, KeyHash> _table;
+
+    /// keys of the results, from the most recently used.
+    Recency _recency;
+
+    /// maximal number of results, 0 for no bound.
+    size_t _capacity;
+
+    /// number of hits.
+    size_t _hits;
+
+    /// number of misses.
+    size_t _misses;
+
+    /// for concurrent accesses.
+    mutable std::mutex _mutex;
+
+};
+
+
+} // namespace pse
+
+#endif /* PSBMemo_hpp */
+
+/// @}
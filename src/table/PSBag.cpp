@@ -6,6 +6,10 @@
 //  Copyright © 2022 Florent Jacquemard. All rights reserved.
 //
 
+#include <unordered_set>
+#include <map>
+#include <algorithm>
+
 #include "PSBag.hpp"
 #include "Pitch.hpp"
 #include "Enharmonic.hpp"
@@ -19,16 +23,77 @@ namespace pse {
 
 PSB::PSB(const Algo& a, const Cost& seed, PSEnum& e,
          bool tonal, bool octave,
-         const Ton& gton, const Ton& lton):
+         const Ton& gton, const Ton& lton,
+         PSArena* arena, const PSBarView* notes, PSBMemo* memo,
+         PSAutomata* automata, const enum NoteName* chroma, bool astar,
+         bool costonly):
 _algo(a),
 _enum(e),
+_ownnotes(),
+_notes(notes),
+_arena(arena),
+_automaton(nullptr),
+_chroma(chroma),
 _bests(),   // empty
-_cost(seed.shared_zero())     // zero
+_store(),   // null
+_paths(),   // empty
+_cost(seed.shared_zero()),    // zero
+_costonly(costonly),
+_ties(0),
+_dominated(0),
+_expanded(0),
+_astar(astar),
+_bounds(),
+_firsts(),
+_ifirsts(),
+_spellings(),
+_constrained()
 //_visited()  // empty
 {
     if (not e.empty())
     {
-        init(seed, gton, lton, tonal, octave);
+        if (_notes == nullptr)
+        {
+            _ownnotes.reset(new PSBarView(e, e.first(), e.stop()));
+            _notes = _ownnotes.get();
+        }
+        assert(_notes->first() == e.first());
+        assert(_notes->stop() == e.stop());
+        if (automata != nullptr and not automata->full())
+            _automaton = &(automata->get(seed, gton, lton, tonal, octave));
+        // reuse the result of a search for the same notes
+        assert(memo == nullptr or _arena != nullptr);
+        if (memo != nullptr)
+        {
+            PSBMemo::Key k = PSBMemo::key(*_notes, a, seed, tonal, octave,
+                                          gton, lton);
+            std::shared_ptr<const PSBMemo::Entry> entry =
+                memo->find(k, not _costonly);
+            if (entry)
+            {
+                load(*entry);
+            }
+            else
+            {
+                init(seed, gton, lton, tonal, octave);
+                // cost-only: the cost and number of best paths are cached,
+                // the best paths are searched again when needed.
+                if (_costonly)
+                    release();
+                else
+                    pin();
+                memo->insert(k, record());
+            }
+        }
+        else
+        {
+            init(seed, gton, lton, tonal, octave);
+            if (_costonly)
+                release();
+            else
+                pin();
+        }
+        _automaton = nullptr;
     }
     // otherwise n0 == n1, no note, leave _best empty
     else
@@ -38,6 +103,41 @@ _cost(seed.shared_zero())     // zero
 }
 
 
+PSB::PSB(const Algo& a, PSEnum& e, const Cost& cost,
+         std::shared_ptr<const PSPStore> store):
+_algo(a),
+_enum(e),
+_ownnotes(),
+_notes(nullptr),
+_arena(nullptr),
+_automaton(nullptr),
+_chroma(nullptr),
+_bests(),   // empty
+_store(),   // null
+_paths(),   // empty
+_cost(cost.shared_clone()),
+_costonly(false),
+_ties(0),
+_dominated(0),
+_expanded(0),
+_astar(false),
+_bounds(),
+_firsts(),
+_ifirsts(),
+_spellings(),
+_constrained()
+{
+    // otherwise n0 == n1, no note, leave _paths empty
+    if (not e.empty())
+    {
+        assert(store);
+        _store = store;
+        for (size_t k = 0; k < _store->size(); ++k)
+            _paths.emplace_back(new PSP(_enum, cost, _store, k));
+    }
+}
+
+
 PSB::~PSB()
 {
     // deallocate all configs in the priority queue
@@ -60,6 +160,17 @@ PSB::~PSB()
 }
 
 
+template<class C, class... Args>
+std::shared_ptr<const C> PSB::make(Args&&... args) const
+{
+    if (_arena)
+        return std::allocate_shared<C>(PSArenaAllocator<C>(*_arena),
+                                       std::forward<Args>(args)...);
+    else
+        return std::make_shared<C>(std::forward<Args>(args)...);
+}
+
+
 // algo best path search
 void PSB::init(const Cost& seed, const Ton& ton, const Ton& lton,
                bool tonal, bool octave)
@@ -80,17 +191,31 @@ void PSB::init(const Cost& seed, const Ton& ton, const Ton& lton,
     // other configurations are moved to _visited (except if the cost is
     // larger than cost of a best path)
     // @todo limtit _visited to non-final configurations in a best path
-    // use the default ordering > (and ==) on PSCost
-    PSCQueue q = PSCQueue(PSClex());
+    // ordered by PSClex, in buckets by number of accidentals
+    PSCQueue q;
+
+    // closed table: first config expanded for each class of equivalent
+    // configs (same note index, accidental state and chord bookkeeping).
+    // since configs are popped by increasing cost, it is of minimal cost
+    // in its class, and the equivalent configs of larger cost popped later
+    // are dominated. the equivalent configs of same cost are expanded,
+    // in order to keep all the best paths.
+    std::unordered_set<std::shared_ptr<const PSC0>, PSCHash, PSCEquiv> closed;
     
 //    if (fsucc)
 //        q = PSCQueue(PSClex()); // empty
 //    else
 //        q = PSCQueue(PSCad()); // empty
     
+    // lower bounds for A*
+    if (_astar)
+        initBounds(seed, ton, lton, octave);
+
     // initial configuration. n0
-    q.push(std::shared_ptr<const PSC0>(new
-                            PSC0(ton, _enum.first(), seed, tonal, octave)));
+    if (_automaton)
+        push(q, make<PSC0>(*_automaton, _enum.first(), seed));
+    else
+        push(q, make<PSC0>(ton, _enum.first(), seed, tonal, octave));
     
     while (! q.empty())
     {
@@ -134,14 +259,192 @@ void PSB::init(const Cost& seed, const Ton& ton, const Ton& lton,
         // complete the path of c with its successors
         else
         {
+            // prune: c is dominated by an equivalent config
+            // of smaller cost, already expanded
+            auto ins = closed.insert(c);
+            if ((! ins.second) && (c->cost() > (*ins.first)->cost()))
+            {
+                ++_dominated;
+                continue;
+            }
             // keep c from deletion, as it might be added to _inbest
             // for rollback of best path.
             // (c will be the prev of the succ computed here)
             visited.push_back(c);
+            ++_expanded;
             // add every possible successor configs to q
-            succ(c, q, ton, lton);
+            if (_automaton)
+                succ_automaton(c, q, ton);
+            else
+                succ(c, q, ton, lton);
+        }
+    }
+}
+
+
+void PSB::push(PSCQueue& q, std::shared_ptr<const PSC0> c) const
+{
+    if (_astar)
+    {
+        size_t b = bound(*c);
+        q.push(std::move(c), b);
+    }
+    else
+        q.push(std::move(c));
+}
+
+
+void PSB::initBounds(const Cost& seed, const Ton& gton, const Ton& lton,
+                     bool octave)
+{
+    assert(_bounds.empty());
+    size_t n = _enum.stop() - _enum.first();
+    std::stack<enum NoteName> names;
+    std::stack<enum Accid> accids;
+    for (size_t id = _enum.first(); id < _enum.stop(); ++id)
+    {
+        unsigned int m = _notes->midipitch(id);
+        get_names(id, gton, names, accids);
+        assert(names.size() == accids.size());
+        assert(names.size() <= 3);
+        Bound b;
+        b.names.fill(NoteName::Undef);
+        b.accids.fill(Accid::Undef);
+        b.octs.fill(Pitch::UNDEF_OCTAVE);
+        b.print = SIZE_MAX;
+        for (size_t j = 0; ! names.empty(); ++j)
+        {
+            b.names[j] = names.top();
+            b.accids[j] = accids.top();
+            b.octs[j] = octave?MidiNum::midi_to_octave(m, names.top()):
+                               Pitch::UNDEF_OCTAVE;
+            // printed, without inconsistency (no previous name)
+            std::shared_ptr<Cost> d = seed.shared_zero();
+            d->update(names.top(), accids.top(), true, gton, lton);
+            b.print = std::min(b.print, d->primary());
+            names.pop();
+            accids.pop();
+        }
+        assert(b.print != SIZE_MAX);
+        _bounds.push_back(b);
+    }
+
+    // first occurrences, computed backwards
+    std::vector<std::vector<size_t>> firsts(n + 1);
+    std::map<unsigned int, size_t> last; // key -> first occurrence
+    for (size_t i = n; i > 0; --i)
+    {
+        unsigned int m = _notes->midipitch(_enum.first() + i - 1);
+        last[octave?m:(m % 12)] = i - 1;
+        for (const auto& p : last)
+            firsts[i - 1].push_back(p.second);
+    }
+    _ifirsts.push_back(0);
+    for (size_t i = 0; i <= n; ++i)
+    {
+        _firsts.insert(_firsts.end(), firsts[i].begin(), firsts[i].end());
+        _ifirsts.push_back(_firsts.size());
+    }
+}
+
+
+size_t PSB::bound(const PSC0& c) const
+{
+    assert(_enum.first() <= c.id());
+    assert(c.id() <= _enum.stop());
+    size_t i = c.id() - _enum.first();
+    assert(i + 1 < _ifirsts.size());
+    size_t h = 0;
+    for (size_t k = _ifirsts[i]; k < _ifirsts[i + 1]; ++k)
+    {
+        const Bound& b = _bounds[_firsts[k]];
+        bool covered = false;
+        for (size_t j = 0; j < 3 and defined(b.names[j]) and !covered; ++j)
+        {
+            covered = _automaton?
+            _automaton->member(c.sid(), b.names[j], b.accids[j], b.octs[j]):
+            c.state().member(b.names[j], b.accids[j], b.octs[j]);
         }
+        if (! covered)
+            h += b.print;
     }
+    return h;
+}
+
+
+void PSB::pin()
+{
+    assert(_paths.empty());
+    std::shared_ptr<PSPStore> store =
+        std::make_shared<PSPStore>(_enum.stop() - _enum.first());
+    for (const std::shared_ptr<const PSC0>& c : _bests)
+    {
+        assert(c);
+        assert(c->id() == _enum.stop());
+        size_t k = store->add(*c);
+        _paths.emplace_back(new PSP(_enum, c->cost(), store, k));
+    }
+    assert(_paths.size() == _bests.size());
+    _store = store;
+
+    // release the configs (and their predecessors) allocated in the arena.
+    if (_arena)
+        _bests.clear();
+}
+
+
+void PSB::load(const PSBMemo::Entry& entry)
+{
+    assert(_bests.empty());
+    assert(_paths.empty());
+    assert(entry.cost);
+    _cost = entry.cost->shared_clone();
+    if (_costonly)
+    {
+        release();
+        _ties = entry.ties;
+        return;
+    }
+    assert(entry.paths);
+    assert(entry.paths->size() == entry.ties);
+    // the store is shared with the cache
+    _store = entry.paths;
+    for (size_t k = 0; k < _store->size(); ++k)
+        _paths.emplace_back(new PSP(_enum, *(entry.cost), _store, k));
+}
+
+
+void PSB::release()
+{
+    assert(_costonly);
+    if (not _paths.empty())
+        _ties = _paths.size();
+    else if (not _bests.empty())
+        _ties = _bests.size();
+    // the configs allocated in the heap are freed with their last reference
+    PSCHeap().swap(_bests);
+    std::vector<std::unique_ptr<const PSP>>().swap(_paths);
+    _store.reset();
+    std::vector<Bound>().swap(_bounds);
+    std::vector<size_t>().swap(_firsts);
+    std::vector<size_t>().swap(_ifirsts);
+    std::unordered_map<uint16_t, std::vector<PSChordSpelling>>().swap(_spellings);
+    std::vector<PSChordSpelling>().swap(_constrained);
+    _notes = nullptr;
+    _ownnotes.reset();
+}
+
+
+std::shared_ptr<const PSBMemo::Entry> PSB::record() const
+{
+    assert(_cost);
+    assert(_costonly or _store);
+    std::shared_ptr<PSBMemo::Entry> entry = std::make_shared<PSBMemo::Entry>();
+    entry->cost = _cost->shared_clone();
+    entry->ties = size();
+    // null in cost-only mode
+    entry->paths = _store;
+    return entry;
 }
 
 
@@ -156,66 +459,14 @@ void PSB::succ(std::shared_ptr<const PSC0> c, PSCQueue& q,
     std::stack<enum Accid> accids;
     //std::stack<bool> prints;
     
-    // note in chord
-    if (_enum.simultaneous(id))
+    // chord: all the simultaneous notes are spelled in one step,
+    // with one name for each pitch class.
+    // the last note of the chord is read after as a single note.
+    if (_notes->simultaneous(id))
     {
-        // first note of chord
-        if (! c->inChord())
-        {
-            get_names(id, gton, names, accids);
-            assert(names.size() == accids.size());
-            //assert(prints.size() == accids.size());
-            while (! names.empty())
-            {
-                q.push(std::make_shared<PSC1c>(c, _enum,
-                                               names.top(),
-                                               accids.top(),
-                                               gton, lton));
-                names.pop();
-                accids.pop();
-                //prints.pop();
-            }
-        }
-        // next note of chord
-        else
-        {
-            std::shared_ptr<const PSC1c> c1 =
-            std::dynamic_pointer_cast<const PSC1c>(c);
-            assert(c1);
-            assert(c1->id() == id);
-            const PSChord chord = c1->chord();
-            unsigned int m = chord.midipitch(id);
-            assert(MidiNum::check_midi(m));
-            const enum NoteName dejaname = c1->dejavu(m%12);
-            
-            // pitch class already processed in chord,
-            // we resuse the previous name chosen for the pitch class
-            if (dejaname != NoteName::Undef)
-            {
-                q.push(std::make_shared<PSC1c>(c1,
-                                               dejaname,
-                                               MidiNum::midi_to_accid(m, dejaname),
-                                               false, //c1->dejaprint(m), // force print
-                                               gton, lton));
-            }
-            else
-            {
-                get_names(id, gton, names, accids);
-                assert(names.size() == accids.size());
-                //assert(prints.size() == accids.size());
-                while (! names.empty())
-                {
-                    q.push(std::make_shared<PSC1c>(c1,
-                                                   names.top(),
-                                                   accids.top(),
-                                                   false, // force print
-                                                   gton, lton));
-                    names.pop();
-                    accids.pop();
-                    //prints.pop();
-                }
-            }
-        }
+        assert(! c->inChord());
+        for (const PSChordSpelling& sp : spellings(id, gton))
+            push(q, make<PSC2>(c, *_notes, sp, gton, lton));
     }
     // single note
     else
@@ -225,7 +476,7 @@ void PSB::succ(std::shared_ptr<const PSC0> c, PSCQueue& q,
         //assert(prints.size() == accids.size());
         while (! names.empty())
         {
-            q.push(std::make_shared<PSC1>(c, _enum,
+            push(q, make<PSC1>(c, *_notes,
                                           names.top(),
                                           accids.top(),
                                           false, // force print
@@ -238,27 +489,182 @@ void PSB::succ(std::shared_ptr<const PSC0> c, PSCQueue& q,
 }
 
 
+const std::vector<PSChordSpelling>& PSB::spellings(size_t id,
+                                                  const Ton& gton) const
+{
+    // first occurrence of each pitch class in the chord
+    std::array<size_t, 12> firsts;
+    firsts.fill(PSEnum::ID_INF);
+    uint16_t pcs = 0;
+    bool constrained = false;
+    for (size_t i = id; i < _enum.stop() and _notes->simultaneous(i); ++i)
+    {
+        unsigned int pc = _notes->midipitch(i) % 12;
+        if (firsts[pc] == PSEnum::ID_INF)
+        {
+            firsts[pc] = i;
+            pcs |= (1 << pc);
+            // the other occurrences take the name of the first one
+            if (_notes->name(i) != NoteName::Undef)
+                constrained = true;
+        }
+    }
+    assert(pcs != 0);
+
+    // the names for a pitch class set depend only on the ton of this bag,
+    // when they are not constrained.
+    std::vector<PSChordSpelling>& res =
+        constrained?_constrained:_spellings[pcs];
+    if (! constrained and ! res.empty())
+        return res;
+
+    // cartesian product of the names for each pitch class, in order
+    res.assign(1, PSChordSpelling());
+    res.front().fill(NoteName::Undef);
+    std::stack<enum NoteName> names;
+    std::stack<enum Accid> accids;
+    for (unsigned int pc = 0; pc < 12; ++pc)
+    {
+        if (firsts[pc] == PSEnum::ID_INF)
+            continue;
+        get_names(firsts[pc], gton, names, accids);
+        assert(! names.empty());
+        const size_t n = res.size();
+        // the first name is set in place, the others in copies
+        bool first = true;
+        for (; ! names.empty(); names.pop(), accids.pop())
+        {
+            if (first)
+            {
+                for (size_t k = 0; k < n; ++k)
+                    res[k][pc] = names.top();
+                first = false;
+            }
+            else
+            {
+                for (size_t k = 0; k < n; ++k)
+                {
+                    res.push_back(res[k]);
+                    res.back()[pc] = names.top();
+                }
+            }
+        }
+    }
+    return res;
+}
+
+
+void PSB::succ_automaton(std::shared_ptr<const PSC0> c, PSCQueue& q,
+                         const Ton& gton) const
+{
+    assert(c);
+    assert(_automaton);
+    size_t id = c->id();
+
+    // chord: all the simultaneous notes are spelled in one step,
+    // with a chord transition of the automaton, as in succ.
+    if (_notes->simultaneous(id))
+    {
+        assert(! c->inChord());
+        std::vector<unsigned int> midis;
+        for (size_t i = id; i < _enum.stop() and _notes->simultaneous(i); ++i)
+            midis.push_back(_notes->midipitch(i));
+        for (const PSChordSpelling& sp : spellings(id, gton))
+            push(q, make<PSC2>(c, *_notes, sp,
+                               _automaton->chord(c->sid(), midis, sp)));
+    }
+    // single note
+    else
+    {
+        const PSAutomaton::Row& row =
+            _automaton->row(c->sid(), _notes->midipitch(id));
+        std::stack<const PSAutomaton::Transit*> ts;
+        get_transits(id, gton, row, ts);
+        while (! ts.empty())
+        {
+            push(q, make<PSC1>(c, *_notes, *(ts.top())));
+            ts.pop();
+        }
+    }
+}
+
+
+// static
+const PSAutomaton::Transit*
+PSB::transit(const PSAutomaton::Row& row, const enum NoteName& name)
+{
+    for (const PSAutomaton::Transit& t : row)
+    {
+        if (t.defined() and t.name == name)
+            return &t;
+    }
+    return nullptr;
+}
+
+
+void PSB::get_transits(size_t id, const Ton& gton,
+                       const PSAutomaton::Row& row,
+                       std::stack<const PSAutomaton::Transit*>& ts) const
+{
+    // same selection as get_names, in the same order
+    const enum NoteName& forced = _notes->name(id);
+    // constrained spelling: the name and accid are known (forced)
+    if (forced != NoteName::Undef)
+    {
+        const PSAutomaton::Transit* t = transit(row, forced);
+        if (t == nullptr)
+        {
+            ERROR("PSB: no transition for note {} with name {}", id, forced);
+            return;
+        }
+        assert(t->accid == _notes->accidental(id));
+        ts.push(t);
+    }
+    // 3 potential successors in exhaustive search algo PSE
+    else if (_algo == Algo::PSE)
+    {
+        for (const PSAutomaton::Transit& t : row)
+        {
+            if (t.defined())
+                ts.push(&t);
+        }
+    }
+    // only 1 potential successor in determonistic variant PSD
+    else if (_algo == Algo::PSD)
+    {
+        int m = _notes->midipitch(id) % 12;
+        const PSAutomaton::Transit* t = transit(row, chromaname(gton, m));
+        assert(t);
+        ts.push(t);
+    }
+    else
+    {
+        ERROR ("Transition succ1: unexpected algo name {}", _algo);
+    }
+}
+
+
 void PSB::get_names(size_t id, const Ton& gton,
                     std::stack<enum NoteName>& names,
                     std::stack<enum Accid>& accids) const
                     //std::stack<bool>& prints) const
 {
-    unsigned int pm = _enum.midipitch(id);
+    unsigned int pm = _notes->midipitch(id);
     assert(MidiNum::check_midi(pm)); // assert(0 <= pm); assert(pm <= 128);
     // chroma in 0..11
     int m = pm % 12;
 
     // constrained spelling: the name and accid are known (forced)
     // only one potential successor
-    if (_enum.name(id) != NoteName::Undef)
+    if (_notes->name(id) != NoteName::Undef)
     {
-        assert(_enum.accidental(id) != Accid::Undef);
-        assert(Pitch::check_octave(_enum.octave(id)));
-        assert(_enum.octave(id) != Pitch::UNDEF_OCTAVE);
-        assert(MidiNum::to_midi(_enum.name(id), _enum.accidental(id),
-                                _enum.octave(id)) == pm);
-        names.push(_enum.name(id));
-        accids.push(_enum.accidental(id));
+        assert(_notes->accidental(id) != Accid::Undef);
+        assert(Pitch::check_octave(_notes->octave(id)));
+        assert(_notes->octave(id) != Pitch::UNDEF_OCTAVE);
+        assert(MidiNum::to_midi(_notes->name(id), _notes->accidental(id),
+                                _notes->octave(id)) == pm);
+        names.push(_notes->name(id));
+        accids.push(_notes->accidental(id));
     }
     // 3 potential successors in exhaustive search algo PSE
     // if ((_algo == Algo::PSE0) || (_algo == Algo::PSE1))
@@ -295,7 +701,7 @@ void PSB::get_names(size_t id, const Ton& gton,
         // assert(deg < 12);
         // enum NoteName name = scale.name(deg);
         // enum Accid accid = scale.accid(deg);
-        enum NoteName name = gton.chromaname(m);
+        enum NoteName name = chromaname(gton, m);
         enum Accid accid = MidiNum::class_to_accid(m, name);
         assert(defined(name));
         assert(defined(accid));
@@ -314,13 +720,13 @@ void PSB::get_names(size_t id, const Ton& gton,
 
 bool PSB::empty() const
 {
-    return _bests.empty();
+    return (size() == 0);
 }
 
 
 size_t PSB::size() const
 {
-    return _bests.size();
+    return _costonly?_ties:_paths.size();
 }
 
 
@@ -351,8 +757,15 @@ const PSC0& PSB::at(size_t i) const
 }
 
 
+bool PSB::configs() const
+{
+    return (_bests.size() == size());
+}
+
+
 const PSC0& PSB::top() const
 {
+    assert(configs());
     assert(! _bests.empty());
     //std::shared_ptr<const PSC0> psc = _bests.at(0);
     assert(_bests.at(0));
@@ -360,6 +773,32 @@ const PSC0& PSB::top() const
 }
 
 
+const PSP& PSB::path(size_t i) const
+{
+    assert(! _costonly);
+    assert(i < _paths.size());
+    assert(_paths.at(i));
+    return *(_paths.at(i));
+}
+
+
+bool PSB::rename() const
+{
+    if (_costonly)
+    {
+        ERROR("PSB rename {}-{}: no best path kept in cost-only mode",
+              _enum.first(), _enum.stop());
+        return false;
+    }
+    if (_paths.empty())
+    {
+        return _enum.empty();
+    }
+    path(0).rename();
+    return true;
+}
+
+
 //void PSB::pop()
 //{
 //    assert(! _bests.empty());
@@ -369,12 +808,14 @@ const PSC0& PSB::top() const
 
 PSCHeap::const_iterator PSB::cbegin() const
 {
+    assert(configs());
     return _bests.cbegin();
 }
 
 
 PSCHeap::const_iterator PSB::cend() const
 {
+    assert(configs());
     return _bests.cend();
 }
 
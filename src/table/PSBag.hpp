@@ -14,6 +14,8 @@
 #include <iostream>
 #include <assert.h>
 #include <vector>
+#include <array>
+#include <unordered_map>
 
 #include "pstrace.hpp"
 //#include "MTU.hpp"
@@ -22,18 +24,23 @@
 //#include "AEVisitor.hpp"
 //#include "Pitch.hpp"
 #include "PSEnum.hpp"
+#include "PSBarView.hpp"
 #include "Cost.hpp"
 #include "PSConfig0.hpp"
 #include "PSConfig1.hpp"
 #include "PSConfig1c.hpp"
-//#include "PSConfig2.hpp"
+#include "PSConfig2.hpp"
+#include "PSArena.hpp"
+#include "PSBMemo.hpp"
+#include "PSAutomaton.hpp"
+#include "PSPath.hpp"
+#include "PSCQueue.hpp"
 
 
 namespace pse {
 
 
 // PSCCompare defined in PSConfig0.hpp
-// PSCQueue defined in PSConfig0.hpp
 
 /// set of PS Configs
 typedef std::vector<std::shared_ptr<const PSC0>> PSCHeap;
@@ -43,6 +50,10 @@ typedef std::vector<std::shared_ptr<const PSC0>> PSCHeap;
 /// - all the configs in the bag have the same source
 ///   (initial config for the tonality).
 /// - all the configs in the bag have the same number of accidentals (best nb).
+/// The best paths are recorded in a compact path store (PSPStore),
+/// read by one PSP per best config, at the end of the search,
+/// so that the configs can be deallocated with the arena where they were
+/// allocated.
 class PSB
 {
 
@@ -73,11 +84,59 @@ public: // construction
     /// initial state.
     /// @param octave mode for the state transitions: repeat accidents
     /// at different octaves, or reason modulo 12.
+    /// @param arena memory pool for the allocation of the configs
+    /// during the search. If it is null, the configs are allocated in the heap
+    /// and the best configs are kept in this bag. Otherwise, only the best
+    /// paths are kept and all the configs are dead after construction,
+    /// so that the arena can be reset.
+    /// @param notes contiguous copy of the notes of e, read during the search.
+    /// If it is null, a copy is made by this bag.
+    /// Otherwise, it must have the same bounds as e
+    /// and must not be deallocated before this bag.
+    /// @param memo cache of results of searches, for bars with the same
+    /// notes. The result is read from the cache when it is found,
+    /// and stored in the cache after the search otherwise.
+    /// It requires an arena: the configs of a bag read from the cache
+    /// are not available, like the configs of a bag built with an arena.
+    /// Null for no caching, mandatory without arena.
+    /// @param automata collection of spelling automata, where the transitions
+    /// between configs are read (and added the first time).
+    /// It is not used if its bound on the number of states is reached.
+    /// Null for computing every transition during the search.
+    /// @param chroma names of the chromatic harmonic scale of ton,
+    /// by pitch class, read in a TonTable (for the deterministic algo PSD).
+    /// Null for querying ton.
+    /// @param astar A* mode: the configs are ordered in the search by their
+    /// cost plus a lower bound of the cost of the remaining notes.
+    /// The best paths are the same as without A*, but less configs
+    /// can be expanded.
+    /// @param costonly cost-only mode: only the cost and the number of
+    /// the best paths are kept in this bag, and all the configs, paths
+    /// and the data of the search are released after construction.
+    /// The best paths of such a bag cannot be accessed.
     /// @see State constructor for tonal/modal mode
     PSB(const Algo& a, const Cost& seed, PSEnum& e,
-        bool tonal, bool octave, 
-        const Ton& ton, const Ton& lton = Ton());
-    
+        bool tonal, bool octave,
+        const Ton& ton, const Ton& lton = Ton(),
+        PSArena* arena = nullptr,
+        const PSBarView* notes = nullptr,
+        PSBMemo* memo = nullptr,
+        PSAutomata* automata = nullptr,
+        const enum NoteName* chroma = nullptr,
+        bool astar = false,
+        bool costonly = false);
+
+    /// bag of best paths computed without search,
+    /// e.g. by the lanes of the deterministic algorithm PSD (see PSL).
+    /// @param a name of pitch-spelling algorithm implemented.
+    /// @param e an enumerator of notes. it must have the same length as
+    /// the paths in store.
+    /// @param cost cumulated cost of the paths.
+    /// @param store compact store of the best paths, shared with this bag.
+    /// @warning the bag is empty if e is empty.
+    PSB(const Algo& a, PSEnum& e, const Cost& cost,
+        std::shared_ptr<const PSPStore> store);
+
     /// a bag cannot be copied.
     PSB(const PSB& rhs) = delete;
 
@@ -92,30 +151,60 @@ public: // access
     /// whether this bag is empty.
     bool empty() const;
     
-    /// number of PS Configs in this bag.
+    /// number of best paths in this bag.
     size_t size() const;
     
     /// cost of the best path in this bag.
     const Cost& cost() const;
     
+    /// whether the target configs of the best paths are kept in this bag.
+    /// They are not kept when the bag was built with an arena (the configs
+    /// are dead after the search), read from a cache, computed by lanes,
+    /// or in cost-only mode. Only the best paths are available then.
+    bool configs() const;
+
     /// access one PS config in this bag.
-    /// @warning this bag must not be empty.
+    /// @warning this bag must not be empty and its configs must be kept.
+    /// @see configs()
     const PSC0& top() const;
+
+    /// best path of given index in this bag.
+    /// @param i index of a best path. must be smaller than size().
+    /// @warning this bag must not be in cost-only mode.
+    const PSP& path(size_t i = 0) const;
     
     // remove the top PS config of this bag.
     // @warning this bag must not be empty.
     // void pop();
     
     /// iterator pointing to the first element in this bag.
+    /// @warning the configs of this bag must be kept.
+    /// @see configs()
     PSCHeap::const_iterator cbegin() const;
     
     /// iterator pointing to the past-the-end element in this bag.
+    /// @warning the configs of this bag must be kept.
+    /// @see configs()
     PSCHeap::const_iterator cend() const;
     
     /// rename all notes in input used to build this bag,
     /// according to the best path in the bag.
     /// @return whether renaming succeeded for this bag.
-    bool rename();
+    /// It fails if this bag is in cost-only mode.
+    bool rename() const;
+
+    /// whether this bag was built in cost-only mode:
+    /// it has a cost and a number of best paths but no best path.
+    inline bool costonly() const { return _costonly; }
+
+    /// number of configs discarded during the search because they were
+    /// dominated by an equivalent config of smaller cost.
+    inline size_t dominated() const { return _dominated; }
+
+    /// number of configs expanded during the search (their successors
+    /// were computed). The work saved by A* is the difference with the
+    /// number of configs expanded by a search without lower bound.
+    inline size_t expanded() const { return _expanded; }
     
 private: // data
     
@@ -126,12 +215,43 @@ private: // data
     /// @todo replace by flag: exhaustive or deterministic choice of names
     Algo _algo;
     
-    /// enumerator of notes for computing transitions between configs.
+    /// enumerator of notes for the best paths and the renaming.
     PSEnum& _enum;
+
+    /// copy of the notes of the enumerator, owned by this bag,
+    /// when no copy was given at construction.
+    std::unique_ptr<const PSBarView> _ownnotes;
+
+    /// contiguous copy of the notes of the enumerator,
+    /// for computing transitions between configs.
+    /// null if the enumerator is empty.
+    const PSBarView* _notes;
     
+    /// memory pool for the configs allocated during the search.
+    /// null for allocation in the heap.
+    PSArena* _arena;
+
+    /// spelling automaton for the tonalities and cost type of the search.
+    /// null if the transitions are computed during the search,
+    /// and after the search (the automata can be cleared).
+    PSAutomaton* _automaton;
+
+    /// names of the chromatic harmonic scale of the global tonality,
+    /// by pitch class. null if they are queried to the tonality.
+    const enum NoteName* _chroma;
+
     /// bag of final configs of best paths.
+    /// emptied after the search when the configs are allocated in an arena.
     PSCHeap _bests;
 
+    /// compact store of the best paths, possibly shared with a cache of
+    /// results of searches. null if the enumerator is empty.
+    std::shared_ptr<const PSPStore> _store;
+
+    /// one best path for each final config found by the search,
+    /// read in the store.
+    std::vector<std::unique_ptr<const PSP>> _paths;
+
     // bag of non-final configs involved in best paths.
     // for rollback of best path.
     // useless: they are stored in _prev
@@ -140,6 +260,52 @@ private: // data
     /// cost of the best config in the bag.
     std::shared_ptr<Cost> _cost;
 
+    /// cost-only mode: the best paths are not kept in this bag.
+    bool _costonly;
+
+    /// number of best paths found by the search, in cost-only mode.
+    size_t _ties;
+
+    /// number of configs pruned by dominance during the search.
+    size_t _dominated;
+
+    /// number of configs expanded during the search.
+    size_t _expanded;
+
+    /// spellings of a note considered for the A* bound.
+    struct Bound
+    {
+        /// names and accidentals of the spellings, Undef if unused.
+        std::array<enum NoteName, 3> names;
+        std::array<enum Accid, 3> accids;
+        std::array<int, 3> octs;
+
+        /// minimal increment of the first component of cost for a transition
+        /// spelling the note with a printed accidental.
+        size_t print;
+    };
+
+    /// A* mode.
+    bool _astar;
+
+    /// data for A* bound, by note (index from first note of enumerator).
+    std::vector<Bound> _bounds;
+
+    /// for every position, the notes after it which are the first occurrence
+    /// of their pitch class (or MIDI key in octave mode) from this position.
+    /// the notes for position i are in _firsts[_ifirsts[i].._ifirsts[i+1]).
+    std::vector<size_t> _firsts;
+    std::vector<size_t> _ifirsts;
+
+    /// spellings of the chords of the bar, by set of pitch classes,
+    /// for the global tonality of this bag (the candidate names
+    /// only depend on the pitch class and the tonality).
+    mutable std::unordered_map<uint16_t,
+                               std::vector<PSChordSpelling>> _spellings;
+
+    /// spellings of the last chord with constrained names (not cached).
+    mutable std::vector<PSChordSpelling> _constrained;
+
     // backup of visited non-terminal nodes (pointed as previous).
     // std::vector<std::shared_ptr<const PSC0>> _visited;
     // @todo TBR
@@ -175,11 +341,87 @@ private:
     /// @param q priority queue receiving the target configs.
     void succ(std::shared_ptr<const PSC0> c, PSCQueue& q,
               const Ton& gton, const Ton& lton = Ton()) const;
+
+    /// all the spellings of the chord starting at the given note,
+    /// with one name for each pitch class, chosen among the names
+    /// for the first occurrence of this pitch class (see get_names).
+    /// They are computed once for each set of pitch classes,
+    /// when no name is constrained in the chord.
+    /// @param id index of the first note of a chord.
+    /// @param gton conjectured main (global) tonality (key signature).
+    /// @return the spellings, valid until the next call.
+    const std::vector<PSChordSpelling>& spellings(size_t id,
+                                                  const Ton& gton) const;
+
+    /// same as succ, with the transitions of the automaton.
+    /// @param c source configuration, built with the automaton.
+    /// @param gton conjectured main (global) tonality (key signature).
+    /// @param q priority queue receiving the target configs.
+    void succ_automaton(std::shared_ptr<const PSC0> c, PSCQueue& q,
+                        const Ton& gton) const;
     
+    /// push a config to the queue of the search,
+    /// with its lower bound in A* mode.
+    void push(PSCQueue& q, std::shared_ptr<const PSC0> c) const;
+
+    /// compute the data for the A* bound.
+    /// @see init for the parameters.
+    void initBounds(const Cost& seed, const Ton& gton, const Ton& lton,
+                    bool octave);
+
+    /// admissible lower bound for the cost of the paths from the given
+    /// config to the end of the bar: for every pitch class (or MIDI key
+    /// in octave mode) of the remaining notes, whose spellings are not
+    /// in the state of the config, an accidental must be printed at its
+    /// first occurrence.
+    /// @return the bound on the first component of the cost.
+    size_t bound(const PSC0& c) const;
+
+    /// record the best paths targeting the configs of _bests in the store.
+    /// and release the configs if they were allocated in the arena.
+    void pin();
+
+    /// copy the best paths of a result computed before for the same notes.
+    /// In cost-only mode, only the cost and number of best paths are copied.
+    /// @param entry result of a search for a bar with the same notes.
+    void load(const PSBMemo::Entry& entry);
+
+    /// cost-only mode: keep the number of best paths and release
+    /// the best configs, the best paths and the data of the search.
+    void release();
+
+    /// copy of the best paths of this bag, to be cached.
+    /// In cost-only mode, only the cost and number of best paths are copied.
+    std::shared_ptr<const PSBMemo::Entry> record() const;
+
+    /// allocate a new config in the arena, or in the heap if there is no arena.
+    template<class C, class... Args>
+    std::shared_ptr<const C> make(Args&&... args) const;
+
     void get_names(size_t id, const Ton& gton,
                    std::stack<enum NoteName>& names,
                    std::stack<enum Accid>& accids) const;
                    // std::stack<bool>& prints) const;
+
+    /// select the transitions of the given row for the note of given index,
+    /// like get_names.
+    /// @param id index of a note in enumerator.
+    /// @param gton conjectured main (global) tonality (key signature).
+    /// @param row transitions from a state when reading the note.
+    /// @param ts stack receiving the transitions selected.
+    void get_transits(size_t id, const Ton& gton,
+                      const PSAutomaton::Row& row,
+                      std::stack<const PSAutomaton::Transit*>& ts) const;
+
+    /// name of the given pitch class in the chromatic harmonic scale
+    /// of the given global tonality.
+    inline enum NoteName chromaname(const Ton& gton, unsigned int pc) const
+    { return _chroma?_chroma[pc]:gton.chromaname(pc); }
+
+    /// the transition of the given row for the given name.
+    /// @return null if there is none.
+    static const PSAutomaton::Transit*
+    transit(const PSAutomaton::Row& row, const enum NoteName& name);
         
     /// access one PS config in this bag.
     /// @param i index of an element of this bag.
@@ -0,0 +1,78 @@
+//
+//  PSCQueue.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include <algorithm>
+
+#include "PSCQueue.hpp"
+
+
+namespace pse {
+
+
+PSCQueue::PSCQueue():
+_buckets(),
+_current(0),
+_size(0),
+_order()
+{ }
+
+
+PSCQueue::~PSCQueue()
+{ }
+
+
+const std::shared_ptr<const PSC0>& PSCQueue::top()
+{
+    assert(! empty());
+    advance();
+    assert(_current < _buckets.size());
+    assert(! _buckets[_current].empty());
+    return _buckets[_current].front();
+}
+
+
+void PSCQueue::push(std::shared_ptr<const PSC0> c, size_t bound)
+{
+    assert(c);
+    size_t b = c->cost().primary() + bound;
+    if (b >= _buckets.size())
+        _buckets.resize(b + 1);
+    // non monotone push (not expected in the search)
+    if (b < _current)
+        _current = b;
+    std::vector<std::shared_ptr<const PSC0>>& bucket = _buckets[b];
+    bucket.push_back(std::move(c));
+    std::push_heap(bucket.begin(), bucket.end(), _order);
+    ++_size;
+}
+
+
+void PSCQueue::pop()
+{
+    assert(! empty());
+    advance();
+    assert(_current < _buckets.size());
+    std::vector<std::shared_ptr<const PSC0>>& bucket = _buckets[_current];
+    assert(! bucket.empty());
+    std::pop_heap(bucket.begin(), bucket.end(), _order);
+    bucket.pop_back();
+    --_size;
+}
+
+
+void PSCQueue::advance()
+{
+    while (_current < _buckets.size() and _buckets[_current].empty())
+        ++_current;
+}
+
+
+} // namespace pse
+
+/// @}
@@ -0,0 +1,93 @@
+//
+//  PSCQueue.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef PSCQueue_hpp
+#define PSCQueue_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <vector>
+#include <memory>
+
+#include "pstrace.hpp"
+#include "PSConfig0.hpp"
+#include "PSOrder.hpp"
+
+
+namespace pse {
+
+
+/// monotone bucket queue of PS Configs (Dial's algorithm),
+/// for the best path search of PSB.
+/// The configs are distributed in buckets indexed by the first component
+/// of their cost (Cost::primary), which is a small integer, non-decreasing
+/// along the transitions of the search.
+/// Every bucket is a binary heap ordered by PSClex (smallest cost,
+/// then largest note index), hence the order of extraction is the order
+/// of PSClex, as with a priority queue.
+/// The current bucket is the smallest non-empty bucket;
+/// it only moves forward when the pushed configs are not smaller
+/// than the last config popped.
+/// In A* mode, a config is pushed with a lower bound of the cost of its
+/// completions, added to the first component of its cost
+/// for the choice of its bucket.
+class PSCQueue
+{
+public:
+
+    /// empty queue.
+    PSCQueue();
+
+    ~PSCQueue();
+
+    /// the queue is empty.
+    inline bool empty() const { return (_size == 0); }
+
+    /// number of configs in the queue.
+    inline size_t size() const { return _size; }
+
+    /// smallest config in the queue.
+    /// @warning the queue must not be empty.
+    const std::shared_ptr<const PSC0>& top();
+
+    /// add a config to the queue.
+    /// @param c a config.
+    /// @param bound lower bound of the first component of the cost
+    /// of the remaining transitions from c, for A* search.
+    void push(std::shared_ptr<const PSC0> c, size_t bound = 0);
+
+    /// remove the smallest config from the queue.
+    /// @warning the queue must not be empty.
+    void pop();
+
+private:
+
+    /// buckets, indexed by first component of cost.
+    std::vector<std::vector<std::shared_ptr<const PSC0>>> _buckets;
+
+    /// index of the smallest bucket possibly non-empty.
+    size_t _current;
+
+    /// total number of configs in the buckets.
+    size_t _size;
+
+    /// ordering of the heaps of the buckets.
+    PSClex _order;
+
+    /// move the current bucket to the first non-empty bucket.
+    void advance();
+
+};
+
+
+} // namespace pse
+
+#endif /* PSCQueue_hpp */
+
+/// @}
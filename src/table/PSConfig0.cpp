@@ -26,6 +26,7 @@ namespace pse {
 PSC0::PSC0(const Ton& ton, size_t id, const Cost& seed,
            bool tonal, bool octave):
 _state(nullptr),
+_sid(PSAutomaton::NOSTATE),
 _id(id),
 _cost(seed.shared_zero()) // zero
 {
@@ -42,6 +43,16 @@ _cost(seed.shared_zero()) // zero
 }
 
 
+PSC0::PSC0(const PSAutomaton& a, size_t id, const Cost& seed):
+_state(nullptr), // stored in the automaton
+_sid(PSAutomaton::INITIAL),
+_id(id),
+_cost(seed.shared_zero()) // zero
+{
+    assert(a.states() > 0);
+}
+
+
 //PSC0::PSC0(const KeySig& ks, size_t i):
 //_state(ks),
 //_id(i),
@@ -60,9 +71,10 @@ _cost(seed.shared_zero()) // zero
 //{ }
 
 
-// deep copy
+// shared state, deep copy of cost
 PSC0::PSC0(const PSC0& rhs):
-_state(rhs._state->clone()),
+_state(rhs._state),
+_sid(rhs._sid),
 _id(rhs._id),
 _cost(rhs._cost->shared_clone())
 {
@@ -81,7 +93,8 @@ PSC0& PSC0::operator=(const PSC0& rhs)
     if (this != &rhs)
     {
         assert(rhs._state);
-        _state = rhs._state->clone();
+        _state = rhs._state;
+        _sid   = rhs._sid;
         _id    = rhs._id;
         _cost  = rhs._cost;  // copy
     }
@@ -91,9 +104,14 @@ PSC0& PSC0::operator=(const PSC0& rhs)
 
 bool PSC0::operator==(const PSC0& rhs) const
 {
+    if (_id != rhs._id)
+        return false;
+    else if ((_sid != PSAutomaton::NOSTATE) or
+             (rhs._sid != PSAutomaton::NOSTATE))
+        return (_sid == rhs._sid);
     assert(_state);
     assert(rhs._state);
-    return (_id == rhs._id) and _state->equal(*(rhs._state));
+    return _state->equal(*(rhs._state));
 }
 
 
@@ -103,6 +121,30 @@ bool PSC0::operator!=(const PSC0& rhs) const
 }
 
 
+bool PSC0::equivalent(const PSC0& rhs) const
+{
+    if ((_id != rhs._id) or (inChord() != rhs.inChord()))
+        return false;
+    // the states of an automaton are pairwise not equivalent
+    else if ((_sid != PSAutomaton::NOSTATE) or
+             (rhs._sid != PSAutomaton::NOSTATE))
+        return (_sid == rhs._sid);
+    assert(_state);
+    assert(rhs._state);
+    return _state->equivalent(*(rhs._state));
+}
+
+
+size_t PSC0::hash() const
+{
+    assert(_state or (_sid != PSAutomaton::NOSTATE));
+    size_t h = (_sid != PSAutomaton::NOSTATE)?_sid:_state->hash();
+    h = PSState0::hashmix(h, _id);
+    h = PSState0::hashmix(h, inChord()?1:0);
+    return h;
+}
+
+
 bool PSC0::initial() const
 {
     return true;
@@ -27,6 +27,7 @@
 #include "PSEnum.hpp"
 #include "Cost.hpp"
 // #include "Costt.hpp"
+#include "PSAutomaton.hpp"
 
 
 namespace pse {
@@ -38,10 +39,7 @@ class PSC0;
 using PSCCompare = std::function<bool(std::shared_ptr<const PSC0>&,
                                       std::shared_ptr<const PSC0>&)>;
 
-/// priority queue of PS Configs
-typedef std::priority_queue<std::shared_ptr<const PSC0>,
-                            std::vector<std::shared_ptr<const PSC0>>,
-                            PSCCompare> PSCQueue;
+// priority queue of PS Configs: PSCQueue, defined in PSCQueue.hpp
 
 /// Configuration for a pitch spelling algorithm of scope 1 bar.
 /// Configurations of this class are always initial in a best path solution
@@ -66,6 +64,15 @@ public: // construction
     PSC0(const Ton& ton, size_t id, const Cost& seed,
          bool tonal, bool octave);
 
+    /// initial configuration in the initial state of a spelling automaton.
+    /// predecessor configuration will be null.
+    /// @param a a spelling automaton for the tonality.
+    /// @param id index (in a note enumerator) of the note to read
+    /// in order to reach the successor configs from this config.
+    /// @param seed cost value of specialized type
+    /// (to create a cost of the same type).
+    PSC0(const PSAutomaton& a, size_t id, const Cost& seed);
+
     // initial config for a given key signature.
     // @param init index of last note read to reach this configuration.
     // PSC0(const KeyFifth& ks, size_t init=0);
@@ -74,7 +81,9 @@ public: // construction
     // @param init index of last note read to reach this configuration
     // PSC0(const PSState& s, size_t init=0);
 
-    /// copy constructor
+    /// copy constructor.
+    /// the state is shared (states are not modified after construction)
+    /// and the cost is cloned.
     PSC0(const PSC0& s);
 
     virtual ~PSC0();
@@ -90,6 +99,17 @@ public: // comparison
     /// configs have different list of accidentals
     bool operator!=(const PSC0& rhs) const;
 
+    /// this config and rhs have the same successors, with the same
+    /// cost updates: same note index, equivalent states and,
+    /// for configs in a chord, same chord bookkeeping.
+    /// Of two equivalent configs, the one of higher cost is dominated.
+    /// @see PSB::init
+    virtual bool equivalent(const PSC0& rhs) const;
+
+    /// hash value of this config, compatible with equivalent
+    /// for configs all built with the same automaton, or all without.
+    virtual size_t hash() const;
+
 public: // access
 
     /// this configuration is initial in a best path.
@@ -120,8 +140,14 @@ public: // access
     // PSEnum& psenum() const;
     
     /// state associated to this configuration.
+    /// @warning this config must have been built without automaton.
+    /// the states of an automaton are only stored in the automaton.
     const PSState0& state() const;
 
+    /// index of the state of this configuration in a spelling automaton,
+    /// or PSAutomaton::NOSTATE if it was not built with an automaton.
+    inline size_t sid() const { return _sid; }
+
     /// index (in enumerator) of note read for the transition from
     /// this config to its successors.
     size_t id() const;
@@ -178,7 +204,14 @@ protected: // data
     /// description of accidents for each note name.
     /// @todo 1. replace by std::shared_ptr<PSState>
     /// @todo 2. replace by std::shared_ptr<PSState0> (polymorphic)
-    std::shared_ptr<PSState0> _state;
+    /// not modified after the construction of the config,
+    /// and possibly shared with other configs.
+    /// null for a config built with an automaton.
+    std::shared_ptr<const PSState0> _state;
+
+    /// index of the state of this config in a spelling automaton,
+    /// or PSAutomaton::NOSTATE for a config built without automaton.
+    size_t _sid;
 
     // description of discounted accident for each note name.
     // will not be updated.
@@ -21,7 +21,7 @@ PSC1::PSC1(std::shared_ptr<const PSC0> c, const PSEnum& e,
            const enum NoteName& name, const enum Accid& accid,
            bool cprint,
            const Ton& gton, const Ton& lton):
-PSC(c),       // clone the state
+PSC(c),       // share the state
 _name(name),
 _print(false)
 {
@@ -33,10 +33,13 @@ _print(false)
     int octave = MidiNum::midi_to_octave(_midi, name);
     assert(Pitch::check_octave(octave));
     assert(_state);
-    // name of pitch class read in the _state before update
-    const enum NoteName prev_name = _state->lastName(midi()%12);
+    std::shared_ptr<PSState0> state = _state->clone();
+    // name of pitch class read in the state before update
+    const enum NoteName prev_name = state->lastName(midi()%12);
     // change state
-    _print = _state->update(accid, name, octave);
+    _print = state->update(accid, name, octave);
+    _state = state;
+    _sid = PSAutomaton::NOSTATE;
     _id = c->id()+1; // next note in enum
     // assert(_id <= e.stop());
     // name of pitch class read in the _state after update
@@ -55,6 +58,29 @@ _print(false)
 }
 
 
+// copy and follow a transition of automaton
+PSC1::PSC1(std::shared_ptr<const PSC0> c, const PSEnum& e,
+           const PSAutomaton::Transit& t):
+PSC(c),       // share the state
+_name(t.name),
+_print(t.print)
+{
+    assert(c);
+    assert(c->sid() != PSAutomaton::NOSTATE);
+    assert(_state == nullptr);
+    assert(t.defined());
+    assert(t.target != PSAutomaton::NOSTATE);
+    assert(t.delta);
+    _midi = e.midipitch(c->id());
+    assert(t.accid == MidiNum::midi_to_accid(_midi, t.name));
+    _sid = t.target;
+    _id = c->id()+1; // next note in enum
+    // update cost
+    assert(_cost);
+    *_cost += *(t.delta);
+}
+
+
 //PSC1::PSC1(const PSC0& c, const PSEnum& e,
 //           const NoteName& name, const Accid& accid,
 //           const Ton& ton):
@@ -165,8 +191,8 @@ enum Accid PSC1::accidental() const
     // ex: enum Accid accid(_state.accids(_name)); // copy
     enum Accid accid = MidiNum::midi_to_accid(_midi, _name);
     assert(defined(accid));
-    assert(_state);
-    assert(Accids::contained(accid, _state->accids(_name, octave())));
+    assert((_state == nullptr) or
+           Accids::contained(accid, _state->accids(_name, octave())));
     //assert(-2 <= toint(accid) and toint(accid) <= 2);
     return accid; // cast to float format for Pitch ?
 }
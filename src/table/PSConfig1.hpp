@@ -61,6 +61,17 @@ public: // construction
          bool count_print,
          const Ton& gton, const Ton& lton = Ton());
 
+    /// target PS config for a transition of a spelling automaton
+    /// from a given (previous) PS config, when reading a pitch.
+    /// copy and follow the transition: the state is replaced by the target
+    /// of the transition and the cost is incremented.
+    /// @param c previous config, in the source state of the transition.
+    /// it must have been built with the automaton.
+    /// @param e an enumerator of notes read for transition to this configs.
+    /// @param t a defined transition for the note of c.
+    PSC1(std::shared_ptr<const PSC0> c, const PSEnum& e,
+         const PSAutomaton::Transit& t);
+
     // PSC1(const PSC0& c,
     //      const PSEnum& e, // unsigned int mp,
     //      const NoteName& name, const Accid& acc,
@@ -33,60 +33,65 @@ namespace pse {
 
 
 PSC1c::PSC1c(std::shared_ptr<const PSC0> c,
-             const PSEnum& e,
+             const PSBarView& e,
              const enum NoteName& name,
              const enum Accid& accid,
              const Ton& gton,
              const Ton& lton):
 PSC1(c, e, name, accid, false, gton, lton), // no force print
-_chord(new PSChord(e, c->id())),
+_chord(init_chord(*c, e)),
+_stop(e.chords().chord(_chord).stop),
 _pcn(), // empty
 _pcp(), // empty
-_complete(_chord->empty())
+_complete(_id == _stop)
 {
     assert(c);
-    assert(c->id() == _chord->first());
     assert(defined(accid));
     assert(gton.defined());
     _pcn.fill(NoteName::Undef);
     _pcp.fill(false);
-    post_init(*c, *_chord);
+    post_init(*c);
 }
 
 
 // note with new pitch class
 PSC1c::PSC1c(std::shared_ptr<const PSC1c> c,
+             const PSBarView& e,
              const enum NoteName& name,
              const enum Accid& accid,
              bool force_print,
              const Ton& gton,
              const Ton& lton):
-PSC1(c, c->chord(), name, accid, force_print, gton, lton),
-_chord(init_chord(c.get())), // pointer copy of chord currently processed
+PSC1(c, e, name, accid, force_print, gton, lton),
+_chord(c->_chord), // index of chord currently processed
+_stop(c->_stop),
 _pcn(c->_pcn),
 _pcp(c->_pcp),
-_complete(_id == _chord->stop())
+_complete(_id == _stop)
 {
     assert(c);
     assert(gton.defined());
     //assert((force_print == false) == (_pcn[m] == NoteName::Undef));
-    post_init(*c, *_chord);
+    post_init(*c);
 }
 
 
-std::shared_ptr<const PSChord> PSC1c::init_chord(const PSC1c* c) const
+// static
+uint32_t PSC1c::init_chord(const PSC0& c, const PSBarView& e)
 {
-    assert(c);
-    assert(c->_chord);
-    return c->_chord;
+    uint32_t k = e.chords().index(c.id());
+    assert(k != PSChords::NOCHORD);
+    // c.id() is the first note of the chord
+    assert(e.chords().chord(k).first == c.id());
+    return k;
 }
 
-void PSC1c::post_init(const PSC0& c, const PSChord& chord)
+
+void PSC1c::post_init(const PSC0& c)
 {
     // c.id() is the note processed and _id is the next
-    assert(chord.first() <= c.id());
-    assert(c.id() < chord.stop());
-    assert(_midi == chord.midipitch(c.id()));
+    assert(c.id() < _stop);
+    assert(_id <= _stop);
     assert(defined(_name));
     // update the internal store deja vu of pitch class
     // if first time pitch class is seen in chord
@@ -132,7 +137,10 @@ void PSC1c::post_init(const PSC0& c, const PSChord& chord)
 
 PSC1c::PSC1c(const PSC1c& c):
 PSC1(c),
+_chord(c._chord),
+_stop(c._stop),
 _pcn(c._pcn),
+_pcp(c._pcp),
 _complete(c._complete)
 { }
 
@@ -149,7 +157,10 @@ PSC1c& PSC1c::operator=(const PSC1c& rhs)
     if (this != &rhs)
     {
         PSC1::operator=(rhs);
+        _chord = rhs._chord;
+        _stop = rhs._stop;
         _pcn  = rhs._pcn;
+        _pcp  = rhs._pcp;
         _complete = rhs._complete;
     }
     return *this;
@@ -170,6 +181,25 @@ bool PSC1c::operator!=(const PSC1c& rhs) const
 }
 
 
+bool PSC1c::equivalent(const PSC0& rhs) const
+{
+    if (! PSC0::equivalent(rhs))
+        return false;
+    assert(rhs.inChord());
+    const PSC1c& rhsc = dynamic_cast<const PSC1c&>(rhs);
+    return ((_pcn == rhsc._pcn) && (_complete == rhsc._complete));
+}
+
+
+size_t PSC1c::hash() const
+{
+    size_t h = PSC0::hash();
+    for (const enum NoteName& n : _pcn)
+        h = PSState0::hashmix(h, static_cast<size_t>(toint(n)));
+    return h;
+}
+
+
 enum NoteName PSC1c::dejavu(unsigned int pc) const
 {
     assert(0 <= pc);
@@ -198,14 +228,6 @@ bool PSC1c::inChord() const
 }
 
 
-const PSChord& PSC1c::chord() const
-{
-    assert(_chord);
-    return *(_chord);
-}
-
-
-
 } // end namespace pse
 
 /// @}
@@ -20,7 +20,8 @@
 #include "NoteName.hpp"
 #include "Accid.hpp"
 #include "Ton.hpp"
-#include "PSChord.hpp"
+#include "PSBarView.hpp"
+#include "PSChords.hpp"
 #include "PSConfig1.hpp"
 
 
@@ -44,12 +45,13 @@ public: // construction
     /// configuration reached with the first note in the given chord.
     /// @param c previous config, to be updated with the received pitch.
     /// @param e an enumerator of notes read for transition to this configs.
+    /// The chord starting at the note of c is found in its table of chords.
     /// @param name chosen name for the received pitch, in 0..6 (0 is 'C', 6 is 'B').
     /// @param accid chosen alteration for the received pitch, in -2..2.
     /// @param gton conjectured main (global) tonality (key signature).
     /// @param lton conjectured local tonality, undef if it is not known yet.
     PSC1c(std::shared_ptr<const PSC0> c,
-          const PSEnum& e,
+          const PSBarView& e,
           const enum NoteName& name,
           const enum Accid& accid,
           const Ton& gton,
@@ -57,7 +59,7 @@ public: // construction
       
     /// next PSC1c for the processing of one note in the given chord.
     /// @param c previous config (origin), to be updated with the received pitch.
-    // @param chord an enumerator of notes in chord currently processed.
+    /// @param e an enumerator of notes read for transition to this configs.
     /// @param name chosen name for the received pitch,
     /// or undef if the current pitch class was already met.
     /// @param accid chosen alteration for the received pitch,
@@ -70,6 +72,7 @@ public: // construction
     /// or undef if it was not yet estimated
     /// or if the current pitch class was already met.
     PSC1c(std::shared_ptr<const PSC1c> c,
+          const PSBarView& e,
           const enum NoteName& name,
           const enum Accid& accid,
           bool force_print,
@@ -105,6 +108,14 @@ public: // comparison
     /// configs have different list of accidentals
     bool operator!=(const PSC1c& rhs) const;
 
+    /// this config and rhs have the same successors, with the same
+    /// cost updates. It includes the names chosen for the pitch classes
+    /// already met in the current chord.
+    bool equivalent(const PSC0& rhs) const override;
+
+    /// hash value of this config, compatible with equivalent.
+    size_t hash() const override;
+
 public: // access
 
     /// @param pc a pitch class in 0..11.
@@ -120,16 +131,21 @@ public: // access
     /// the processing of the chord is terminated.
     bool complete() const;
     
-    /// the chord currently processed.
-    const PSChord& chord() const;
+    /// index of the chord currently processed,
+    /// in the table of chords of the enumerator of notes.
+    inline size_t chord() const { return _chord; }
 
     /// we are currently processing a chord.
     bool inChord() const override;
         
 private: // data
 
-    /// chord currently processed.
-    std::shared_ptr<const PSChord> _chord;
+    /// index of the chord currently processed,
+    /// in the table of chords of the enumerator of notes.
+    uint32_t _chord;
+
+    /// index of the note after the last note of the chord processed.
+    size_t _stop;
     
     /// map associating to every pitch class in 0..12
     /// a note name, if the pitch class was encountered
@@ -142,17 +158,16 @@ private: // data
     /// while processing the chord.
     std::array<bool, 12> _pcp;
 
-    /// index of the note after the last note of the chord processed.
+    /// the processing of the chord is terminated.
     bool _complete;
     
 private: // construction
     
-    /// internal constructor.
-    PSC1c(const PSC& c, PSChord& chord);
-    
-    void post_init(const PSC0& c, const PSChord& chord);
-    
-    std::shared_ptr<const PSChord> init_chord(const PSC1c* c) const;
+    /// index of the chord starting at the note of c,
+    /// in the table of chords of e.
+    static uint32_t init_chord(const PSC0& c, const PSBarView& e);
+
+    void post_init(const PSC0& c);
     
 };
 
@@ -18,104 +18,101 @@
 #include <vector>
 
 #include "pstrace.hpp"
+#include "NoteName.hpp"
 #include "Accid.hpp"
-#include "PSConfig0.hpp"
+#include "Ton.hpp"
+#include "PSBarView.hpp"
 #include "PSConfig.hpp"
-#include "PSEnum.hpp"
-#include "PSChord.hpp"
-#include "PSConfig1c.hpp"
+
 
 namespace pse {
 
+/// spelling of a chord: one name for each pitch class of the chord,
+/// and NoteName::Undef for the pitch classes not in the chord.
+using PSChordSpelling = std::array<enum NoteName, 12>;
+
 /// target config of transition,
 /// reached from its predecessor by spelling several simultaneous notes
-/// (a "chord").
+/// (a "chord") in one step.
 /// It extends of PSC0 with annotations for the chord read:
 /// - the chosen names for the input notes
 /// - print flags
 /// see PSC1 for the meaning of these extensions.
 ///
+/// The notes of the chord read are the simultaneous notes from the note of
+/// the predecessor, and the state and cost are updated note by note,
+/// with the same name for every occurrence of a pitch class,
+/// exactly as with a sequence of PSC1c.
+/// The last note of the chord (not simultaneous with the next note)
+/// is not read by this transition.
+///
 /// Configurations of this class are always non-initial
 /// in a best path solution for pitch spelling.
 class PSC2 : public PSC
 {
-    
 public: // construction
 
     /// target PS config for a transition from given (previous) config,
     /// when reading a chord.
-    /// @param c0 previous config, to be updated with the received chord.
-    /// @param c1 last config reached when processing the chord.
-    /// @param chord note enumerator containing the notes of the read chord.
-    PSC2(std::shared_ptr<const PSC0> c0,
-         std::shared_ptr<const PSC1c> c1,
-         PSChord& chord);
+    /// @param c previous config, to be updated with the received chord.
+    /// the note of c must be simultaneous with the next note.
+    /// @param e enumerator of notes containing the chord.
+    /// @param names chosen names for the pitch classes of the chord.
+    /// @param gton conjectured main (global) tonality (key signature).
+    /// @param lton conjectured local tonality, undef if it is not known yet.
+    PSC2(std::shared_ptr<const PSC0> c,
+         const PSBarView& e,
+         const PSChordSpelling& names,
+         const Ton& gton,
+         const Ton& lton = Ton());
+
+    /// target PS config for a chord transition of a spelling automaton
+    /// from a given (previous) PS config, when reading a chord.
+    /// copy and follow the transition: the state is replaced by the target
+    /// of the transition and the cost is incremented.
+    /// @param c previous config, must contain a state of automaton.
+    /// the note of c must be simultaneous with the next note.
+    /// @param e enumerator of notes containing the chord.
+    /// @param names chosen names for the pitch classes of the chord.
+    /// @param t transition of automaton from the state of c,
+    /// for the chord and the names.
+    PSC2(std::shared_ptr<const PSC0> c,
+         const PSBarView& e,
+         const PSChordSpelling& names,
+         const PSAutomaton::ChordTransit& t);
 
     /// copy constructor
     PSC2(const PSC2& c);
-    
+
     virtual ~PSC2();
-    
+
     /// assignement operator
     PSC2& operator=(const PSC2& rhs);
 
 public: // comparison
-    
+
     /// configs have the same list of accidentals
     bool operator==(const PSC2& rhs) const;
-    
+
     /// configs have different list of accidentals
     bool operator!=(const PSC2& rhs) const;
 
 public: // access
 
-    // bool acceptable(const enum NoteName& name, const enum Accid& accid) const;
-    
     /// number of simultaneous note in chord read to reach this config.
     size_t size() const;
 
-    /// midi pitch of the ith note read for the transition
-    /// from this config's predecessor.
-    /// @param i index of the note in the input chord in 0..size()-1.
-    unsigned int midi(size_t i) const;
-
     /// name of the note read for the transition from this config's predecessor.
     /// in 0..6 (0 is 'C', 6 is 'B').
     /// @param i index of the note in the input chord in 0..size()-1.
     /// @see NoteName.hpp
-    /// @warning not formatted for a Pitch object.
     enum NoteName name(size_t i) const;
 
-    /// const iterator pointig to the first name of note in this config.
-    std::vector<enum NoteName>::const_iterator cbeginName() const;
-
-    /// const iterator pointig to the one after last name of note
-    /// in this config.
-    std::vector<enum NoteName>::const_iterator cendName() const;
-
-    /// accidental of the note read for the transition
-    /// from this config's predecessor.
-    /// @param i index of the note in the input chord in 0..size()-1.
-    /// @see Accid.hpp
-    /// @warning not formatted for a Pitch object.
-    enum Accid accidental(size_t i) const;
-    
-    /// octave of the note read for the transition
-    /// from this config's predecessor.
-    /// @param i index of the note in the input chord in 0..size()-1.
-    int octave(size_t i) const;
-
     /// whether the accidental of the note (read for the transition from
     /// its predecessor) must be printed or not.
     /// @param i index of the note in the input chord in 0..size()-1.
     bool printed(size_t i) const;
 
-    /// const iterator pointig to the first print flag in this config.
-    std::vector<bool>::const_iterator cbeginPrint() const;
-
-    /// const iterator pointig to the one after last print flag in this config.
-    std::vector<bool>::const_iterator cendPrint() const;
-
     /// this configuration was reached by reading a single note.
     /// Always false for this class.
     bool fromNote() const override;
@@ -124,29 +121,15 @@ public: // access
     /// several simultaneous notes (a "chord").
     /// Always true for this class.
     bool fromChord() const override;
-    
-private: // data
-        
-    // representation of the sequence of simultaneous notes
-    // read to reach this config from previous config.
-    // std::shared_ptr<const PSChord> _chord;
 
-    // index of the next pitch class number to process in the input chord.
-    // unsigned int _current;
-    
-    /// MIDI pitchs of the notes read for the transition to this config.
-    std::vector<unsigned int> _midis;
+private: // data
 
     /// chosen pitch names, in 0..6 (0 is 'C', 6 is 'B'),
-    /// for the chord read for the transition to this config.
+    /// for the notes of the chord read for the transition to this config.
     std::vector<enum NoteName> _names;
-    
-    // chosen number of accidents, in -2..2.
-    // @todo TBR: it is _state[_name] by construction
-    // std::vector<enum Accid> _accids;
-   
+
     /// whether the accident must be printed
-    /// for the note read for the transition to this config.
+    /// for the notes read for the transition to this config.
     std::vector<bool> _prints;
 
 };
@@ -0,0 +1,168 @@
+//
+//  PSLanes.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include "PSLanes.hpp"
+#include "MidiNum.hpp"
+
+
+namespace pse {
+
+
+PSL::PSL(const Cost& seed, bool tonal, bool octave):
+_seed(seed.shared_zero()),
+_tonal(tonal),
+_octave(octave),
+_undef(),
+_tons(),
+_ltons(),
+_chroma(),
+_initm(),
+_inito(),
+_costs(),
+_dejavu(),
+_len(0),
+_names(),
+_prints()
+{ }
+
+
+PSL::~PSL()
+{
+    TRACE("delete PSD lanes");
+}
+
+
+void PSL::add(const Ton& ton, const Ton& lton, const enum NoteName* chroma)
+{
+    assert(ton.defined());
+    _tons.push_back(&ton);
+    _ltons.push_back(lton.defined()?&lton:&_undef);
+    std::array<enum NoteName, 12> names;
+    for (unsigned int pc = 0; pc < 12; ++pc)
+        names[pc] = chroma?chroma[pc]:ton.chromaname(pc);
+    _chroma.push_back(names);
+    if (_octave)
+        _inito.emplace_back(ton, _tonal);
+    else
+        _initm.emplace_back(ton, _tonal);
+    _costs.push_back(_seed->shared_zero());
+    _dejavu.emplace_back();
+}
+
+
+void PSL::run(const PSBarView& notes)
+{
+    if (_octave)
+        run(notes, _inito);
+    else
+        run(notes, _initm);
+}
+
+
+template<class S>
+void PSL::run(const PSBarView& notes, const std::vector<S>& init)
+{
+    const size_t lanes = size();
+    assert(init.size() == lanes);
+    _len = notes.stop() - notes.first();
+    _names.assign(_len * lanes, NoteName::Undef);
+    _prints.assign(_len * lanes, false);
+    std::vector<S> states(init); // copy of the initial states
+    for (size_t k = 0; k < lanes; ++k)
+        _costs[k] = _seed->shared_zero();
+
+    for (size_t id = notes.first(); id < notes.stop(); ++id)
+    {
+        const unsigned int m = notes.midipitch(id);
+        assert(MidiNum::check_midi(m));
+        const unsigned int pc = m % 12;
+        const enum NoteName forced = notes.name(id);
+        // same chord bookkeeping as the transitions of PSB:
+        // the last note of a chord is not flagged simultaneous
+        // and is processed as a single note.
+        const bool simult = notes.simultaneous(id);
+        const bool inchord = (id > notes.first()) and
+                             notes.simultaneous(id - 1);
+        const size_t j = id - notes.first();
+        for (size_t k = 0; k < lanes; ++k)
+        {
+            std::array<enum NoteName, 12>& dejavu = _dejavu[k];
+            // first note of chord
+            if (simult and not inchord)
+                dejavu.fill(NoteName::Undef);
+            enum NoteName name;
+            enum Accid accid;
+            // pitch class already processed in chord
+            if (simult and inchord and dejavu[pc] != NoteName::Undef)
+            {
+                name = dejavu[pc];
+                accid = MidiNum::midi_to_accid(m, name);
+            }
+            // constrained spelling
+            else if (forced != NoteName::Undef)
+            {
+                name = forced;
+                accid = notes.accidental(id);
+            }
+            else
+            {
+                name = _chroma[k][pc];
+                accid = MidiNum::class_to_accid(pc, name);
+            }
+            assert(defined(name));
+            assert(defined(accid));
+            if (simult and dejavu[pc] == NoteName::Undef)
+                dejavu[pc] = name;
+
+            S& state = states[k];
+            const int oct = _octave?MidiNum::midi_to_octave(m, name):
+                                    Pitch::UNDEF_OCTAVE;
+            const enum NoteName prev_name = state.lastName(pc);
+            const bool print = state.update(accid, name, oct);
+            _costs[k]->update(name, accid, print, *(_tons[k]), *(_ltons[k]),
+                              prev_name);
+            const size_t c = j * lanes + k;
+            _names[c] = name;
+            _prints[c] = print;
+        }
+    }
+}
+
+
+const Cost& PSL::cost(size_t k) const
+{
+    assert(k < _costs.size());
+    assert(_costs[k]);
+    return *(_costs[k]);
+}
+
+
+std::shared_ptr<const PSB> PSL::bag(size_t k, PSEnum& e) const
+{
+    assert(k < size());
+    assert(e.stop() - e.first() == _len);
+    const size_t lanes = size();
+    std::vector<enum NoteName> names;
+    std::vector<bool> prints;
+    names.reserve(_len);
+    prints.reserve(_len);
+    for (size_t c = k; c < _len * lanes; c += lanes)
+    {
+        names.push_back(_names[c]);
+        prints.push_back(_prints[c]);
+    }
+    std::shared_ptr<PSPStore> store = std::make_shared<PSPStore>(_len);
+    store->add(names, prints);
+    return std::make_shared<const PSB>(Algo::PSD, e, cost(k), store);
+}
+
+
+} // namespace pse
+
+/// @}
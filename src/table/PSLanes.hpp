@@ -0,0 +1,151 @@
+//
+//  PSLanes.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef PSLanes_hpp
+#define PSLanes_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <array>
+#include <vector>
+#include <memory>
+
+#include "pstrace.hpp"
+#include "NoteName.hpp"
+#include "Accid.hpp"
+#include "Ton.hpp"
+#include "Cost.hpp"
+#include "PSEnum.hpp"
+#include "PSBarView.hpp"
+#include "PSStateP.hpp"
+#include "PSBag.hpp"
+
+
+namespace pse {
+
+
+/// Lanes of the deterministic pitch spelling algorithm PSD:
+/// spelling of the notes of one bar for several tonalities at once,
+/// in one pass over the notes.
+/// With PSD, the name of every note is forced in input or given
+/// by the chromatic harmonic scale of the tonality, hence there is
+/// exactly one path for each tonality and no best path search is needed.
+/// The lanes are stored as a structure of arrays, with one entry by lane
+/// (tonality) in each array: accident state, cost, names by pitch class,
+/// and the names and print flags computed for each note (note major).
+/// The result is the same as the best path search of PSB with Algo::PSD.
+class PSL
+{
+public: // construction
+
+    /// empty set of lanes.
+    /// @param seed cost value of specialized type (to create costs of
+    /// the same type).
+    /// @param tonal mode: tonal or modal, for the construction of
+    /// initial states.
+    /// @param octave mode for the state transitions: repeat accidents
+    /// at different octaves, or reason modulo 12.
+    PSL(const Cost& seed, bool tonal, bool octave);
+
+    /// lanes cannot be copied.
+    PSL(const PSL& rhs) = delete;
+
+    PSL& operator=(const PSL& rhs) = delete;
+
+    ~PSL();
+
+    /// add a lane.
+    /// @param ton conjectured global tonality (key sig), used to define
+    /// the initial state and the names of the notes.
+    /// It must not be deallocated before these lanes.
+    /// @param lton conjectured local tonality, for the cost, or undef.
+    /// When defined, it must not be deallocated before these lanes.
+    /// @param chroma names of the chromatic harmonic scale of ton,
+    /// by pitch class, read in a TonTable. Null for querying ton.
+    void add(const Ton& ton, const Ton& lton = Ton(),
+             const enum NoteName* chroma = nullptr);
+
+    /// number of lanes.
+    inline size_t size() const { return _tons.size(); }
+
+public: // computation
+
+    /// spell the notes of a bar in every lane, from the initial states.
+    /// The results of a previous run are discarded.
+    /// @param notes contiguous copy of the notes of the bar.
+    void run(const PSBarView& notes);
+
+    /// cost of the path computed in the given lane.
+    /// @param k index of lane. must be smaller than size().
+    const Cost& cost(size_t k) const;
+
+    /// bag containing the path computed in the given lane.
+    /// @param k index of lane. must be smaller than size().
+    /// @param e an enumerator for the notes of the last run.
+    std::shared_ptr<const PSB> bag(size_t k, PSEnum& e) const;
+
+private: // data
+
+    /// cost value of specialized type.
+    std::shared_ptr<const Cost> _seed;
+
+    /// mode for initial states.
+    bool _tonal;
+
+    /// mode for state transitions.
+    bool _octave;
+
+    /// undefined tonality, for the lanes without local tonality.
+    const Ton _undef;
+
+    /// global tonality of each lane.
+    std::vector<const Ton*> _tons;
+
+    /// local tonality of each lane.
+    std::vector<const Ton*> _ltons;
+
+    /// names of the chromatic harmonic scale, by lane and pitch class.
+    std::vector<std::array<enum NoteName, 12>> _chroma;
+
+    /// initial state of each lane, modulo 12 (empty in octave mode).
+    std::vector<PSStateM> _initm;
+
+    /// initial state of each lane, with octaves (empty otherwise).
+    std::vector<PSStateO> _inito;
+
+    /// current cost of each lane.
+    std::vector<std::shared_ptr<Cost>> _costs;
+
+    /// names already chosen for pitch classes in the current chord,
+    /// by lane.
+    std::vector<std::array<enum NoteName, 12>> _dejavu;
+
+    /// number of notes of the last run.
+    size_t _len;
+
+    /// names computed, note major: name of note j in lane k at j*size()+k.
+    std::vector<enum NoteName> _names;
+
+    /// print flags computed, note major.
+    std::vector<bool> _prints;
+
+private:
+
+    /// spell the notes in every lane, with given initial states.
+    template<class S>
+    void run(const PSBarView& notes, const std::vector<S>& init);
+
+};
+
+
+} // namespace pse
+
+#endif /* PSLanes_hpp */
+
+/// @}
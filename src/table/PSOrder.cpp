@@ -19,10 +19,20 @@ bool PSClex::operator()(std::shared_ptr<const PSC0>& lhs,
 {
     assert (lhs);
     assert (rhs);
-    if (lhs->cost() == rhs->cost())
+    const Cost& lc = lhs->cost();
+    const Cost& rc = rhs->cost();
+    // fast path: integer comparison of the cached sort keys
+    if (lc.packed() && rc.packed())
+    {
+        if (lc.key() == rc.key())
+            return (lhs->id() < rhs->id());  // largest index
+        else
+            return (lc.key() > rc.key());    // smallest cost
+    }
+    else if (lc == rc)
         return (lhs->id() < rhs->id());      // largest index
     else
-        return (lhs->cost() > rhs->cost());  // smallest cost
+        return (lc > rc);                    // smallest cost
 //  if (lhs->accidentals() == rhs->accidentals())
 //  {
 //      // dist, lexicographically
@@ -47,12 +57,38 @@ bool PSClexc::operator()(std::shared_ptr<const PSC1c>& lhs,
 {
     assert (lhs);
     assert (rhs);
-    if (lhs->cost() == rhs->cost())
+    const Cost& lc = lhs->cost();
+    const Cost& rc = rhs->cost();
+    // fast path: integer comparison of the cached sort keys
+    if (lc.packed() && rc.packed())
+    {
+        if (lc.key() == rc.key())
+            return (lhs->id() < rhs->id());  // largest index
+        else
+            return (lc.key() > rc.key());    // smallest cost
+    }
+    else if (lc == rc)
         return (lhs->id() < rhs->id());      // largest index
     else
-        return (lhs->cost() > rhs->cost());  // smallest cost
+        return (lc > rc);                    // smallest cost
 };
 
+size_t PSCHash::operator()(const std::shared_ptr<const PSC0>& c) const
+{
+    assert(c);
+    return c->hash();
+}
+
+
+bool PSCEquiv::operator()(const std::shared_ptr<const PSC0>& lhs,
+                          const std::shared_ptr<const PSC0>& rhs) const
+{
+    assert(lhs);
+    assert(rhs);
+    return lhs->equivalent(*rhs);
+}
+
+
 //bool PSCcumul::operator()(std::shared_ptr<const PSC0>& lhs,
 //                          std::shared_ptr<const PSC0>& rhs)
 //{
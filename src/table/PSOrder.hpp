@@ -66,6 +66,22 @@ struct PSClexc
    
 };
 
+/// hash of PS Configs, for closed tables of configs in best path search.
+/// @see PSC0::hash
+struct PSCHash
+{
+    size_t operator()(const std::shared_ptr<const PSC0>& c) const;
+};
+
+/// equivalence of PS Configs, for closed tables of configs
+/// in best path search.
+/// @see PSC0::equivalent
+struct PSCEquiv
+{
+    bool operator()(const std::shared_ptr<const PSC0>& lhs,
+                    const std::shared_ptr<const PSC0>& rhs) const;
+};
+
 // ordering for PS Config0 based on lexico combination of
 // - cost (nb accidents, dist. to local tonality,
 // number of disjoint moves, color), ordered lexicographically,
@@ -0,0 +1,171 @@
+//
+//  PSPStore.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include <algorithm>
+
+#include "PSPStore.hpp"
+#include "PSConfig1.hpp"
+#include "PSConfig2.hpp"
+
+
+namespace pse {
+
+
+PSPStore::PSPStore(size_t len):
+_len(len),
+_branches(),
+_codes(),
+_stored(0)
+{ }
+
+
+PSPStore::~PSPStore()
+{
+    TRACE("delete PS Path store");
+}
+
+
+size_t PSPStore::add(const std::vector<enum NoteName>& names,
+                     const std::vector<bool>& prints)
+{
+    assert(names.size() == _len);
+    assert(prints.size() == _len);
+    // path stored before with the longest common prefix
+    Branch b = { NONE, 0, _stored };
+    for (size_t k = 0; k < size(); ++k)
+    {
+        size_t j = 0;
+        while (j < _len and
+               name(k, j) == names[j] and printed(k, j) == prints[j])
+            ++j;
+        if (b.parent == NONE or j > b.from)
+        {
+            b.parent = k;
+            b.from = j;
+        }
+    }
+    for (size_t j = b.from; j < _len; ++j)
+        push(names[j], prints[j]);
+    _branches.push_back(b);
+    return _branches.size() - 1;
+}
+
+
+size_t PSPStore::add(const PSC0& c)
+{
+    std::vector<enum NoteName> names(_len, NoteName::Undef);
+    std::vector<bool> prints(_len, false);
+    const PSC0* co = &c;
+    size_t j = _len;
+    assert(co->initial() || co->fromNote() || co->fromChord());
+    while (! co->initial())
+    {
+        // chord read in one step
+        if (co->fromChord())
+        {
+            const PSC2* coc = dynamic_cast<const PSC2*>(co);
+            assert(coc);
+            assert(j >= coc->size());
+            for (size_t k = coc->size(); k > 0; --k)
+            {
+                --j;
+                names[j] = coc->name(k-1);
+                prints[j] = coc->printed(k-1);
+            }
+        }
+        else
+        {
+            const PSC1* com = dynamic_cast<const PSC1*>(co);
+            assert(com);
+            assert(j > 0);
+            --j;
+            names[j] = com->name();
+            prints[j] = com->printed();
+        }
+        co = co->previous(); // NULL if co is initial
+        assert(co);
+        assert(co->initial() || co->fromNote() || co->fromChord());
+    }
+    assert(j == 0); // number of notes
+    return add(names, prints);
+}
+
+
+void PSPStore::push(const enum NoteName& name, bool print)
+{
+    assert(defined(name));
+    uint8_t code = (uint8_t) toint(name) | (print?0x8:0x0);
+    assert(code < 16);
+    if (_stored % 2 == 0)
+        _codes.push_back(code);
+    else
+        _codes.back() |= (code << 4);
+    ++_stored;
+}
+
+
+uint8_t PSPStore::code(size_t k, size_t j) const
+{
+    assert(k < _branches.size());
+    assert(j < _len);
+    // follow the back-pointers to the path storing position j
+    while (j < _branches[k].from)
+    {
+        k = _branches[k].parent;
+        assert(k < _branches.size());
+    }
+    size_t c = _branches[k].offset + (j - _branches[k].from);
+    assert(c < _stored);
+    return (_codes[c / 2] >> (4 * (c % 2))) & 0xF;
+}
+
+
+enum NoteName PSPStore::name(size_t k, size_t j) const
+{
+    return static_cast<enum NoteName>(code(k, j) & 0x7);
+}
+
+
+bool PSPStore::printed(size_t k, size_t j) const
+{
+    return (code(k, j) & 0x8);
+}
+
+
+void PSPStore::decode(size_t k, std::vector<enum NoteName>& names,
+                      std::vector<bool>& prints) const
+{
+    assert(k < _branches.size());
+    names.resize(_len);
+    prints.resize(_len);
+    // segments of the path, from the last one
+    size_t hi = _len;
+    while (hi > 0)
+    {
+        const Branch& b = _branches[k];
+        for (size_t j = b.from; j < hi; ++j)
+        {
+            size_t c = b.offset + (j - b.from);
+            uint8_t code = (_codes[c / 2] >> (4 * (c % 2))) & 0xF;
+            names[j] = static_cast<enum NoteName>(code & 0x7);
+            prints[j] = (code & 0x8);
+        }
+        hi = std::min(hi, b.from);
+        if (hi > 0)
+        {
+            k = b.parent;
+            assert(k < _branches.size());
+        }
+    }
+}
+
+
+} // namespace pse
+
+/// @}
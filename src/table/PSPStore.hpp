@@ -0,0 +1,137 @@
+//
+//  PSPStore.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef PSPStore_hpp
+#define PSPStore_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <vector>
+#include <cstdint>
+
+#include "pstrace.hpp"
+#include "NoteName.hpp"
+#include "PSConfig0.hpp"
+
+
+namespace pse {
+
+
+/// compact store of the best paths of a bag, for one sequence of notes.
+/// - every note of a path is stored as a code of 4 bits
+///   (name in 0..6 and print flag), two codes per byte.
+///   The accidentals are not stored: they are determined by the name
+///   and the MIDI key of the note.
+/// - the paths of a tie (several best paths) are stored as a tree
+///   with back-pointers: every path but the first one is stored from
+///   the first note where it differs from a path stored before,
+///   and shares the notes before with this path.
+/// The positions of notes are relative to the first note of the sequence,
+/// hence a store can be shared by the bags of identical bars.
+class PSPStore
+{
+public: // construction
+
+    /// empty store.
+    /// @param len number of notes in the paths.
+    PSPStore(size_t len);
+
+    ~PSPStore();
+
+    /// add a path given by its sequences of names and print flags.
+    /// @param names sequence of names of the notes. must be of length len.
+    /// @param prints sequence of print flags of the notes.
+    /// must be of length len.
+    /// @return the index of the path added.
+    size_t add(const std::vector<enum NoteName>& names,
+               const std::vector<bool>& prints);
+
+    /// add the path targeting the given configuration, built by following
+    /// the previous configs until the initial config.
+    /// @param c a PS configuration, at distance len from the initial config.
+    /// @return the index of the path added.
+    size_t add(const PSC0& c);
+
+public: // access
+
+    /// number of notes in the paths.
+    inline size_t length() const { return _len; }
+
+    /// number of paths stored.
+    inline size_t size() const { return _branches.size(); }
+
+    /// name of a note in a path.
+    /// @param k index of path. must be smaller than size().
+    /// @param j position of note, relatively to the first note of the sequence.
+    /// must be smaller than length().
+    enum NoteName name(size_t k, size_t j) const;
+
+    /// print flag of a note in a path.
+    /// @param k index of path. must be smaller than size().
+    /// @param j position of note, relatively to the first note of the sequence.
+    /// must be smaller than length().
+    bool printed(size_t k, size_t j) const;
+
+    /// names and print flags of all the notes of a path, in one pass.
+    /// @param k index of path. must be smaller than size().
+    /// @param names vector receiving the names. it is resized to length().
+    /// @param prints vector receiving the print flags.
+    /// it is resized to length().
+    void decode(size_t k, std::vector<enum NoteName>& names,
+                std::vector<bool>& prints) const;
+
+    /// number of notes stored in the codes, for all the paths.
+    inline size_t stored() const { return _stored; }
+
+private: // data
+
+    /// no parent path.
+    static const size_t NONE = SIZE_MAX;
+
+    /// suffix of a path stored in the codes.
+    struct Branch
+    {
+        /// index of the path sharing the notes before from, or NONE.
+        size_t parent;
+
+        /// position of the first note stored for this path.
+        size_t from;
+
+        /// index of the code of the note at position from.
+        size_t offset;
+    };
+
+    /// number of notes in the paths.
+    size_t _len;
+
+    /// one branch per path.
+    std::vector<Branch> _branches;
+
+    /// codes of the notes, two codes per byte.
+    std::vector<uint8_t> _codes;
+
+    /// number of codes stored.
+    size_t _stored;
+
+private:
+
+    /// code of the note at given position in a path.
+    uint8_t code(size_t k, size_t j) const;
+
+    /// append a code at the end of the codes.
+    void push(const enum NoteName& name, bool print);
+
+};
+
+
+} // namespace pse
+
+#endif /* PSPStore_hpp */
+
+/// @}
@@ -15,23 +15,17 @@
 namespace pse {
 
 
-PSP::PSP(const PSC0& psc, PSEnum& e):
+PSP::PSP(PSEnum& e, const Cost& cost,
+         std::shared_ptr<const PSPStore> store, size_t k):
 _enum(e),
-_names(),   // initially empty
-_accids(),
-_prints(),
-_cost(psc.cost().shared_clone()),
-_computed(false)
+_store(store),
+_k(k),
+_cost(cost.shared_clone())
 {
-    TRACE("PSP: computing best path for {}-{}", e.first(), e.stop());
-
-    // empty sequence of notes
-    if (e.first() == e.stop())
-        return; // nothing to do
-    
-    assert(e.first() < e.stop());
-    //init(ton, lton);
-    record_path(psc);
+    TRACE("PSP: best path {} for {}-{}", k, e.first(), e.stop());
+    assert(_store);
+    assert(_k < _store->size());
+    assert(_store->length() == _enum.size());
 }
 
 
@@ -59,73 +53,69 @@ _computed(false)
 PSP::~PSP()
 {
     TRACE("delete PS Path {}-{}", _enum.first(), _enum.stop());
-  
-    _names.clear();
-    _accids.clear();
-    _prints.clear();
 }
 
 
-const enum NoteName& PSP::name(size_t i) const
+enum NoteName PSP::name(size_t i) const
 {
     assert(_enum.inside(i));
-    //if (_names.empty()) init();
-    assert((i - _enum.first()) < _names.size());
-    return _names[i - _enum.first()];
+    return _store->name(_k, i - _enum.first());
 }
 
 
-const enum Accid& PSP::alteration(size_t i) const
+enum Accid PSP::alteration(size_t i) const
 {
-    // if (_accids.empty()) init();
     assert(_enum.inside(i));
-    assert(i - _enum.first() < _accids.size());
-    return _accids[i - _enum.first()];
+    // determined by the name and the MIDI key
+    enum Accid accid = MidiNum::midi_to_accid(_enum.midipitch(i), name(i));
+    assert(defined(accid));
+    return accid;
 }
 
 
 bool PSP::printed(size_t i) const
 {
-    // if (_prints.empty()) init();
     assert(_enum.inside(i));
-    assert(i - _enum.first() < _prints.size());
-    return _prints[i - _enum.first()];
+    return _store->printed(_k, i - _enum.first());
 }
 
-const Cost& PSP::cost() const
+
+std::vector<enum NoteName> PSP::names() const
 {
-    assert(_cost);
-    return *_cost;
+    std::vector<enum NoteName> names;
+    std::vector<bool> prints;
+    _store->decode(_k, names, prints);
+    return names;
+}
+
+
+std::vector<enum Accid> PSP::accids() const
+{
+    std::vector<enum NoteName> names;
+    std::vector<bool> prints;
+    _store->decode(_k, names, prints);
+    std::vector<enum Accid> accids;
+    accids.reserve(names.size());
+    for (size_t j = 0; j < names.size(); ++j)
+        accids.push_back(MidiNum::midi_to_accid(
+                         _enum.midipitch(_enum.first() + j), names[j]));
+    return accids;
+}
+
+
+std::vector<bool> PSP::prints() const
+{
+    std::vector<enum NoteName> names;
+    std::vector<bool> prints;
+    _store->decode(_k, names, prints);
+    return prints;
 }
 
 
-void PSP::record_path(const PSC0& c)
+const Cost& PSP::cost() const
 {
-    assert(c.id() == _enum.stop());
     assert(_cost);
-    assert(*_cost == c.cost());
-    const PSC0* co = &c;
-    assert(co);
-    assert(co->initial() || co->fromNote() || co->fromChord());
-    while (! co->initial())
-    {
-        const PSC1* com = dynamic_cast<const PSC1*>(co);
-        assert(com);
-        const enum NoteName& name = com->name();
-        /// @todo revise for the case of octaves
-        const enum Accid& accid = com->accidental();
-        assert(accid == MidiNum::class_to_accid(com->midi()%12, name));
-        _names.insert(_names.begin(), name);  // push_front (copy)
-        _accids.insert(_accids.begin(), accid);
-        _prints.insert(_prints.begin(), com->printed());
-        
-        co = co->previous(); // NULL if co is initial
-        assert(co);
-        assert(co->initial() || co->fromNote() || co->fromChord());
-    }
-    assert(_names.size()  == _enum.size()); // number of notes
-    assert(_accids.size() == _enum.size());
-    assert(_prints.size() == _enum.size());
+    return *_cost;
 }
 
 
@@ -182,24 +172,25 @@ void PSP::record_path(const PSC0& c)
 //}
 
 
-void PSP::rename()
+void PSP::rename() const
 {
-    // if (_names.empty()) return;
     assert(_enum.first() <= _enum.stop());
-    assert((_enum.stop() - _enum.first()) <= _names.size());
-    
+    assert(_enum.size() == _store->length());
+    // linear copy of the path in the enumerator
+    std::vector<enum NoteName> names;
+    std::vector<bool> prints;
+    _store->decode(_k, names, prints);
     for (size_t i = _enum.first(); i < _enum.stop(); ++i)
     {
-        const enum NoteName& name = _names[i - _enum.first()];
-        const enum Accid& accid = _accids[i - _enum.first()];
+        const enum NoteName& name = names[i - _enum.first()];
         assert(name != NoteName::Undef);
-        assert(accid != Accid::Undef);
         unsigned int mp = _enum.midipitch(i);
+        const enum Accid accid = MidiNum::midi_to_accid(mp, name);
+        assert(accid != Accid::Undef);
         int oct = MidiNum::midi_to_octave(mp, name, accid);
         assert(-2 <= oct);
         assert(oct <= 9);
-        bool altprint = _prints[i - _enum.first()];
-        //std::cout << "enum: rename" << i << std::endl;
+        bool altprint = prints[i - _enum.first()];
         _enum.rename(i, name, accid, oct, altprint);
         TRACE("PSP.rename: note {} : {}{}{} {}", i, name, oct, accid, altprint);
     }
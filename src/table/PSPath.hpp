@@ -29,8 +29,9 @@
 #include "PSConfig0.hpp"
 #include "PSConfig1.hpp"
 #include "PSConfig1c.hpp"
+#include "PSPStore.hpp"
 //#include "PSConfig2.hpp"
-#include "PSBag.hpp"
+// #include "PSBag.hpp" // the bags include their path store
 
 
   
@@ -53,13 +54,15 @@ public:
     // for every choice between configs of the bags,
     // the closest to the tonality is selected.
 
-    /// shortest path extracted from a final configuration of a best path,
-    /// computed with the given note enumerator.
-    /// @param psc PS configuration.
-    /// @param e an enumerator of notes for computing transitions between configs.
-    /// the enumerator and the path targeting the configuration must
-    /// have the same length.
-    PSP(const PSC0& psc, PSEnum& e);
+    /// path of given index in a path store.
+    /// @param e an enumerator of notes. it must have the same length as
+    /// the paths of the store.
+    /// @param cost cumulated cost of the path.
+    /// @param store compact store of best paths, shared with the bag
+    /// (and the cache of results of searches).
+    /// @param k index of the path in store.
+    PSP(PSEnum& e, const Cost& cost,
+        std::shared_ptr<const PSPStore> store, size_t k = 0);
 
     ~PSP();
 
@@ -69,11 +72,11 @@ public:
     /// name for the pitch of the note of given index in the best path,
     /// in 0..6 (0 is 'C', 6 is 'B').
     /// @param i index of note in enumerator, must be between first and last.
-    const enum NoteName& name(size_t i) const;
+    enum NoteName name(size_t i) const;
     
     /// alteration for pitch of note of given index in the best path, in -2..2.
     /// @param i index of note in enumerator, must be between first and last.
-    const enum Accid& alteration(size_t i) const;
+    enum Accid alteration(size_t i) const;
     
     /// print flag for pitch of note of given index in the best path.
     /// @param i index of note in enumerator, must be between first and last.
@@ -81,10 +84,25 @@ public:
 
     /// nb of accidents in best path from first to last note.
     /// For debug info.
-    inline const Cost& cost() const; // { return _cost; }
+    const Cost& cost() const;
+
+    /// sequence of the names of the notes in the best path,
+    /// from the first note of the enumerator.
+    std::vector<enum NoteName> names() const;
+
+    /// sequence of the accidentals of the notes in the best path,
+    /// from the first note of the enumerator.
+    std::vector<enum Accid> accids() const;
+
+    /// sequence of the print flags of the notes in the best path,
+    /// from the first note of the enumerator.
+    std::vector<bool> prints() const;
+
+    /// compact store containing this path.
+    inline const PSPStore& store() const { assert(_store); return *_store; }
     
     /// rename all notes read to build this PSP.
-    void rename();
+    void rename() const;
     
     void print(std::ostream& o) const;
        
@@ -101,21 +119,15 @@ private:
     /// enumerator of notes for computing the best path.
     PSEnum& _enum;
     
-    /// list of note names (in 0..6) on the best path from note n0 to note n1.
-    std::vector<enum NoteName> _names;
+    /// store of the names and print flags of the best path.
+    std::shared_ptr<const PSPStore> _store;
 
-    /// list of accidents (in -2..2) on the best path from note n0 to note n1.
-    std::vector<enum Accid> _accids;
-
-    /// list of flag print for the best path from note n0 to note n1.
-    std::vector<bool> _prints;
+    /// index of the best path in the store.
+    size_t _k;
 
     /// cumulated cost in the best path from n0 to n1.
     std::shared_ptr<Cost> _cost;
     
-    /// best path was succesfull estimated
-    bool _computed;
-    
     /// compute the best path from the given bag of configs.
     /// @param ton an estimated global tonality (key signature).
     /// @param lton an estimated local tonality.
@@ -136,8 +148,6 @@ private:
     // @todo TBR
     // void init2(PSCQueue& queue2);
     
-    void record_path(const PSC0& c);
-    
     /// @param i index of note in enumerator, must be between first and last.
     void print(std::ostream& o, size_t i) const;
     
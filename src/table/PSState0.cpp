@@ -43,6 +43,21 @@ bool PSState0::operator!=(const PSState0& rhs) const
 }
 
 
+bool PSState0::equivalent(const PSState0& rhs) const
+{
+    return (_names == rhs._names) && operator==(rhs);
+}
+
+
+size_t PSState0::hashNames() const
+{
+    size_t h = HASHINIT;
+    for (const enum NoteName& n : _names)
+        h = hashmix(h, static_cast<size_t>(toint(n)));
+    return h;
+}
+
+
 const accids_t PSState0::accids(const enum NoteName& name, int oct) const
 {
     assert(name != Pitch::UNDEF_NOTE_NAME);
@@ -52,6 +52,24 @@ public: // comparison
     
     /// states have different list of accidentals
     bool operator!=(const PSState0& rhs) const;
+
+    /// states have the same accidentals and the same last names
+    /// associated to pitch classes.
+    /// The transitions from equivalent states are the same,
+    /// with the same cost updates.
+    bool equivalent(const PSState0& rhs) const;
+
+    /// hash value of this state, compatible with equivalent.
+    virtual size_t hash() const = 0;
+
+    /// one step of FNV hash.
+    /// @param h hash value under construction.
+    /// @param v value to add to h.
+    static inline size_t hashmix(size_t h, size_t v)
+    { return (h * 16777619) ^ v; }
+
+    /// initial value of FNV hash.
+    static const size_t HASHINIT = 2166136261;
     
 public: // access
     
@@ -139,6 +157,11 @@ protected: // low-level access and modification, implemented in descendants.
                      const enum NoteName& name,
                      int oct=Pitch::UNDEF_OCTAVE) = 0;
     
+protected: // hash
+
+    /// hash value of the last names associated to pitch classes.
+    size_t hashNames() const;
+
 protected: // data
 
     /// last name associated to each pitch classes in this state.
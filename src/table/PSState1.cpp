@@ -74,6 +74,15 @@ bool PSState1::equal(const PSState1& rhs) const
 }
 
 
+size_t PSState1::hash() const
+{
+    size_t h = hashNames();
+    for (size_t i = 0; i < 7; ++i)
+        h = hashmix(h, _state[i]);
+    return h;
+}
+
+
 const accids_t PSState1::get(const enum NoteName& name, int oct) const
 {
     assert(name != Pitch::UNDEF_NOTE_NAME);
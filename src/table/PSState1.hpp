@@ -67,6 +67,9 @@ public: // comparison
     /// same list of accidentals
     bool equal(const PSState1& rhs) const;
 
+    /// hash value of this state, compatible with equivalent.
+    size_t hash() const override;
+
 protected: // low-level access and modification, implemented in descendants.
     
     /// get accidental(s) in this state for a given pitch name
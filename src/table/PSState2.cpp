@@ -97,6 +97,18 @@ bool PSState2::equal(const PSState2& rhs) const
 }
 
 
+size_t PSState2::hash() const
+{
+    size_t h = hashNames();
+    for (int n = 0; n < 7; ++n)
+    {
+        for (size_t o = 0; o < OCTAVES; ++o)
+            h = hashmix(h, _state[n][o]);
+    }
+    return h;
+}
+
+
 const accids_t PSState2::get(const enum NoteName& name, int oct) const
 {
     assert(name != Pitch::UNDEF_NOTE_NAME);
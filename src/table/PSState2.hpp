@@ -67,6 +67,9 @@ class PSState2: public PSState0
     
     /// same list of accidentals
     bool equal(const PSState2& rhs) const;
+
+    /// hash value of this state, compatible with equivalent.
+    size_t hash() const override;
     
     protected: // low-level access and modification, implemented in descendants.
     
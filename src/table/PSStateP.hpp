@@ -0,0 +1,145 @@
+//
+//  PSStateP.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#ifndef PSStateP_hpp
+#define PSStateP_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <array>
+#include <cstdint>
+
+#include "pstrace.hpp"
+#include "NoteName.hpp"
+#include "Accid.hpp"
+#include "Accids.hpp"
+#include "Pitch.hpp"
+#include "Ton.hpp"
+
+
+namespace pse {
+
+
+/// Packed Accident State: value type equivalent to PSState1 (O = 1)
+/// or PSState2 (O = number of octaves), without virtual functions
+/// and without allocation.
+/// - one byte (accids_t) for each note name and octave,
+///   packed in 64-bit words.
+/// - one 4-bit code for the last name read for each pitch class,
+///   packed in one 64-bit word.
+/// Copy, comparison and hash are done word by word.
+/// With O = 1, the state fits in two words.
+/// @param O number of octaves distinguished: 1 for reasoning modulo 12,
+/// or PSStateP<>::OCTAVES for repeating accidentals at different octaves.
+template<size_t O>
+class PSStateP
+{
+public: // constants
+
+    /// number of octaves for the octave mode.
+    static const size_t OCTAVES = Pitch::OCTAVE_MAX - Pitch::OCTAVE_MIN + 1;
+
+    /// number of 64-bit words for the accidentals.
+    static const size_t WORDS = (7 * O + 7) / 8;
+
+public: // construction
+
+    /// initial state for a given tonality.
+    /// @param ton a tonality.
+    /// @param tonal flag: tonal or modal mode.
+    /// @see PSState1 constructor
+    PSStateP(const Ton& ton, bool tonal = true);
+
+public: // comparison
+
+    /// same accidentals and same last names.
+    inline bool operator==(const PSStateP<O>& rhs) const
+    { return (_names == rhs._names) and (_accids == rhs._accids); }
+
+    inline bool operator!=(const PSStateP<O>& rhs) const
+    { return (! operator==(rhs)); }
+
+    /// hash value compatible with ==.
+    size_t hash() const;
+
+public: // access
+
+    /// accidentals associated to a note name in this state.
+    /// @param name note name in 0..6 (0 is 'C', 6 is 'B').
+    /// @param oct octave number, ignored when O = 1.
+    accids_t accids(const enum NoteName& name,
+                    int oct = Pitch::UNDEF_OCTAVE) const;
+
+    /// whether the given accidental is associated to the given note name
+    /// in this state.
+    bool member(const enum NoteName& name, const enum Accid& accid,
+                int oct = Pitch::UNDEF_OCTAVE) const;
+
+    /// last name read for the given pitch class, or Undef.
+    /// @param pc pitch class in 0..11.
+    inline enum NoteName lastName(unsigned int pc) const
+    {
+        assert(pc < 12);
+        return static_cast<enum NoteName>((_names >> (4 * pc)) & 0xF);
+    }
+
+public: // modification
+
+    /// update this state with the given accidental for the given name.
+    /// @return whether the accidental must be printed.
+    /// @see PSState0::update
+    bool update(const enum Accid& accid, const enum NoteName& name,
+                int oct = Pitch::UNDEF_OCTAVE);
+
+    /// functor for unordered containers.
+    struct Hash
+    {
+        size_t operator()(const PSStateP<O>& s) const { return s.hash(); }
+    };
+
+private: // data
+
+    /// accidentals, one byte per (name, octave), name major.
+    std::array<uint64_t, WORDS> _accids;
+
+    /// last names, 4 bits per pitch class.
+    uint64_t _names;
+
+private:
+
+    /// index of the byte for the given name and octave.
+    static size_t cell(const enum NoteName& name, int oct);
+
+    inline accids_t get(size_t c) const
+    { return (accids_t) ((_accids[c / 8] >> (8 * (c % 8))) & 0xFF); }
+
+    inline void set(size_t c, accids_t a)
+    {
+        uint64_t& w = _accids[c / 8];
+        w &= ~(((uint64_t) 0xFF) << (8 * (c % 8)));
+        w |= ((uint64_t) a) << (8 * (c % 8));
+    }
+
+};
+
+
+/// state for reasoning modulo 12.
+typedef PSStateP<1> PSStateM;
+
+/// state for repeating accidentals at different octaves.
+typedef PSStateP<PSStateP<1>::OCTAVES> PSStateO;
+
+
+} // namespace pse
+
+#include "PSStateP.tpp"
+
+#endif /* PSStateP_hpp */
+
+/// @}
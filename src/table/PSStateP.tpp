@@ -0,0 +1,108 @@
+//
+//  PSStateP.tpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include "MidiNum.hpp"
+
+
+namespace pse {
+
+
+template<size_t O>
+PSStateP<O>::PSStateP(const Ton& ton, bool tonal):
+_accids(),
+_names(0)
+{
+    _accids.fill(0);
+    // all pitch classes undef
+    for (unsigned int pc = 0; pc < 12; ++pc)
+        _names |= ((uint64_t) static_cast<int>(NoteName::Undef)) << (4 * pc);
+    // for each note name (0 is 'C', 6 is 'B').
+    for (int n = 0; n < 7; ++n)
+    {
+        accids_t a = tonal?Accids::encode(ton.accidKey(n)):ton.accidScale(n);
+        // same initial accid for each octave.
+        for (size_t o = 0; o < O; ++o)
+            set(n * O + o, a);
+    }
+}
+
+
+template<size_t O>
+size_t PSStateP<O>::cell(const enum NoteName& name, int oct)
+{
+    assert(defined(name));
+    size_t n = static_cast<size_t>(name);
+    assert(n < 7);
+    if (O == 1)
+        return n;
+    assert(Pitch::check_octave(oct));
+    assert(oct != Pitch::UNDEF_OCTAVE);
+    size_t o = oct - Pitch::OCTAVE_MIN;
+    assert(o < O);
+    return n * O + o;
+}
+
+
+template<size_t O>
+size_t PSStateP<O>::hash() const
+{
+    // FNV-1a on words
+    uint64_t h = 14695981039346656037ULL;
+    h = (h ^ _names) * 1099511628211ULL;
+    for (uint64_t w : _accids)
+        h = (h ^ w) * 1099511628211ULL;
+    return (size_t) h;
+}
+
+
+template<size_t O>
+accids_t PSStateP<O>::accids(const enum NoteName& name, int oct) const
+{
+    return get(cell(name, oct));
+}
+
+
+template<size_t O>
+bool PSStateP<O>::member(const enum NoteName& name, const enum Accid& accid,
+                         int oct) const
+{
+    assert(accid != Accid::Undef);
+    return Accids::contained(accid, accids(name, oct));
+}
+
+
+template<size_t O>
+bool PSStateP<O>::update(const enum Accid& accid, const enum NoteName& name,
+                         int oct)
+{
+    assert(defined(name));
+    assert(accid != Accid::Undef);
+    size_t c = cell(name, oct);
+    accids_t a = get(c);
+
+    unsigned int pc = MidiNum::pitchClass(name, accid);
+    assert(pc < 12);
+    _names &= ~(((uint64_t) 0xF) << (4 * pc));
+    _names |= ((uint64_t) static_cast<int>(name)) << (4 * pc);
+
+    if (Accids::single(a) && Accids::contained(accid, a))
+    {
+        return false;
+    }
+    else
+    {
+        set(c, Accids::encode(accid));
+        return true;
+    }
+}
+
+
+} // namespace pse
+
+/// @}
@@ -9,28 +9,49 @@
 /// @{
 
 
+#include <algorithm>
+#include <bitset>
+
 #include "PSTable.hpp"
 #include "PSGrid.hpp"
+#include "PSPool.hpp"
+#include "PSBars.hpp"
 
 
 namespace pse {
 
 
 PST::PST(const Algo& a, const Cost& seed, const TonIndex& index,
-         PSEnum& e, bool tonal, bool octave, bool dflag):
+         PSEnum& e, bool tonal, bool octave, bool dflag, size_t threads,
+         PSBMemo* memo, PSAutomata* automata, bool astar, double prune,
+         bool costonly, PSPool* pool):
 _algo(a),
 _enum(e),
 _index(index),
 _psvs(),     // initially empty
 _rowcost(),
-_debug(dflag)
+_debug(dflag),
+_memo(memo),
+_automata(automata),
+_pool(pool),
+_astar(astar),
+_seed(seed.shared_zero()),
+_tonal(tonal),
+_octave(octave),
+_prune(100),
+_exact(index.size(), true),
+_costonly(costonly)
 {
     TRACE("new PS Table {}-{} for {}", e.first(), e.stop(), a);
+    assert(0 <= prune);
+    assert(prune <= 100);
        
     if (a == Algo::PSE || a == Algo::PSD)
     {
         PSG dummy(*this); // empty grid
-        bool status = init_psvs(seed, dummy, tonal, octave);
+        bool status = (prune < 100)?init_pruned(seed, tonal, octave, prune):
+                                    init_psvs(seed, dummy, tonal, octave,
+                                              threads);
         if (status == false)
         {
             ERROR("PST: fail to compute spelling table {}-{} for {}",
@@ -38,7 +59,9 @@ _debug(dflag)
         }
     }
     
-    compute_rowcosts(seed, false);
+    // row costs not computed in pruned mode
+    if (_rowcost.empty())
+        compute_rowcosts(seed, false);
 
     // @todo TBR
     // init table with default vector of tons
@@ -50,20 +73,32 @@ _debug(dflag)
 
 // tab not used
 PST::PST(const Algo& a, const Cost& seed, const TonIndex& index,
-         PSEnum& e, const PSG& locals, bool tonal, bool octave, bool dflag):
+         PSEnum& e, const PSG& locals, bool tonal, bool octave, bool dflag,
+         size_t threads, PSBMemo* memo, PSAutomata* automata, bool astar,
+         PSPool* pool):
 _algo(a),
 _enum(e),
 _index(index),
 _psvs(),     // initially empty
 _rowcost(),
-_debug(dflag)
+_debug(dflag),
+_memo(memo),
+_automata(automata),
+_pool(pool),
+_astar(astar),
+_seed(seed.shared_zero()),
+_tonal(tonal),
+_octave(octave),
+_prune(100),
+_exact(index.size(), true),
+_costonly(false)
 {
     TRACE("new PS Table {}-{} from grid, for {}",
           _enum.first(), _enum.stop(), _algo);
     assert(locals.nbTons() == _index.size());
     // assert(locals.measures() == tab.measures());
     assert(_algo == Algo::PSE || _algo == Algo::PSD);
-    bool status = init_psvs(seed, locals, tonal, octave);
+    bool status = init_psvs(seed, locals, tonal, octave, threads);
     if (status == false)
     {
         ERROR("PST: fail to compute spelling table {}-{} for {}",
@@ -170,24 +205,15 @@ void PST::compute_rowcosts(const Cost& seed, bool globals)
 
 
 // first construction if grid is empty
-bool PST::init_psvs(const Cost& seed, const PSG& grid, bool tonal, bool octave)
+bool PST::init_psvs(const Cost& seed, const PSG& grid, bool tonal, bool octave,
+                    size_t threads)
 {
     TRACE("PST: computing spelling table {}-{}");
     assert(_psvs.empty()); // do not recompute
     assert(grid.empty() or grid.index().size() == _index.size());
     
-    // first note of current bar
-    size_t i0 = _enum.first();
-    
-    // current bar number
-    // NOT _enum.measure(i0) if first bar is empty
-    size_t b  = 0;
-    
-    // first note after current bar
-    size_t i1;
-
     // empty seq of notes
-    if (_enum.outside(i0))
+    if (_enum.outside(_enum.first()))
     {
         WARN("PST init: empty sequence of notes");
         return false;
@@ -202,67 +228,515 @@ bool PST::init_psvs(const Cost& seed, const PSG& grid, bool tonal, bool octave)
     // reset table
     _psvs.clear();
     
-    while (_enum.inside(i0))
+    // bounds of all bars, computed in one pass
+    // empty bars b are indexed with i0 == i1 the first note of next bar.
+    PSBars bars(_enum);
+    
+    for (size_t b = 0; b < bars.size(); ++b)
     {
-        assert(_enum.measure(i0) >= b);
-        // the current bar b is empty (i0 is after b)
-        if (_enum.measure(i0) > b)
+        // first note of current bar
+        size_t i0 = bars.first(b);
+        // first note after current bar
+        size_t i1 = bars.stop(b);
+        if (i0 == i1)
         {
             TRACE("PST init: bar {} EMPTY", b);
-            // construction from scratch: vector of empty bags
-            if (grid.empty())
-            {
-                _psvs.emplace_back(std::unique_ptr<PSV>(new
-                PSV(_algo, seed, _index, _enum, i0, i0, b, tonal, octave)));
-            }
-            // construction with grid
-            else
-            {
-                
-                const std::vector<size_t>& locals = grid.column(b);
-                _psvs.emplace_back(std::unique_ptr<PSV>(new
-                PSV(_algo, seed, _index, _enum, i0, i0, b, locals,
-                    tonal, octave)));
-            }
-                        
-            ++b;
-            continue;
         }
-            
-        // the current bar b is not empty (i0 in b). add it.
-        i1 = bound_measure(b, i0); // first note after current measure b
-        TRACE("PST init: bar {} {}-{}", b, i0, i1);
-        assert(_enum.inside(i1 - 1));
-        assert(_enum.measure(i1 - 1) == b);
-        TRACE("PST: compute column of the best spelling table for measure {}\
-              (notes {}-{})", b, i0, i1-1);
+        else
+        {
+            TRACE("PST init: bar {} {}-{}", b, i0, i1);
+            assert(_enum.inside(i1 - 1));
+            assert(_enum.measure(i1 - 1) == b);
+            TRACE("PST: compute column of the best spelling table for measure {}\
+                  (notes {}-{})", b, i0, i1-1);
+        }
+        // construction with grid: the bars of the grid only
+        // (the grid can be shorter in streaming mode)
+        if (not grid.empty() and b >= grid.size())
+        {
+            TRACE("PST init: bar {} not in grid", b);
+            break;
+        }
         // add a PS vector (column) for the measure b
+        // parallel construction: bags computed afterwards
+        if (threads != 1)
+        {
+            _psvs.emplace_back(std::unique_ptr<PSV>(new
+            PSV(_algo, _index, _enum, i0, i1, b, _costonly)));
+        }
         // construction from scratch
-        if (grid.empty())
+        else if (grid.empty())
         {
             _psvs.push_back(std::unique_ptr<PSV>(new
-            PSV(_algo, seed, _index, _enum, i0, i1, b, tonal, octave)));
+            PSV(_algo, seed, _index, _enum, i0, i1, b, tonal, octave,
+                _memo, _automata, _astar, _costonly)));
         }
         // construction with grid
         else
         {
-            assert(b < grid.size()); // measure number
+            assert(i0 == i1 or b < grid.size()); // measure number
             const std::vector<size_t>& locals = grid.column(b);
             _psvs.emplace_back(std::unique_ptr<PSV>(new
             PSV(_algo, seed, _index, _enum, i0, i1, b, locals,
-                tonal, octave)));
+                tonal, octave, _memo, _automata, _astar)));
         }
         assert(_psvs.size() == b+1);
-        // then start next measure
-        i0 = i1; // index of first note of next bar
-        ++b;
     }
     
     // assert(grid.empty() or grid.size() == this->size()); // nb of columns
+    if (threads != 1)
+        eval_psbs(seed, grid, tonal, octave, threads);
     return true;
 }
 
 
+bool PST::init_pruned(const Cost& seed, bool tonal, bool octave, double d)
+{
+    TRACE("PST: computing pruned spelling table {}-{}",
+          _enum.first(), _enum.stop());
+    assert(_psvs.empty()); // do not recompute
+    assert(_rowcost.empty());
+    assert(0 <= d);
+    assert(d < 100);
+    reclaim();
+
+    // empty seq of notes
+    if (_enum.outside(_enum.first()))
+    {
+        WARN("PST init: empty sequence of notes");
+        return false;
+    }
+    
+    if (_index.empty())
+    {
+        ERROR("PST init: no tonality");
+        return false;
+    }
+
+    // columns created empty, bags computed row by row
+    PSBars bars(_enum);
+    for (size_t b = 0; b < bars.size(); ++b)
+    {
+        _psvs.emplace_back(std::unique_ptr<PSV>(new
+        PSV(_algo, _index, _enum, bars.first(b), bars.stop(b), b,
+            _costonly)));
+    }
+    for (size_t i = 0; i < _index.size(); ++i)
+        _rowcost.push_back(seed.shared_zero());
+    
+    // lower bounds of the cells of the representative rows,
+    // cumulated from the right: rest[i][j] is the sum for the columns >= j.
+    const TonTable& table = _index.table();
+    std::vector<size_t> reps;
+    std::vector<std::vector<size_t>> rest(_index.size());
+    for (size_t i = 0; i < _index.size(); ++i)
+    {
+        if (_index.irepresentative(i, tonal) != i)
+            continue;
+        reps.push_back(i);
+        const size_t w = weight(seed, i, tonal);
+        // pitch classes not spelled with the initial state (PSState)
+        const uint16_t outside =
+            ~(tonal?table.pckey(i):table.pcscale(i)) & 0xFFF;
+        rest[i].assign(_psvs.size() + 1, 0);
+        for (size_t j = _psvs.size(); j > 0; --j)
+        {
+            uint16_t pcs = _psvs[j-1]->pcset() & outside;
+            rest[i][j-1] = rest[i][j] + w * std::bitset<12>(pcs).count();
+        }
+    }
+
+    // rows with the smallest lower bounds first, to find a good upper bound
+    std::stable_sort(reps.begin(), reps.end(),
+                     [&rest](size_t a, size_t b)
+                     { return rest[a][0] < rest[b][0]; });
+
+    // best cost of a complete row of a global tonality (upper bound)
+    std::shared_ptr<const Cost> ub = nullptr;
+    PSArena arena;
+    size_t pruned = 0;
+    for (size_t i : reps)
+    {
+        Cost& rc = *(_rowcost[i]);
+        bool cut = false;
+        for (size_t j = 0; j < _psvs.size(); ++j)
+        {
+            if (ub and ub->far(rc.magnitude() + rest[i][j], d))
+            {
+                TRACE("PST: row {} pruned at bar {}", _index.ton(i), j);
+                cut = true;
+                break;
+            }
+            PSV& psv = *(_psvs[j]);
+            psv.initBag(i, seed, tonal, octave, Ton(), &arena,
+                        _memo, _automata, _astar);
+            if (! psv.bag(i).empty())
+                rc += psv.bag(i).cost();
+        }
+
+        // rows of the tonalities equivalent to i
+        for (size_t k = 0; k < _index.size(); ++k)
+        {
+            if (_index.irepresentative(k, tonal) != i)
+                continue;
+            for (size_t j = 0; j < _psvs.size(); ++j)
+                _psvs[j]->shareBag(k, tonal);
+            if (k != i)
+                _rowcost[k] = rc.shared_clone();
+            _exact[k] = ! cut;
+            if (cut)
+                ++pruned;
+            else if (_index.isGlobal(k) and
+                     (ub == nullptr or rc.magnitude() < ub->magnitude()))
+                ub = _rowcost[k];
+        }
+    }
+    
+    if (pruned > 0)
+        _prune = d;
+    TRACE("PST: {} rows pruned", pruned);
+    return true;
+}
+
+
+size_t PST::weight(const Cost& seed, size_t i, bool tonal) const
+{
+    const Ton& ton = _index.ton(i);
+    const enum Accid ACCIDS[5] =
+    { Accid::DoubleFlat, Accid::Flat, Accid::Natural,
+      Accid::Sharp, Accid::DoubleSharp };
+    size_t w = SIZE_MAX;
+    for (int n = 0; n < 7; ++n)
+    {
+        for (const enum Accid& accid : ACCIDS)
+        {
+            const enum NoteName name = NoteName(n);
+            // accidental of the initial state (PSState)
+            if (tonal?(accid == ton.accidKey(name)):
+                Accids::contained(accid, ton.accidScale(name)))
+                continue;
+            std::shared_ptr<Cost> c = seed.shared_zero();
+            c->update(name, accid, true, ton);
+            w = std::min(w, c->primary());
+        }
+    }
+    return (w == SIZE_MAX)?0:w;
+}
+
+
+void PST::rowsum(size_t i)
+{
+    assert(i < _rowcost.size());
+    assert(_seed);
+    _rowcost[i] = _seed->shared_zero();
+    for (size_t j = 0; j < _psvs.size(); ++j)
+    {
+        assert(_psvs[j]);
+        if (! _psvs[j]->undef(i) and ! _psvs[j]->bag(i).empty())
+            *(_rowcost[i]) += _psvs[j]->bag(i).cost();
+    }
+}
+
+
+bool PST::exact(size_t i) const
+{
+    assert(i < _exact.size());
+    return _exact[i];
+}
+
+
+bool PST::exact() const
+{
+    return std::all_of(_exact.cbegin(), _exact.cend(),
+                       [](bool b) { return b; });
+}
+
+
+void PST::complete(size_t i)
+{
+    assert(i < _exact.size());
+    if (_exact[i])
+        return;
+    TRACE("PST: complete row {}", _index.ton(i));
+    assert(_seed);
+    size_t r = _index.irepresentative(i, _tonal);
+    reclaim();
+    PSArena arena;
+    for (size_t j = 0; j < _psvs.size(); ++j)
+    {
+        PSV& psv = *(_psvs[j]);
+        if (psv.undef(r))
+            psv.initBag(r, *_seed, _tonal, _octave, Ton(), &arena,
+                        _memo, _automata, _astar);
+    }
+
+    // rows of the tonalities equivalent to i
+    for (size_t k = 0; k < _index.size(); ++k)
+    {
+        if (_index.irepresentative(k, _tonal) != r)
+            continue;
+        for (size_t j = 0; j < _psvs.size(); ++j)
+            _psvs[j]->shareBag(k, _tonal);
+        rowsum(k);
+        _exact[k] = true;
+    }
+}
+
+
+void PST::complete()
+{
+    for (size_t i = 0; i < _exact.size(); ++i)
+        complete(i);
+    assert(exact());
+    _prune = 100;
+}
+
+
+size_t PST::extend()
+{
+    assert(_algo == Algo::PSE || _algo == Algo::PSD);
+    assert(_seed);
+    assert(_rowcost.size() == _index.size());
+    if (! exact())
+    {
+        WARN("PST extend: complete the pruned rows first");
+        complete();
+    }
+    const PSG dummy(*this); // empty grid
+    const size_t n = _psvs.size();
+    // one after the last note of the enumerator
+    const size_t n1 = _enum.open()?(_enum.first() + _enum.size()):_enum.stop();
+    // first note not in a column
+    size_t i = _enum.first();
+    if (not _psvs.empty())
+    {
+        const PSV& last = *(_psvs.back());
+        assert(last.first() < last.stop()); // the last bar is not empty
+        const size_t b = last.bar();
+        i = last.stop();
+        // notes added to the last bar: recompute its column
+        if (i < n1 and (size_t) _enum.measure(i) == b)
+        {
+            const size_t i0 = last.first();
+            while (i < n1 and (size_t) _enum.measure(i) == b)
+                ++i;
+            TRACE("PST extend: recompute bar {} ({}-{})", b, i0, i);
+            pop_column();
+            push_column(i0, i, b, dummy);
+        }
+    }
+    // new bars
+    while (i < n1)
+    {
+        long bar = _enum.measure(i);
+        assert(0 <= bar);
+        assert((size_t) bar >= _psvs.size());
+        // empty bars before bar
+        while (_psvs.size() < (size_t) bar)
+            push_column(i, i, _psvs.size(), dummy);
+        const size_t i0 = i;
+        while (i < n1 and _enum.measure(i) == bar)
+            ++i;
+        TRACE("PST extend: bar {} ({}-{})", bar, i0, i);
+        push_column(i0, i, (size_t) bar, dummy);
+    }
+    return _psvs.size() - n;
+}
+
+
+size_t PST::extend(const PSG& locals)
+{
+    assert(_algo == Algo::PSE || _algo == Algo::PSD);
+    assert(_seed);
+    assert(locals.nbTons() == _index.size());
+    assert(_rowcost.size() == _index.size());
+    assert(_psvs.size() <= locals.size());
+    const size_t n = _psvs.size();
+    const size_t n1 = _enum.open()?(_enum.first() + _enum.size()):_enum.stop();
+    // first note not in a column
+    size_t i = _psvs.empty()?_enum.first():_psvs.back()->stop();
+    while (_psvs.size() < locals.size())
+    {
+        const size_t b = _psvs.size();
+        const size_t i0 = i;
+        while (i < n1 and (size_t) _enum.measure(i) == b)
+            ++i;
+        TRACE("PST extend: bar {} ({}-{}) with grid", b, i0, i);
+        push_column(i0, i, b, locals);
+    }
+    return _psvs.size() - n;
+}
+
+
+void PST::recompute(size_t j)
+{
+    assert(_algo == Algo::PSE || _algo == Algo::PSD);
+    assert(_rowcost.size() == _index.size());
+    if (! exact())
+    {
+        WARN("PST recompute: complete the pruned rows first");
+        complete();
+    }
+    const PSG dummy(*this); // empty grid
+    replace_column(j, dummy);
+}
+
+
+void PST::recompute(size_t j, const PSG& locals)
+{
+    assert(_algo == Algo::PSE || _algo == Algo::PSD);
+    assert(locals.nbTons() == _index.size());
+    assert(_rowcost.size() == _index.size());
+    assert(j < locals.size());
+    replace_column(j, locals);
+}
+
+
+void PST::reclaim() const
+{
+    if (_automata != nullptr)
+        _automata->reclaim();
+}
+
+
+PSV* PST::new_column(size_t i0, size_t i1, size_t b, const PSG& grid) const
+{
+    assert(_seed);
+    reclaim();
+    if (grid.empty())
+    {
+        return new PSV(_algo, *_seed, _index, _enum, i0, i1, b,
+                       _tonal, _octave, _memo, _automata, _astar, _costonly);
+    }
+    else
+    {
+        assert(b < grid.size());
+        const std::vector<size_t>& locals = grid.column(b);
+        return new PSV(_algo, *_seed, _index, _enum, i0, i1, b, locals,
+                       _tonal, _octave, _memo, _automata, _astar);
+    }
+}
+
+
+void PST::push_column(size_t i0, size_t i1, size_t b, const PSG& grid)
+{
+    assert(_psvs.size() == b);
+    _psvs.emplace_back(std::unique_ptr<PSV>(new_column(i0, i1, b, grid)));
+    // with grid: row costs only for candidate global tonalities
+    add_rowcosts(*(_psvs.back()), not grid.empty());
+}
+
+
+void PST::pop_column()
+{
+    assert(! _psvs.empty());
+    assert(_psvs.back());
+    add_rowcosts(*(_psvs.back()), false, true);
+    _psvs.pop_back();
+}
+
+
+void PST::replace_column(size_t j, const PSG& grid)
+{
+    assert(j < _psvs.size());
+    assert(_psvs[j]);
+    const PSV& old = *(_psvs[j]);
+    const size_t i0 = old.first();
+    const size_t i1 = old.stop();
+    assert(old.bar() == j);
+    TRACE("PST: recompute bar {} ({}-{})", j, i0, i1);
+    // with grid: row costs only for candidate global tonalities
+    add_rowcosts(old, not grid.empty(), true);
+    _psvs[j].reset(new_column(i0, i1, j, grid));
+    add_rowcosts(*(_psvs[j]), not grid.empty());
+}
+
+
+void PST::add_rowcosts(const PSV& psv, bool globals, bool sub)
+{
+    assert(psv.size() == _index.size());
+    for (size_t i = 0; i < _index.size(); ++i)
+    {
+        if (globals and not _index.isGlobal(i))
+            continue;
+        assert(_rowcost.at(i));
+        if (psv.undef(i) or psv.bag(i).empty())
+            continue;
+        if (sub)
+            *(_rowcost[i]) -= psv.bag(i).cost();
+        else
+            *(_rowcost[i]) += psv.bag(i).cost();
+    }
+}
+
+
+void PST::eval_psbs(const Cost& seed, const PSG& grid,
+                    bool tonal, bool octave, size_t threads)
+{
+    // tasks: pairs (column, ton) of bags to compute
+    std::vector<std::pair<size_t, size_t>> tasks;
+    for (size_t j = 0; j < _psvs.size(); ++j)
+    {
+        assert(_psvs[j]);
+        for (size_t i = 0; i < _index.size(); ++i)
+        {
+            // construction from scratch: one bag per representative
+            if (grid.empty() and _psvs[j]->representative(i, tonal))
+                tasks.emplace_back(j, i);
+            // construction with grid: one bag per global
+            else if (not grid.empty() and _index.isGlobal(i))
+                tasks.emplace_back(j, i);
+        }
+    }
+
+    reclaim();
+    // workers given at construction, or started for this table
+    std::unique_ptr<PSPool> own;
+    PSPool* pool = _pool;
+    if (pool == nullptr)
+    {
+        own.reset(new PSPool(threads));
+        pool = own.get();
+    }
+    // one arena per worker, recycled after each bag
+    std::vector<std::unique_ptr<PSArena>> arenas;
+    for (size_t w = 0; w < pool->threads(); ++w)
+        arenas.emplace_back(new PSArena());
+
+    pool->run(tasks.size(), [this, &tasks, &arenas, &seed, &grid,
+                            tonal, octave](size_t k, size_t w)
+    {
+        size_t j = tasks[k].first;
+        size_t i = tasks[k].second;
+        assert(w < arenas.size());
+        PSV& psv = *(_psvs[j]);
+        if (grid.empty())
+        {
+            psv.initBag(i, seed, tonal, octave, Ton(), arenas[w].get(),
+                        _memo, _automata, _astar);
+        }
+        else
+        {
+            assert(psv.bar() < grid.size());
+            const std::vector<size_t>& locals = grid.column(psv.bar());
+            assert(locals.size() == _index.size());
+            assert(locals.at(i) < _index.size());
+            psv.initBag(i, seed, tonal, octave, _index.ton(locals.at(i)),
+                        arenas[w].get(), _memo, _automata, _astar);
+        }
+    });
+
+    // bags of equivalent tons
+    if (grid.empty())
+    {
+        for (size_t j = 0; j < _psvs.size(); ++j)
+            _psvs[j]->shareBags(tonal);
+    }
+    TRACE("PST: {} bags computed with {} threads",
+          tasks.size(), pool->threads());
+}
+
+
 // second construction, using a grid of locals
 /// @todo remove globals, replaced by global flag in ton index
 /// @todo remove tab ?
@@ -293,18 +767,6 @@ bool PST::init_psvs(const Cost& seed, const PSG& grid, bool tonal, bool octave)
 //}
 
 
-size_t PST::bound_measure(size_t bar, size_t i0)
-{
-    size_t i;
-    for (i = i0; (_enum.inside(i)) && (_enum.measure(i) == bar); ++i)
-    {
-        assert(_enum.measure(i) == bar);
-    }
-
-    return i;
-}
-
-
 const Ton& PST::rowHeader(size_t i) const
 {
     assert(i < _index.size());
@@ -376,18 +838,35 @@ bool PST::rename(size_t ig)
     
     assert(ig < _index.size());
     TRACE("PST: rename with estimated global ton {}", _index.ton(ig));
+    complete(ig);
     
     for (size_t i = 0; i < _psvs.size(); ++i)
     {
-        assert(_psvs[i]);
-        PSV& psv = *(_psvs[i]);
-        TRACE("PST: renaming bar {} ({}-{})", i, psv.first(), psv.stop());
-        status = status && psv.rename(ig);
+        TRACE("PST: renaming bar {} ({}-{})", i,
+              _psvs[i]->first(), _psvs[i]->stop());
+        status = status && rename(i, ig);
     }
     return status;
 }
 
 
+bool PST::rename(size_t j, size_t ig)
+{
+    assert(j < _psvs.size());
+    assert(_psvs[j]);
+    assert(ig < _index.size());
+    PSV& psv = *(_psvs[j]);
+    if (_costonly)
+    {
+        assert(_seed);
+        reclaim();
+        psv.materialize(ig, *_seed, _tonal, _octave, _memo, _automata,
+                        _astar);
+    }
+    return psv.rename(ig);
+}
+
+
 // debug
 //bool PST::check_rowcost(const std::vector<PSCost>& rc) const
 //{
@@ -476,9 +955,8 @@ void PST::dump_table(std::ostream& o) const
         {
             assert(_psvs[j]);
             PSV& psv = *(_psvs[j]);
-            const PSB& psb = psv.bag(i);
             srow += " ";
-            if (psb.empty())
+            if (psv.undef(i) or psv.bag(i).empty())
             {
                 srow += std::to_string(j);
                 srow += ":_";
@@ -488,7 +966,7 @@ void PST::dump_table(std::ostream& o) const
                 srow += std::to_string(j);
                 srow += ":";
                 std::stringstream st;
-                psb.cost().print(st);
+                psv.bag(i).cost().print(st);
                 srow += st.str(); // std::to_string(psb.cost().getAccid());
             }
         }
@@ -24,6 +24,9 @@
 #include "TonIndex.hpp"
 #include "Cost.hpp"
 #include "PSVector.hpp"
+#include "PSBMemo.hpp"
+#include "PSAutomaton.hpp"
+#include "PSPool.hpp"
 #include "PSGlobal.hpp" // globals
 #include "PSGrid.hpp"   // locals
 
@@ -64,9 +67,35 @@ public: // construction
     /// @param octave mode for the state transitions: repeat accidents
     /// at different octaves, or reason modulo 12.
     /// @param dflag debug mode (display table during construction).
+    /// @param threads number of threads for the computation of the bags.
+    /// 0 for the number of hardware threads available.
+    /// @param memo cache of results of bag searches shared by all the
+    /// columns of this table, for repeated bars. null for no caching.
+    /// @param automata spelling automata shared by all the bag searches
+    /// of this table. null for computing the transitions during the searches.
+    /// They are removed before a series of searches if their bound is
+    /// reached.
+    /// @param astar A* mode for the bag searches.
+    /// @param prune distance threshold (in percent) of the pruned mode,
+    /// 100 for no pruning. In pruned mode, the rows are computed one by one,
+    /// in the order of their lower bounds, and the computation of a row
+    /// stops as soon as its cost is known to be at a distance larger than
+    /// prune from the cost of the best row of a global tonality.
+    /// Such a row is not exact. The threads are ignored in this mode.
+    /// @param costonly cost-only mode: the bags of this table keep only
+    /// their cost and number of best paths, for the row costs and ranks.
+    /// The best paths of the row of the global tonality are searched again
+    /// when the notes are renamed.
+    /// @param pool workers for the computation of the bags, with the given
+    /// number of threads, e.g. kept by a speller from one table to the next.
+    /// null for workers started for this table.
     /// @warning the enumerator cannot be changed once the object created.
+    /// @see exact(size_t)
     PST(const Algo& a, const Cost& seed, const TonIndex& i, PSEnum& e,
-        bool tonal, bool octave=false, bool dflag=false);
+        bool tonal, bool octave=false, bool dflag=false, size_t threads=1,
+        PSBMemo* memo=nullptr, PSAutomata* automata=nullptr,
+        bool astar=false, double prune=100, bool costonly=false,
+        PSPool* pool=nullptr);
 
     // main constructor.
     // @param e an enumerator of notes for transitions of configs.
@@ -92,14 +121,29 @@ public: // construction
     /// @param e an enumerator of notes for transitions of configs.
     /// Its dimensions must be the same as tab.
     /// @param locals table of local tonalities for tab.
-    /// Its dimensions must be the same as tab.
+    /// Its dimensions must be the same as tab. If it has less columns
+    /// (online grid), only the bars of the grid are computed.
     /// @param tonal mode: tonal or modal, for the construction
     /// of initial state. default = tonal.
     /// @param octave mode for the state transitions: repeat accidents
     /// at different octaves, or reason modulo 12.
     /// @param dflag debug mode (display table during construction).
+    /// @param threads number of threads for the computation of the bags.
+    /// 0 for the number of hardware threads available.
+    /// @param memo cache of results of bag searches shared by all the
+    /// columns of this table, for repeated bars. null for no caching.
+    /// @param automata spelling automata shared by all the bag searches
+    /// of this table. null for computing the transitions during the searches.
+    /// They are removed before a series of searches if their bound is
+    /// reached.
+    /// @param astar A* mode for the bag searches.
+    /// @param pool workers for the computation of the bags, with the given
+    /// number of threads. null for workers started for this table.
     PST(const Algo& a, const Cost& seed, const TonIndex& index, PSEnum& e,
-        const PSG& locals, bool tonal, bool octave=false, bool dflag=false);
+        const PSG& locals, bool tonal, bool octave=false, bool dflag=false,
+        size_t threads=1, PSBMemo* memo=nullptr,
+        PSAutomata* automata=nullptr, bool astar=false,
+        PSPool* pool=nullptr);
 
     /// rebuid a table with the same algo and index as the given table,
     /// and the new given seed and given grid of local tonalities.
@@ -145,7 +189,25 @@ public: // access
     /// must be smaller than rowNb().
     /// @return the sum of the costs of all cells in row i
     /// or an indeterminate cost value if the computation failed.
+    /// If the row is not exact, it is the sum of the costs of the cells
+    /// computed, which is smaller than the sum for the complete row.
     const Cost& rowCost(size_t i) const;
+
+    /// all the cells of the row of given index have been computed,
+    /// hence its row cost is exact.
+    /// @param i the index of a row (ie a candidate tonality).
+    /// must be smaller than rowNb().
+    /// @return false only for a row pruned in pruned mode and not completed.
+    bool exact(size_t i) const;
+
+    /// all the rows of this table are exact.
+    bool exact() const;
+
+    /// distance threshold of the pruned mode of this table,
+    /// 100 if no row was pruned.
+    /// A row which is not exact is at a distance larger than this threshold
+    /// from the best row of a global tonality.
+    inline double threshold() const { return _prune; }
     
     /// number of columns (PS Vectors) in this table,
     /// i.e. nb of measures spelled.
@@ -169,8 +231,71 @@ public: // access
     /// global tonality.
     /// @param ig index of cestimated global tonality = row index.
     /// @return whether renaming succeded for all measures.
+    /// @warning the row ig is completed if it is not exact.
     bool rename(size_t ig);
 
+    /// rename the notes of one column of this table, according to a given
+    /// global tonality.
+    /// @param j index of column. must be smaller than size().
+    /// @param ig index of cestimated global tonality = row index.
+    /// The cell (ig, j) must have been computed.
+    /// @return whether renaming succeded for the measure.
+    /// @warning in cost-only mode, the best paths of the cell are
+    /// searched again.
+    bool rename(size_t j, size_t ig);
+
+    /// compute the missing cells of the row of given index,
+    /// after which the row is exact.
+    /// @param i the index of a row (ie a candidate tonality).
+    /// must be smaller than rowNb().
+    void complete(size_t i);
+
+    /// compute the missing cells of all the rows of this table,
+    /// e.g. for the ranks of the cells in columns, used by grids.
+    void complete();
+
+    /// streaming: update this table, built from scratch (without grid),
+    /// with the notes added to its enumerator since its construction or
+    /// the last extension. The column of the last bar is recomputed
+    /// if notes were added to this bar, and one column is appended for every
+    /// new bar. The row costs are updated with the costs of these columns
+    /// only, hence the time of an extension does not depend on the number
+    /// of columns of this table.
+    /// @return the number of columns appended.
+    /// @warning the rows not exact are completed first.
+    size_t extend();
+
+    /// streaming: update this table, built with a grid of local tonalities,
+    /// with one column for every bar of the given grid not yet in
+    /// this table. The row costs of the global tonalities are updated with
+    /// the costs of these columns only.
+    /// @param locals grid of local tonalities, with the same index as this
+    /// table, and at least as many columns as this table.
+    /// @return the number of columns appended.
+    size_t extend(const PSG& locals);
+
+    /// re-spelling: recompute the column of given index of this table,
+    /// built from scratch (without grid), after the modification of notes
+    /// of its bar. The row costs are updated by subtraction of the costs of
+    /// the former column and addition of the costs of the new column,
+    /// hence the time does not depend on the number of columns of this table.
+    /// @param j column number (number of bar). must be smaller than size().
+    /// @warning the bounds of the bar must not have changed.
+    /// @warning the rows not exact are completed first.
+    void recompute(size_t j);
+
+    /// re-spelling: recompute the column of given index of this table,
+    /// built with a grid of local tonalities, after the modification of
+    /// notes of its bar or of its local tonalities in the grid.
+    /// The row costs of the global tonalities are updated with the costs of
+    /// the former and new columns only.
+    /// @param j column number (number of bar). must be smaller than size().
+    /// @param locals grid of local tonalities, with the same index as this
+    /// table, and the same global tonalities as at the construction of the
+    /// table.
+    /// @warning the bounds of the bar must not have changed.
+    void recompute(size_t j, const PSG& locals);
+
 public: // debug
 
     /// the table content has been correctly initialized.
@@ -240,6 +365,38 @@ private: // data
     
     /// debug mode.
     bool _debug;
+
+    /// cache of results of bag searches, for repeated bars.
+    /// null for no caching.
+    PSBMemo* _memo;
+
+    /// spelling automata for the transitions of the bag searches.
+    /// null for computing the transitions during the searches.
+    PSAutomata* _automata;
+
+    /// workers for the computation of the bags, or null.
+    PSPool* _pool;
+
+    /// A* mode for the bag searches.
+    bool _astar;
+
+    /// null cost of the type of the cells, for the completion of rows.
+    std::shared_ptr<Cost> _seed;
+
+    /// tonal mode of the construction, for the completion of rows.
+    bool _tonal;
+
+    /// octave mode of the construction, for the completion of rows.
+    bool _octave;
+
+    /// distance threshold of the pruned mode, 100 for no pruning.
+    double _prune;
+
+    /// for each row, whether all its cells have been computed.
+    std::vector<bool> _exact;
+
+    /// cost-only mode of the bags of this table.
+    bool _costonly;
     
     
 private:
@@ -253,9 +410,95 @@ private:
     /// ton index and the columns of this table .
     /// @param tonal mode: for the construction of initial state.
     /// @param octave mode: for the state transitions.
+    /// @param threads number of threads for the computation of the bags.
+    /// if it is not 1, the columns are created empty, and their bags are
+    /// computed afterwards by eval_psbs.
     /// @return wether the computation was successful.
     bool init_psvs(const Cost& seed, const PSG& locals,
-                   bool tonal=false, bool octave=false);
+                   bool tonal=false, bool octave=false, size_t threads=1);
+
+    /// compute the columns (PS Vectors) of this table in pruned mode,
+    /// row by row (representative tonalities only), with a branch and bound
+    /// on the row costs, and fill the row costs.
+    /// The lower bound of the cost of a cell is the number of pitch classes
+    /// of the bar out of the initial state of the tonality (they must be
+    /// printed at least once) times the minimal cost of one of these
+    /// accidentals. The initial state is the key signature of the
+    /// tonality in tonal mode and its scale in modal mode.
+    /// The upper bound is the best cost of a complete row of a global
+    /// tonality.
+    /// @param seed cost value of specialized type used to create a null cost
+    /// of the same type.
+    /// @param tonal mode: for the construction of initial state.
+    /// @param octave mode: for the state transitions.
+    /// @param d distance threshold for pruning, smaller than 100.
+    /// @return wether the computation was successful.
+    bool init_pruned(const Cost& seed, bool tonal, bool octave, double d);
+
+    /// minimal increment of the first component of cost (seed type)
+    /// for a printed accidental out of the initial state of the tonality
+    /// of given index, in a bag of this tonality.
+    /// @param i the index of a row (ie a candidate tonality).
+    /// @param tonal mode: for the construction of initial state.
+    size_t weight(const Cost& seed, size_t i, bool tonal) const;
+
+    /// recompute the cost of the row of given index, from its cells.
+    /// @param i the index of a row (ie a candidate tonality).
+    void rowsum(size_t i);
+
+    /// append to this table a column for the given bar,
+    /// computed from scratch or with the given grid, and add the costs of
+    /// its bags to the row costs (for globals only in the latter case).
+    /// @param i0 index of the first note of the bar in the enumerator.
+    /// @param i1 index of the note after the last note of the bar.
+    /// @param b bar number. must be the number of columns of this table.
+    /// @param locals table of local tonalities for tab, or empty.
+    void push_column(size_t i0, size_t i1, size_t b, const PSG& locals);
+
+    /// remove the last column from this table, built from scratch,
+    /// and remove the costs of its bags from the row costs.
+    void pop_column();
+
+    /// remove the spelling automata if their bound is reached.
+    /// Called before bag searches, when no search is in progress.
+    void reclaim() const;
+
+    /// new column for the given bar, computed from scratch if the given
+    /// grid is empty, or with the given grid otherwise.
+    /// @param i0 index of the first note of the bar in the enumerator.
+    /// @param i1 index of the note after the last note of the bar.
+    /// @param b bar number.
+    /// @param locals table of local tonalities for tab, or empty.
+    PSV* new_column(size_t i0, size_t i1, size_t b, const PSG& locals) const;
+
+    /// replace the column of given index by a new column for the same bar,
+    /// computed from scratch or with the given grid, and update the row
+    /// costs (for globals only in the latter case).
+    /// @param j column number. must be smaller than size().
+    /// @param locals table of local tonalities for tab, or empty.
+    void replace_column(size_t j, const PSG& locals);
+
+    /// add the costs of the bags of the given column to the row costs,
+    /// or subtract them.
+    /// @param psv a column of this table.
+    /// @param globals whether only the row costs of the global tonalities
+    /// are updated.
+    /// @param sub whether the costs are subtracted from the row costs.
+    void add_rowcosts(const PSV& psv, bool globals, bool sub=false);
+
+    /// compute concurrently the bags of all the columns of this table,
+    /// created empty.
+    /// One task is run for each pair (bar, ton) with a bag to compute,
+    /// and every task writes its bag at its own position,
+    /// hence the table does not depend on the scheduling of tasks.
+    /// @param seed cost value of specialized type used to create a null cost
+    /// of the same type.
+    /// @param locals table of local tonalities for tab, or empty.
+    /// @param tonal mode: for the construction of initial state.
+    /// @param octave mode: for the state transitions.
+    /// @param threads number of threads, 0 for hardware threads available.
+    void eval_psbs(const Cost& seed, const PSG& locals,
+                   bool tonal, bool octave, size_t threads);
 
     /// compute the columns (PS Vectors) of this table,
     /// filling cells with cost values.
@@ -286,12 +529,6 @@ private:
     // the columns of tab.
     // @todo remove globals, replaced by global flag in ton index.
     // void compute_rowcosts(const Cost& seed, const PSO& globals);
-        
-    /// @param bar measure number (first is 0)
-    /// @param i0 index of first note of the measure (wrt the enumerator)
-    /// @return the index of the first note of the next bar, or the total
-    /// number of note (index of last note + 1) if end of part is reached.
-    size_t bound_measure(size_t bar, size_t i0);
   
 };
 
@@ -18,7 +18,8 @@
 #include "AlgoName.hpp"
 #include "PSEnum.hpp"
 #include "PSOrder.hpp"
-#include "PSConfig0.hpp" // PSC0, PSCQueue
+#include "PSConfig0.hpp" // PSC0
+#include "PSCQueue.hpp"
 #include "PSConfig1.hpp"
 #include "PSConfig1c.hpp"
 #include "PSConfig2.hpp"
@@ -17,37 +17,43 @@ namespace pse {
 
 PSV::PSV(const Algo& algo, const Cost& seed, const TonIndex& index,
          PSEnum& e, size_t i0, size_t i1, size_t bar,
-         bool tonal, bool octave):
+         bool tonal, bool octave, PSBMemo* memo, PSAutomata* automata,
+         bool astar, bool costonly):
 _index(index),
 _algo(algo),
 _enum(e, i0, i1), // window in e
+_notes(e, i0, i1), // copy of the notes of the window
 _bar(bar),
 _psbs(index.size(), nullptr),
 //_psb_total(), // TBR
 //_locals(i.size(), TonIndex::UNDEF),
 //_local_cands(), // emptyset
-_tiebfail(0)
+_tiebfail(0),
+_costonly(costonly)
 {
     // give the vector their definitive size (to use as arrays)
     //_psbs.assign(_index.size(), nullptr);
     //_psb_total.assign(_index.size(), nullptr);
     //_local.assign(_index.size(), TonIndex::UNDEF);
-    init_psbs(seed, tonal, octave);
+    init_psbs(seed, tonal, octave, memo, automata, astar);
 }
 
 
 PSV::PSV(const Algo& algo, const Cost& seed, const TonIndex& index,
          PSEnum& e, size_t i0, size_t i1, size_t bar,
          const std::vector<size_t>& locals,
-         bool tonal, bool octave):
+         bool tonal, bool octave, PSBMemo* memo, PSAutomata* automata,
+         bool astar):
 _index(index),
 _algo(algo),
 _enum(e, i0, i1), // window in e
+_notes(e, i0, i1), // copy of the notes of the window
 _bar(bar),
 _psbs(index.size(), nullptr),
-_tiebfail(0)
+_tiebfail(0),
+_costonly(false)
 {
-    init_psbs(seed, locals, tonal, octave);
+    init_psbs(seed, locals, tonal, octave, memo, automata, astar);
 }
 
 
@@ -110,6 +116,19 @@ _tiebfail(0)
 //}
 
 
+PSV::PSV(const Algo& algo, const TonIndex& index,
+         PSEnum& e, size_t i0, size_t i1, size_t bar, bool costonly):
+_index(index),
+_algo(algo),
+_enum(e, i0, i1), // window in e
+_notes(e, i0, i1), // copy of the notes of the window
+_bar(bar),
+_psbs(index.size(), nullptr),
+_tiebfail(0),
+_costonly(costonly)
+{ }
+
+
 PSV::~PSV()
 {
     TRACE("delete PS Vector {}-{}", enumerator().first(), enumerator().stop());
@@ -161,62 +180,61 @@ const PSB& PSV::bag(size_t i) const
 
 
 // compute _psbs without local tons
-void PSV::init_psbs(const Cost& seed, bool tonal, bool octave)
+void PSV::init_psbs(const Cost& seed, bool tonal, bool octave,
+                    PSBMemo* memo, PSAutomata* automata, bool astar)
 {
-    // for all tons in the ton index
-    for (size_t i = 0; i < _index.size(); ++i)
+    // deterministic algo: all the representative tons in one pass
+    if (_algo == Algo::PSD)
     {
-        // PS Bag is empty if first() = last()
-        TRACE("PSV {}-{} ton {}",
-              enumerator().first(), enumerator().stop(), ton(i));
-        assert(_psbs[i] == nullptr);
-        const Ton& toni = ton(i);
-        
-        if (_algo == Algo::PSE || _algo == Algo::PSD)
+        std::vector<size_t> rows;
+        for (size_t i = 0; i < _index.size(); ++i)
         {
-            // compute PSB of i, optimization to reuse comp. åfor equivalent ton
-            assert(i < _psbs.size());
-            assert(_psbs.at(i) == nullptr);
-            size_t j = _index.irepresentative(i, tonal);
-            assert(j < _index.size());
-            if (j == i)
-            {
-                // arg local ton is ignored
-                _psbs[i] = std::shared_ptr<const PSB>(new
-                PSB(_algo, seed, enumerator(), tonal, octave, toni));
-            }
-            // optimization: do not rebuilt PSB
-            // when it was computed for an equivalent ton
-            // @todo only when see is CostA
-            else
-            {
-                assert(j < _psbs.size());
-                assert(_psbs.at(j) != nullptr);
-                // DEBUG("init_psbs Optim Equiv Tons ({}) {}:{}<-{}:{}",
-                //       (tonal?"tonal":"modal"),
-                //       i, _index.ton(i), j, _index.ton(j));
-                _psbs[i] = _psbs.at(j); // shared_ptr copy
-            }
+            if (representative(i, tonal))
+                rows.push_back(i);
         }
-        else
-        {
-            ERROR("PSV best: unexpected algo {}", _algo);
-        }
-        assert(_psbs[i]);
-        // _psb_total[i] = nullptr;
-        TRACE("compute the best spelling for notes {}-{}, ton = {}",
-              enumerator().first(), enumerator().stop(), ton(i));
-        // "{} accid", _psbs[i]->cost()
+        init_lanes(seed, rows, std::vector<size_t>(), tonal, octave);
+        shareBags(tonal);
+        return;
+    }
+
+    // pool for the configs of all the bags of this column.
+    // recycled after each bag and freed at the end of this column.
+    PSArena arena;
+
+    // for all tons in the ton index
+    for (size_t i = 0; i < _index.size(); ++i)
+    {
+        // compute PSB of i, optimization to reuse comp. for equivalent ton
+        if (representative(i, tonal))
+            initBag(i, seed, tonal, octave, Ton(), &arena, memo, automata,
+                    astar);
     }
+    shareBags(tonal);
 }
 
 
 // compute _psbs with given local tons
 void PSV::init_psbs(const Cost& seed,
                     const std::vector<size_t>& locals,
-                    bool tonal, bool octave)
+                    bool tonal, bool octave,
+                    PSBMemo* memo, PSAutomata* automata, bool astar)
 {
     assert(locals.size() == _index.size());
+    // deterministic algo: all the global tons in one pass
+    if (_algo == Algo::PSD)
+    {
+        std::vector<size_t> rows;
+        for (size_t i = 0; i < _index.size(); ++i)
+        {
+            if (_index.isGlobal(i))
+                rows.push_back(i);
+        }
+        init_lanes(seed, rows, locals, tonal, octave);
+        return;
+    }
+
+    // pool for the configs of all the bags of this column.
+    PSArena arena;
     
     for (size_t i = 0; i < _index.size(); ++i)
     {
@@ -225,36 +243,147 @@ void PSV::init_psbs(const Cost& seed,
             // skip
             continue;
         }
-        TRACE("PSV {}-{} ton {}",
-              enumerator().first(), enumerator().stop(), ton(i));
-        assert(i < _psbs.size());
-        assert(_psbs[i] == nullptr);
         assert(i < _index.size());
-        const Ton& toni = ton(i);
-        assert(toni.defined());
         assert(locals.at(i) != TonIndex::FAILED);
         assert(locals.at(i) != TonIndex::UNDEF);
         assert(locals.at(i) < _index.size());
         const Ton& ltoni = ton(locals.at(i));
         assert(ltoni.defined());
-        // PS Bag is empty if first() = last()
-        if (_algo == Algo::PSE || _algo == Algo::PSD)
+        // no optimization for second table
+        initBag(i, seed, tonal, octave, ltoni, &arena, memo, automata, astar);
+    }
+}
+
+
+void PSV::initBag(size_t i, const Cost& seed, bool tonal, bool octave,
+                  const Ton& lton, PSArena* arena, PSBMemo* memo,
+                  PSAutomata* automata, bool astar)
+{
+    TRACE("PSV {}-{} ton {}",
+          enumerator().first(), enumerator().stop(), ton(i));
+    assert(i < _psbs.size());
+    assert(_psbs.at(i) == nullptr);
+    const Ton& toni = ton(i);
+    assert(toni.defined());
+    // PS Bag is empty if first() = last()
+    if (_algo == Algo::PSD)
+    {
+        // one lane, no search
+        PSL lanes(seed, tonal, octave);
+        lanes.add(toni, lton,
+                  _index.closed()?_index.table().chromanames(i):nullptr);
+        lanes.run(_notes);
+        _psbs[i] = lanes.bag(0, enumerator());
+    }
+    else if (_algo == Algo::PSE)
+    {
+        _psbs[i] = std::shared_ptr<const PSB>(new
+        PSB(_algo, seed, enumerator(), tonal, octave, toni, lton, arena,
+            &_notes, memo, automata,
+            _index.closed()?_index.table().chromanames(i):nullptr, astar,
+            _costonly));
+        // the best paths are pinned in the bag, configs are dead
+        if (arena)
+            arena->reset();
+    }
+    else
+    {
+        ERROR("PSV best: unexpected algo {}", _algo);
+    }
+    assert(_psbs[i]);
+    TRACE("compute the best spelling for notes {}-{}, ton = {}",
+          enumerator().first(), enumerator().stop(), ton(i));
+}
+
+
+void PSV::init_lanes(const Cost& seed, const std::vector<size_t>& rows,
+                     const std::vector<size_t>& locals,
+                     bool tonal, bool octave)
+{
+    assert(_algo == Algo::PSD);
+    assert(locals.empty() or locals.size() == _index.size());
+    PSL lanes(seed, tonal, octave);
+    for (size_t i : rows)
+    {
+        assert(i < _index.size());
+        assert(_psbs.at(i) == nullptr);
+        const enum NoteName* chroma =
+            _index.closed()?_index.table().chromanames(i):nullptr;
+        if (locals.empty())
         {
-            // no optimization for second table
-            _psbs[i] = std::shared_ptr<const PSB>(new
-            PSB(_algo, seed, enumerator(), tonal, octave, toni, ltoni));
+            lanes.add(ton(i), Ton(), chroma);
         }
         else
         {
-            ERROR("PSV best: unexpected algo {}", _algo);
+            assert(locals.at(i) < _index.size());
+            lanes.add(ton(i), ton(locals.at(i)), chroma);
         }
-        assert(_psbs[i]);
-        TRACE("compute the best spelling for notes {}-{}, ton = {}",
-              enumerator().first(), enumerator().stop(), ton(i));
     }
+    lanes.run(_notes);
+    for (size_t k = 0; k < rows.size(); ++k)
+        _psbs[rows[k]] = lanes.bag(k, enumerator());
+}
+
+
+void PSV::materialize(size_t i, const Cost& seed, bool tonal, bool octave,
+                      PSBMemo* memo, PSAutomata* automata, bool astar)
+{
+    assert(i < _psbs.size());
+    assert(_psbs.at(i) != nullptr);
+    if (not _psbs.at(i)->costonly())
+        return;
+    TRACE("PSV {}-{}: search again the best paths for ton {}",
+          enumerator().first(), enumerator().stop(), ton(i));
+    const Ton& toni = ton(i);
+    assert(toni.defined());
+    PSArena arena;
+    std::shared_ptr<const PSB> psb(new
+    PSB(_algo, seed, enumerator(), tonal, octave, toni, Ton(), &arena,
+        &_notes, memo, automata,
+        _index.closed()?_index.table().chromanames(i):nullptr, astar));
+    assert(psb->cost() == _psbs.at(i)->cost());
+    assert(psb->size() == _psbs.at(i)->size());
+    _psbs[i] = psb;
+}
+
+
+bool PSV::representative(size_t i, bool tonal) const
+{
+    assert(i < _index.size());
+    size_t j = _index.irepresentative(i, tonal);
+    assert(j < _index.size());
+    return (j == i);
+}
+
+
+void PSV::shareBags(bool tonal)
+{
+    for (size_t i = 0; i < _index.size(); ++i)
+    {
+        if (_psbs.at(i) != nullptr)
+            continue;
+        // optimization: do not rebuilt PSB
+        // when it was computed for an equivalent ton
+        // @todo only when see is CostA
+        size_t j = _index.irepresentative(i, tonal);
+        assert(j < _psbs.size());
+        assert(j != i);
+        assert(_psbs.at(j) != nullptr);
+        _psbs[i] = _psbs.at(j); // shared_ptr copy
+    }
+}
+
+
+void PSV::shareBag(size_t i, bool tonal)
+{
+    assert(i < _psbs.size());
+    if (_psbs.at(i) != nullptr)
+        return;
+    size_t j = _index.irepresentative(i, tonal);
+    assert(j < _psbs.size());
+    _psbs[i] = _psbs.at(j); // shared_ptr copy, null if not computed
 }
 
-// static
 bool PSV::eq_pcost(const Cost* a, const Cost* b)
 {
     assert(a);
@@ -446,15 +575,11 @@ bool PSV::rename(size_t i)
              _bar, enumerator().first(), enumerator().stop(),
              psb.size(), psb.cost());
 
-        size_t s = 0;
-        for (auto it = psb.cbegin(); it != psb.cend(); ++it)
+        for (size_t s = 0; s < psb.size(); ++s)
         {
-            std::shared_ptr<const PSC0> c = *it;
-            assert(c);
-            const PSP p(*c, _enum);
+            const PSP& p = psb.path(s);
             TRACE("bar {}, ton {}, spell {}: {} {}",
-                   _bar, _index.ton(i), s, p, c->cost());
-            ++s;
+                   _bar, _index.ton(i), s, p, p.cost());
         }
             
         // DEBUGU("PSV {}-{}: tie break fail {}", sms.str());
@@ -463,10 +588,8 @@ bool PSV::rename(size_t i)
     // rename notes in this vector (if any)
     if (not _enum.empty())
     {
-        const PSC0& psc = psb.top();
-        PSP psp(psc, enumerator());
         //std::cout << "PSV: rename path" << std::endl;
-        psp.rename();
+        return psb.rename();
     }
     return true;
 }
@@ -31,8 +31,12 @@
 #include "Ton.hpp"
 #include "TonIndex.hpp"
 #include "PSEnum.hpp"
+#include "PSBarView.hpp"
 #include "PSWindow.hpp"
 #include "PSBag.hpp"
+#include "PSBMemo.hpp"
+#include "PSAutomaton.hpp"
+#include "PSLanes.hpp"
 // #include "PSGlobal.hpp"
 #include "PSPath.hpp"
 
@@ -70,9 +74,18 @@ public: // constructors
     /// of initial state. default = modal.
     /// @param octave mode for the state transitions: repeat accidents
     /// at different octaves, or reason modulo 12.
+    /// @param memo cache of results of bag searches, or null for no caching.
+    /// @param automata spelling automata for the transitions of the bag
+    /// searches, or null.
+    /// @param astar A* mode for the bag searches.
+    /// @param costonly cost-only mode for the bags of the search:
+    /// they keep only their cost and number of best paths.
+    /// The best paths are searched again by materialize when needed.
     PSV(const Algo& a, const Cost& seed, const TonIndex& index,
         PSEnum& e, size_t i0, size_t i1, size_t bar,
-        bool tonal, bool octave=false);
+        bool tonal, bool octave=false, PSBMemo* memo=nullptr,
+        PSAutomata* automata=nullptr, bool astar=false,
+        bool costonly=false);
     
     /// main constructor.
     /// @param a name of pitch-spelling algorithm implemented.
@@ -92,10 +105,15 @@ public: // constructors
     /// of initial state. default = modal.
     /// @param octave mode for the state transitions: repeat accidents
     /// at different octaves, or reason modulo 12.
+    /// @param memo cache of results of bag searches, or null for no caching.
+    /// @param automata spelling automata for the transitions of the bag
+    /// searches, or null.
+    /// @param astar A* mode for the bag searches.
     PSV(const Algo& a, const Cost& seed, const TonIndex& index,
         PSEnum& e, size_t i0, size_t i1, size_t bar,
         const std::vector<size_t>& locals,
-        bool tonal, bool octave=false);
+        bool tonal, bool octave=false, PSBMemo* memo=nullptr,
+        PSAutomata* automata=nullptr, bool astar=false);
     
     // rebuid a column with the same algo, index, and enumerator as the given
     // column, and the new given seed and given column of local tonalities.
@@ -138,6 +156,22 @@ public: // constructors
     // PSV(const Algo& a, const Cost& seed, const TonIndex& index,
     //     const PSEnum& e, size_t i0, size_t bar);
 
+    /// vector with no bag computed.
+    /// the bags must be computed afterwards with initBag and shareBags.
+    /// @param a name of pitch-spelling algorithm implemented.
+    /// @param index array of tonalities. dimension of this vector.
+    /// @param e an enumerator of notes for transitions of configs.
+    /// @param i0 index of the first note to read in enumerator.
+    /// @param i1 index of the note after the last note to read in enumerator.
+    /// must be superior of equal to i0.
+    /// @param bar number of bar corresp.  to this vector
+    /// (column number in table).
+    /// @param costonly cost-only mode for the bags computed by initBag.
+    /// @see PST for the parallel construction of tables.
+    PSV(const Algo& a, const TonIndex& index,
+        PSEnum& e, size_t i0, size_t i1, size_t bar,
+        bool costonly=false);
+
     /// a vector cannot be copied.
     PSV(const PSV& rhs) = delete;
     
@@ -166,6 +200,10 @@ public: // access
     /// algorithm used to compute this vector.
     inline const Algo& algo() const { return _algo; }
 
+    /// set of the pitch classes of the notes of this vector.
+    /// @see PSBarView::pcset
+    inline uint16_t pcset() const { return _notes.pcset(); }
+
     /// vector of tonalities associated to this vector.
     /// it is the row-index of the embedding table.
     inline const TonIndex& index() const { return _index; }
@@ -244,12 +282,74 @@ public: // access
     // @return whether estimation of the local tonality successed.
     // bool estimateLocals(const PSV& prev);
     
+    /// compute the bag of given index.
+    /// Bags of distinct indices can be computed concurrently.
+    /// @param i index in array of tonalities.
+    /// must be smaller than index.size(). the bag must be undef.
+    /// @param seed cost value of specialized type used to create a null cost
+    /// of the same type.
+    /// @param tonal mode: for the construction of initial state.
+    /// @param octave mode: for state transitions.
+    /// @param lton local tonality, or undef.
+    /// @param arena memory pool for the configs of the search,
+    /// or null for allocation in the heap.
+    /// it is reset after the search.
+    /// @param memo cache of results of bag searches, or null for no caching.
+    /// It requires an arena (must be null without arena).
+    /// @param automata spelling automata for the transitions of the search,
+    /// or null.
+    /// @param astar A* mode for the search.
+    /// The bag is in cost-only mode if this vector is (except for PSD).
+    void initBag(size_t i, const Cost& seed, bool tonal, bool octave,
+                 const Ton& lton = Ton(), PSArena* arena = nullptr,
+                 PSBMemo* memo = nullptr, PSAutomata* automata = nullptr,
+                 bool astar = false);
+
+    /// the bag of given index is computed by initBag,
+    /// otherwise, it is shared with its representative (table 1).
+    /// @param i index in array of tonalities.
+    /// must be smaller than index.size().
+    /// @param tonal mode: for the construction of initial state.
+    bool representative(size_t i, bool tonal) const;
+
+    /// every undefined bag of this vector is set to the bag of
+    /// its representative, which must have been computed.
+    /// @param tonal mode: for the construction of initial state.
+    void shareBags(bool tonal);
+
+    /// the bag of given index, if undefined, is set to the bag of
+    /// its representative, if it was computed.
+    /// @param i index in array of tonalities.
+    /// must be smaller than index.size().
+    /// @param tonal mode: for the construction of initial state.
+    void shareBag(size_t i, bool tonal);
+
     /// rename all notes read to build this PS vector.
     /// local tonality is estimated if this was not done before.
     /// @param i index in array of tonalities.
     /// must be smaller than index.size().
     /// @return whether renaming succeeded for this measure.
+    /// It fails if the bag of index i is in cost-only mode.
+    /// @see materialize
     bool rename(size_t i);
+
+    /// compute again, with its best paths, the bag of given index
+    /// if it is in cost-only mode. Its cost is unchanged.
+    /// The bags of the equivalent tonalities stay in cost-only mode.
+    /// @param i index in array of tonalities.
+    /// must be smaller than index.size(). the bag must be defined.
+    /// @param seed cost value of specialized type used to create a null cost
+    /// of the same type.
+    /// @param tonal mode: for the construction of initial state.
+    /// @param octave mode: for state transitions.
+    /// @param memo cache of results of bag searches, or null for no caching.
+    /// @param automata spelling automata for the transitions of the search,
+    /// or null.
+    /// @param astar A* mode for the search.
+    /// @warning the bag must have been computed without local tonality.
+    void materialize(size_t i, const Cost& seed, bool tonal, bool octave,
+                     PSBMemo* memo = nullptr, PSAutomata* automata = nullptr,
+                     bool astar = false);
              
 private: // data
     
@@ -268,6 +368,10 @@ private: // data
     /// defined as a window inside the enumerator of embedding table.
     // const std::unique_ptr<PSEnum> _enum;
     PSWindow _enum;
+
+    /// contiguous copy of the notes of the window,
+    /// read by the embedded PSB's during the best path search.
+    PSBarView _notes;
     
     /// number of bar corresponding to this vector.
     /// info for debugging / tracing.
@@ -297,6 +401,9 @@ private: // data
     
     /// debug counter: nb of tie break fails for estimation of local ton.
     size_t _tiebfail;
+
+    /// cost-only mode for the bags computed in this vector.
+    const bool _costonly;
     
     // the local tonality has been estimated
     // @todo rm or estimated()
@@ -310,7 +417,11 @@ private: // convenience functions
     /// of the same type.
     /// @param tonal mode: for the construction of initial state.
     /// @param octave mode: for state transitions.
-    void init_psbs(const Cost& seed, bool tonal, bool octave);
+    /// @param memo cache of results of bag searches, or null.
+    /// @param automata spelling automata, or null.
+    /// @param astar A* mode for the searches.
+    void init_psbs(const Cost& seed, bool tonal, bool octave,
+                   PSBMemo* memo, PSAutomata* automata, bool astar);
     
     /// fill the vector _psbs with PS Bags constructed with the notes
     /// enumerated and the given local tons.
@@ -319,8 +430,26 @@ private: // convenience functions
     /// @param locals column of local tonalities for tab.
     /// @param tonal mode: for the construction of initial state.
     /// @param octave mode: for state transitions.
+    /// @param memo cache of results of bag searches, or null.
+    /// @param automata spelling automata, or null.
+    /// @param astar A* mode for the searches.
     void init_psbs(const Cost& seed, const std::vector<size_t>& locals,
-                   bool tonal, bool octave);
+                   bool tonal, bool octave,
+                   PSBMemo* memo, PSAutomata* automata, bool astar);
+
+    /// compute the bags of the given rows with the lanes of the
+    /// deterministic algorithm PSD, in one pass over the notes.
+    /// @param seed cost value of specialized type used to create a null cost
+    /// of the same type.
+    /// @param rows indices of the tonalities of the bags to compute.
+    /// their bags must be undef.
+    /// @param locals column of local tonalities, or empty for no local
+    /// tonality.
+    /// @param tonal mode: for the construction of initial state.
+    /// @param octave mode: for state transitions.
+    void init_lanes(const Cost& seed, const std::vector<size_t>& rows,
+                    const std::vector<size_t>& locals,
+                    bool tonal, bool octave);
 
     // initialize the vector _locals of local tonalities
     // bool init_locals();
@@ -9,6 +9,7 @@
 
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
+#include "pybind11/numpy.h"
 
 #include "NoteName.hpp"
 #include "Accid.hpp"
@@ -16,12 +17,196 @@
 #include "Ton.hpp"
 #include "Speller.hpp"
 #include "PSE.hpp"
+#include "PSEBatch.hpp"
 #include "PS13.hpp"
 #include "PS14.hpp"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+// contiguous NumPy array of given type.
+// arrays of other types are converted (copied), the others are not copied.
+template<typename T>
+using pyarray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+
+// set the notes to spell of a speller from NumPy arrays, without copy.
+// the optional arrays can be None.
+// the arrays are kept alive as long as they are viewed by the speller.
+template<class S>
+bool set_notes(S& sp, const pyarray<int64_t>& midi, const pyarray<int64_t>& bar,
+               const py::object& simult,
+               const py::object& dur_num, const py::object& dur_den,
+               bool aux)
+{
+    pse::PSNoteBuffers buf;
+    buf.size = midi.size();
+    if (midi.ndim() != 1 or bar.ndim() != 1 or (size_t) bar.size() != buf.size)
+    {
+        ERROR("set_notes: midi and bar must be 1-dim arrays of same length");
+        return false;
+    }
+    buf.midi = midi.data();
+    buf.bars = bar.data();
+    // keep the arrays alive, with the GIL held at release
+    std::vector<py::object>* keep = new std::vector<py::object>({ midi, bar });
+    
+    if (not simult.is_none())
+    {
+        pyarray<bool> a = pyarray<bool>::ensure(simult);
+        if (not a or a.ndim() != 1 or (size_t) a.size() != buf.size)
+        {
+            ERROR("set_notes: simultaneous must be a 1-dim array of length {}",
+                  buf.size);
+            delete keep;
+            return false;
+        }
+        // the bool elements are read as bytes
+        buf.simult = reinterpret_cast<const uint8_t*>(a.data());
+        keep->push_back(a);
+    }
+    if (not dur_num.is_none())
+    {
+        pyarray<int64_t> a = pyarray<int64_t>::ensure(dur_num);
+        if (not a or a.ndim() != 1 or (size_t) a.size() != buf.size)
+        {
+            ERROR("set_notes: dur_num must be a 1-dim array of length {}",
+                  buf.size);
+            delete keep;
+            return false;
+        }
+        buf.dur_num = a.data();
+        keep->push_back(a);
+    }
+    if (not dur_den.is_none())
+    {
+        pyarray<int64_t> a = pyarray<int64_t>::ensure(dur_den);
+        if (not a or a.ndim() != 1 or (size_t) a.size() != buf.size)
+        {
+            ERROR("set_notes: dur_den must be a 1-dim array of length {}",
+                  buf.size);
+            delete keep;
+            return false;
+        }
+        buf.dur_den = a.data();
+        keep->push_back(a);
+    }
+    buf.owner = std::shared_ptr<const void>(keep,
+                [](std::vector<py::object>* p)
+                {
+                    py::gil_scoped_acquire acquire;
+                    delete p;
+                });
+    return sp.setNotes(buf, aux);
+}
+
+
+// estimated spelling of all the notes of a speller, in one call.
+// return a tuple of 4 NumPy arrays: codes of note names, codes of accidentals,
+// octaves and print flags.
+template<class S>
+py::tuple export_notes(const S& sp, bool aux)
+{
+    size_t n = sp.size(aux);
+    pyarray<int> names(n);
+    pyarray<int> accids(n);
+    pyarray<int> octaves(n);
+    pyarray<bool> prints(n);
+    sp.exportNotes(names.mutable_data(), accids.mutable_data(),
+                   octaves.mutable_data(), prints.mutable_data(), aux);
+    return py::make_tuple(names, accids, octaves, prints);
+}
+
+
+// indices of all the estimated local tonalities of the grid of a speller,
+// in one call, in a 2-dim NumPy array (global ton x measure).
+template<class S>
+pyarray<size_t> export_grid(const S& sp)
+{
+    pyarray<size_t> ilocals({ sp.gridRows(), sp.gridColumns() });
+    if (ilocals.size() > 0)
+        sp.exportGrid(ilocals.mutable_data());
+    return ilocals;
+}
+
+
+// statistics of the cache of bag searches of a speller, in a dictionary.
+// the dictionary is empty if the speller has no cache.
+template<class S>
+py::dict memo_stats(const S& sp)
+{
+    py::dict d;
+    std::shared_ptr<pse::PSBMemo> memo = sp.memo();
+    if (memo)
+    {
+        d["size"] = memo->size();
+        d["hits"] = memo->hits();
+        d["misses"] = memo->misses();
+        d["hit_rate"] = memo->hitRate();
+        d["capacity"] = memo->capacity();
+    }
+    return d;
+}
+
+
+// use a cache of bag searches of given capacity (0 for no bound)
+// for a speller, or no cache.
+template<class S>
+void set_memo(S& sp, bool on, size_t capacity)
+{
+    sp.setMemo(on?std::make_shared<pse::PSBMemo>(capacity):nullptr);
+}
+
+
+// remove all the results of the cache of bag searches of a speller.
+template<class S>
+void clear_memo(S& sp)
+{
+    std::shared_ptr<pse::PSBMemo> memo = sp.memo();
+    if (memo)
+        memo->clear();
+}
+
+
+// use spelling automata for the transitions of the bag searches of a speller,
+// with a bound on their total number of states (0 for no bound),
+// or compute the transitions during the searches.
+template<class S>
+void set_automata(S& sp, bool on, size_t bound)
+{
+    sp.setAutomata(on?std::make_shared<pse::PSAutomata>(bound):nullptr);
+}
+
+
+// remove all the spelling automata of a speller, they are built again
+// by the next searches.
+template<class S>
+void clear_automata(S& sp)
+{
+    std::shared_ptr<pse::PSAutomata> automata = sp.automata();
+    if (automata)
+        automata->clear();
+}
+
+
+// statistics of the spelling automata of a speller, in a dictionary.
+// the dictionary is empty if the speller has no automata.
+template<class S>
+py::dict automata_stats(const S& sp)
+{
+    py::dict d;
+    std::shared_ptr<pse::PSAutomata> automata = sp.automata();
+    if (automata)
+    {
+        d["size"] = automata->size();
+        d["states"] = automata->states();
+        d["rows"] = automata->rows();
+        d["bound"] = automata->bound();
+    }
+    return d;
+}
+
+
 PYBIND11_MODULE(pse, m)
 {
     m.doc() = "binder to PitchSpelling cpp library, for evaluation";
@@ -155,6 +340,17 @@ PYBIND11_MODULE(pse, m)
              "add a new note to spell with duration",
              py::arg("midi"), py::arg("bar"), py::arg("simultaneous"),
              py::arg("dur_num"), py::arg("dur_den"), py::arg("aux"))
+        .def("set_notes", &set_notes<pse::SpellerEnum>,
+             "set all the notes to spell from NumPy arrays, without copy",
+             py::arg("midi"), py::arg("bar"),
+             py::arg("simultaneous") = py::none(),
+             py::arg("dur_num") = py::none(), py::arg("dur_den") = py::none(),
+             py::arg("aux") = false)
+        .def("modify", &pse::SpellerEnum::modify,
+             "replace a note to spell by a note in the same bar, "
+             "for respell (call spell after inserting or deleting notes)",
+             py::arg("i"), py::arg("midi"), py::arg("simultaneous") = false,
+             py::arg("aux") = false)
         .def("add_name", &pse::SpellerEnum::add4,
              "add a new note to speller with forced note name",
              py::arg("midi"), py::arg("bar"), py::arg("simultaneous"),
@@ -183,11 +379,28 @@ PYBIND11_MODULE(pse, m)
         .def("close_tons", &pse::SpellerEnum::closeTons,
              "close the array of tonalities")
         .def("eval_table", &pse::SpellerEnum::evalTable,
-             "construct the spelling table")
+             "construct the spelling table",
+             py::arg("cost_type"), py::arg("tonal") = true,
+             py::arg("octave") = false, py::arg("det") = false,
+             py::arg("aux") = false, py::arg("threads") = 1,
+             py::arg("prune") = 100)
         .def("reval_table", &pse::SpellerEnum::revalTable,
-             "reconstruct the spelling table")
+             "reconstruct the spelling table",
+             py::arg("cost_type"), py::arg("tonal") = true,
+             py::arg("octave") = false, py::arg("det") = false,
+             py::arg("aux") = false, py::arg("threads") = 1)
         .def("eval_grid", &pse::SpellerEnum::evalGrid,
-             "construct the grid of local tons")
+             "construct the grid of local tons",
+             py::arg("algo") = pse::GridAlgo::Rank, py::arg("k") = 1)
+        .def("grid_paths", &pse::SpellerEnum::gridPaths,
+             "number of best paths computed for one row of the exhaustive grid",
+             py::arg("i"))
+        .def("grid_path", &pse::SpellerEnum::gridPath,
+             "indices of local tons of one of the best paths computed for one row of the exhaustive grid",
+             py::arg("i"), py::arg("r") = 0)
+        .def("grid_path_cost", &pse::SpellerEnum::gridPathCost,
+             "cost of one of the best paths computed for one row of the exhaustive grid",
+             py::arg("i"), py::arg("r") = 0)
         .def("select_globals", &pse::SpellerEnum::selectGlobals,
              "compute the subarray of tons selected as candidate global tonality, using the spell table",
              py::arg("d") = 0, py::arg("refine") = false)
@@ -213,6 +426,11 @@ PYBIND11_MODULE(pse, m)
         .def("printed", &pse::SpellerEnum::printed,
              "estimated print flag of note",
              py::arg("i"), py::arg("aux")=false)
+        .def("export_notes", &export_notes<pse::SpellerEnum>,
+             "estimated names, accidentals, octaves and print flags of all notes, as NumPy arrays",
+             py::arg("aux")=false)
+        .def("export_grid", &export_grid<pse::SpellerEnum>,
+             "indices of estimated local tonalities for all global tonalities and bars, as a 2-dim NumPy array")
         .def("globals", &pse::SpellerEnum::globals,
              "get number of candidates (ties) for the estimatation of the global tonality")
         .def("global_ton", &pse::SpellerEnum::global,
@@ -252,6 +470,17 @@ PYBIND11_MODULE(pse, m)
              "add a new note to spell with duration",
              py::arg("midi"), py::arg("bar"), py::arg("simultaneous"),
              py::arg("dur_num"), py::arg("dur_den"), py::arg("aux"))
+        .def("set_notes", &set_notes<pse::PSE>,
+             "set all the notes to spell from NumPy arrays, without copy",
+             py::arg("midi"), py::arg("bar"),
+             py::arg("simultaneous") = py::none(),
+             py::arg("dur_num") = py::none(), py::arg("dur_den") = py::none(),
+             py::arg("aux") = false)
+        .def("modify", &pse::SpellerEnum::modify,
+             "replace a note to spell by a note in the same bar, "
+             "for respell (call spell after inserting or deleting notes)",
+             py::arg("i"), py::arg("midi"), py::arg("simultaneous") = false,
+             py::arg("aux") = false)
         .def("add_name", &pse::SpellerEnum::add4,
              "add a new note to speller with forced note name",
              py::arg("midi"), py::arg("bar"), py::arg("simultaneous"),
@@ -282,8 +511,32 @@ PYBIND11_MODULE(pse, m)
              "close the array of tonalities")
         .def("set_global", &pse::PSE::setGlobal,
              "force global tonality")
-        .def("spell", &pse::PSE::spell,
+        .def("set_astar", &pse::PSE::setAstar,
+             "set A* mode for the bag searches", py::arg("on"))
+        .def("set_memo", &set_memo<pse::PSE>,
+             "use a cache of bag searches for repeated bars, "
+             "with a bound on its number of results (0 for no bound)",
+             py::arg("on"), py::arg("capacity") = pse::PSBMemo::CAPACITY)
+        .def("clear_memo", &clear_memo<pse::PSE>,
+             "remove the results of the cache of bag searches")
+        .def("set_automata", &set_automata<pse::PSE>,
+             "use spelling automata for the transitions of the bag searches, "
+             "with a bound on their number of states (0 for no bound)",
+             py::arg("on"), py::arg("bound") = 200000)
+        .def("clear_automata", &clear_automata<pse::PSE>,
+             "remove the spelling automata built so far")
+        .def("spell",
+             static_cast<bool (pse::PSE::*)()>(&pse::PSE::spell),
              "compute spelling")
+        .def("stream", &pse::PSE::stream,
+             "spell the notes added whose bar is followed by lag complete bars",
+             py::arg("last") = false, py::arg("lag") = 2)
+        .def("spelled", &pse::PSE::spelled,
+             "number of notes spelled in streaming mode")
+        .def("restart", &pse::PSE::restart,
+             "restart streaming from the first note")
+        .def("respell", &pse::PSE::respell,
+             "recompute spelling after replacement of notes with modify")
         .def("rename", &pse::PSE::rename,
              "rename input notes")
         .def("rename0", &pse::PSE::rename0,
@@ -326,7 +579,16 @@ PYBIND11_MODULE(pse, m)
              py::arg("i"), py::arg("aux")=false)
         .def("printed", &pse::PSE::printed,
              "estimated print flag of note",
-             py::arg("i"), py::arg("aux")=false);
+             py::arg("i"), py::arg("aux")=false)
+        .def("export_notes", &export_notes<pse::PSE>,
+             "estimated names, accidentals, octaves and print flags of all notes, as NumPy arrays",
+             py::arg("aux")=false)
+        .def("export_grid", &export_grid<pse::PSE>,
+             "indices of estimated local tonalities for all global tonalities and bars, as a 2-dim NumPy array")
+        .def("memo_stats", &memo_stats<pse::PSE>,
+             "number of results, hits, misses, hit rate and capacity of the cache of searches for repeated bars")
+        .def("automata_stats", &automata_stats<pse::PSE>,
+             "number of automata, states and rows of transitions, and bound of the spelling automata");
     
     py::class_<pse::PS13>(m, "PS13")
         .def(py::init<>(), "Spell Checker PS13")
@@ -350,6 +612,12 @@ PYBIND11_MODULE(pse, m)
              "add a new note to spell with duration",
              py::arg("midi"), py::arg("bar"), py::arg("simultaneous"),
              py::arg("dur_num"), py::arg("dur_den"), py::arg("aux"))
+        .def("set_notes", &set_notes<pse::PS13>,
+             "set all the notes to spell from NumPy arrays, without copy",
+             py::arg("midi"), py::arg("bar"),
+             py::arg("simultaneous") = py::none(),
+             py::arg("dur_num") = py::none(), py::arg("dur_den") = py::none(),
+             py::arg("aux") = false)
         .def("add_name", &pse::SpellerEnum::add4,
              "add a new note to speller with forced note name",
              py::arg("midi"), py::arg("bar"), py::arg("simultaneous"),
@@ -363,6 +631,13 @@ PYBIND11_MODULE(pse, m)
              py::arg("printed"), py::arg("aux"))
         .def("spell", &pse::PS13::spell,
              "spell notes")
+        .def("stream", &pse::PS13::stream,
+             "spell the notes added whose Kpost next notes are known",
+             py::arg("last") = false)
+        .def("spelled", &pse::PS13::spelled,
+             "number of notes spelled in streaming mode")
+        .def("restart", &pse::PS13::restart,
+             "restart streaming from the first note")
         .def("rewrite_passing", &pse::PS13::rewritePassing,
              "rewrite passing notes")
         .def("name",  &pse::PS13::name,
@@ -377,6 +652,11 @@ PYBIND11_MODULE(pse, m)
         .def("printed", &pse::PS13::printed,
              "estimated print flag of note",
              py::arg("i"), py::arg("aux")=false)
+        .def("export_notes", &export_notes<pse::PS13>,
+             "estimated names, accidentals, octaves and print flags of all notes, as NumPy arrays",
+             py::arg("aux")=false)
+        .def("export_grid", &export_grid<pse::PS13>,
+             "indices of estimated local tonalities for all global tonalities and bars, as a 2-dim NumPy array")
         .def("locals", &pse::PS13::locals,
              "the local tonality grid has been estimated")
         .def("globals", &pse::PS13::globals,
@@ -401,6 +681,12 @@ PYBIND11_MODULE(pse, m)
              "add a new note to spell with duration",
              py::arg("midi"), py::arg("bar"), py::arg("simultaneous"),
              py::arg("dur_num"), py::arg("dur_den"), py::arg("aux"))
+        .def("set_notes", &set_notes<pse::PS14>,
+             "set all the notes to spell from NumPy arrays, without copy",
+             py::arg("midi"), py::arg("bar"),
+             py::arg("simultaneous") = py::none(),
+             py::arg("dur_num") = py::none(), py::arg("dur_den") = py::none(),
+             py::arg("aux") = false)
         .def("add_name", &pse::SpellerEnum::add4,
              "add a new note to speller with forced note name",
              py::arg("midi"), py::arg("bar"), py::arg("simultaneous"),
@@ -473,5 +759,67 @@ PYBIND11_MODULE(pse, m)
              py::arg("i"), py::arg("aux")=false)
         .def("printed", &pse::PS14::printed,
              "estimated print flag of note",
-             py::arg("i"), py::arg("aux")=false);
+             py::arg("i"), py::arg("aux")=false)
+        .def("export_notes", &export_notes<pse::PS14>,
+             "estimated names, accidentals, octaves and print flags of all notes, as NumPy arrays",
+             py::arg("aux")=false)
+        .def("export_grid", &export_grid<pse::PS14>,
+             "indices of estimated local tonalities for all global tonalities and bars, as a 2-dim NumPy array");
+
+    // batch spelling of many parts, concurrently, without the GIL
+    m.def("spell_batch",
+          [](const std::vector<std::vector<int>>& midis,
+             const std::vector<std::vector<int>>& bars,
+             const std::vector<std::vector<bool>>& simults,
+             size_t nb_tons,
+             pse::CostType ct0,
+             pse::CostType ct1,
+             size_t threads,
+             bool memo)
+    {
+        // conversion of the input lists, with the GIL held
+        std::vector<pse::PSENotes> parts(midis.size());
+        for (size_t k = 0; k < midis.size(); ++k)
+        {
+            parts[k].midi = midis[k];
+            if (k < bars.size())
+                parts[k].bars = bars[k];
+            if (k < simults.size())
+                parts[k].simult = simults[k];
+            // the notes are not checked by the spellers in release mode
+            std::string msg;
+            if (not pse::PSEBatch::check(parts[k], msg))
+                throw py::value_error("spell_batch: part " +
+                                      std::to_string(k) + ": " + msg);
+        }
+        std::vector<pse::PSESpelling> res;
+        {
+            py::gil_scoped_release release;
+            pse::PSEBatch batch(nb_tons, ct0, ct1, threads, memo);
+            res = batch.spell(parts);
+        }
+        py::list out;
+        for (const pse::PSESpelling& r : res)
+        {
+            py::dict d;
+            d["status"] = r.status;
+            d["names"] = r.names;
+            d["accids"] = r.accids;
+            d["octaves"] = r.octaves;
+            d["printed"] = r.printed;
+            d["globals"] = r.globals;
+            out.append(d);
+        }
+        return out;
+    },
+    "spell a list of parts concurrently with PSE, "
+    "return for each part a dictionary of spelling results. "
+    "raise ValueError if the notes of a part are not valid",
+    py::arg("midis"), py::arg("bars"),
+    py::arg("simults") = std::vector<std::vector<bool>>(),
+    py::arg("nb_tons") = 30,
+    py::arg("cost_type0") = pse::CostType::ACCID,
+    py::arg("cost_type1") = pse::CostType::ADplus,
+    py::arg("threads") = 0,
+    py::arg("memo") = true);
 }
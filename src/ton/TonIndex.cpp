@@ -30,12 +30,32 @@ _repr_modal(),
 _WeberModal(false),
 _WeberBluesModal(false),
 _rankWeber(),
+_table(),
 _ordering(this, 0, ModeName::Major),
 _backup_globals() // initially empty
 {
     init(n);
 }
 
+
+TonIndex::TonIndex(const TonIndex& rhs):
+_tons(rhs._tons),
+_undef(),
+_closed(rhs._closed),
+_repr_tonal(rhs._repr_tonal),
+_repr_modal(rhs._repr_modal),
+_WeberModal(rhs._WeberModal),
+_WeberBluesModal(rhs._WeberBluesModal),
+_rankWeber(rhs._rankWeber),
+_table(rhs._table),
+_ordering(this, rhs._ordering.base.fifths(), rhs._ordering.base.getMode()),
+_backup_globals(rhs._backup_globals)
+{
+    assert(rhs._closed);
+    resetGlobals();
+}
+
+
 TonIndex::~TonIndex()
 {
     _tons.clear();
@@ -168,6 +188,7 @@ void TonIndex::reset(size_t n)
     TRACE("TonIndex: empty the list of tonalities (row headers)");
     _tons.clear();
     _backup_globals.clear();
+    _table.clear();
     _closed = false;
     _WeberModal = false;
     _WeberBluesModal = false;
@@ -333,6 +354,11 @@ void TonIndex::close()
     
     // build Weber tables
     initRankWeber();
+
+    // tabulate the queries to the tons, in the order of this index
+    assert(_table.size() == 0);
+    for (size_t i = 0; i < _tons.size(); ++i)
+        _table.add(_tons.at(i).first);
 }
 
 
@@ -342,6 +368,14 @@ bool TonIndex::closed() const
 }
 
 
+const TonTable& TonIndex::table() const
+{
+    assert(_closed);
+    assert(_table.size() == _tons.size());
+    return _table;
+}
+
+
 void TonIndex::init(size_t n)
 {
     switch (n)
@@ -628,6 +662,10 @@ size_t TonIndex::selectGlobals(const PST& tab, double d, bool refine)
 
         assert(i != TonIndex::FAILED);
         assert(i != TonIndex::UNDEF);
+
+        // pruned row, far from the best
+        if (! tab.exact(i))
+            continue;
                                 
         // new best ton
         if (ibest == TonIndex::UNDEF or
@@ -661,6 +699,13 @@ size_t TonIndex::selectGlobals(const PST& tab, double d, bool refine)
         if (refine and !isGlobal(i))
             continue;
 
+        // pruned row, at a distance larger than tab.threshold() >= d
+        if (! tab.exact(i))
+        {
+            unsetGlobal(i);
+            continue;
+        }
+
         const Cost& rc = tab.rowCost(i);
 
         // real tie
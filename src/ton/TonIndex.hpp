@@ -23,6 +23,7 @@
 #include "KeyFifth.hpp"
 #include "ModeName.hpp"
 #include "Ton.hpp"
+#include "TonTable.hpp"
 
 namespace pse {
 
@@ -81,8 +82,14 @@ public: // construction
     /// (close() must be called aterwards). All the others are closed.
     TonIndex(size_t nb=0);
 
-    /// a ton index cannot be copied.
-    TonIndex(const TonIndex& rhs) = delete;
+    /// copy of a closed ton index.
+    /// The copy does not share any data with the given ton index.
+    /// The global flags of the copy are the initial ones
+    /// (before selection of globals in the given ton index).
+    /// @param rhs ton index to copy. must be closed.
+    /// @warning it is cheaper than the construction and closure
+    /// of a new ton index, as the tables of Weber distances are not recomputed.
+    TonIndex(const TonIndex& rhs);
     
     /// destructor.
     virtual ~TonIndex();
@@ -203,6 +210,8 @@ public: // sub array of tonalities that can be global.
     /// in the first case, the new set of globals is a subset of the current
     /// one, in the second case, it may be orthogonal.
     /// @return the number of tonalities selected by this function.
+    /// @warning the rows of tab which are not exact are not selected,
+    /// d must not be larger than the threshold of tab.
     // @warning call eGlobals_eq and eGlobals_less variants to operator==
     // and operator< on cost.
     size_t selectGlobals(const PST& tab, double d=0, bool refine=true);
@@ -252,6 +261,13 @@ private: // convenience for sub array of tonalities that can be global.
     /// must be smaller than size().
     void unsetGlobal(size_t i);
 
+public: // tabulation
+
+    /// flattened tabulation of the queries to the tonalities of this array,
+    /// by index of tonality.
+    /// @warning this array of tonalities must be closed.
+    const TonTable& table() const;
+
 public: // Weber distances
     
     /// distance between the two tons at given indices,
@@ -305,6 +321,9 @@ private: // data
     /// to the distance to ton i in this index.
     /// tabulation for speedup
     std::vector<std::vector<size_t>> _rankWeber;
+
+    /// tabulation of the queries to the tonalities, built at closure.
+    TonTable _table;
     
     /// for initial sorting of this ton index.
     /// compare tons, ignore global flag.
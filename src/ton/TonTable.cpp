@@ -0,0 +1,96 @@
+//
+//  TonTable.cpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+#include "TonTable.hpp"
+#include "MidiNum.hpp"
+
+
+namespace pse {
+
+
+TonTable::TonTable():
+_chroma(),
+_pcscale(),
+_pckey()
+{ }
+
+
+TonTable::~TonTable()
+{ }
+
+
+void TonTable::clear()
+{
+    _chroma.clear();
+    _pcscale.clear();
+    _pckey.clear();
+}
+
+
+void TonTable::add(const Ton& ton)
+{
+    assert(ton.defined());
+    const bool ktonic = tonic(ton.getMode());
+    // the table of key signatures is for KS in -7..7
+    const bool ksig = (-7 <= ton.fifths() and ton.fifths() <= 7);
+    const enum Accid ACCIDS[5] =
+    { Accid::DoubleFlat, Accid::Flat, Accid::Natural,
+      Accid::Sharp, Accid::DoubleSharp };
+    uint16_t pcs = 0;
+    uint16_t pck = 0;
+
+    for (int n = 0; n < 7; ++n)
+    {
+        const enum NoteName name = NoteName(n);
+        if (ksig)
+            pck |= (1 << MidiNum::pitchClass(name, ton.accidKey(name)));
+        const accids_t scale = ton.accidScale(name);
+        for (const enum Accid& accid : ACCIDS)
+        {
+            if (Accids::contained(accid, scale))
+                pcs |= (1 << MidiNum::pitchClass(name, accid));
+        }
+    }
+
+    for (int pc = 0; pc < 12; ++pc)
+        _chroma.push_back(ktonic?ton.chromaname(pc):NoteName::Undef);
+    _pcscale.push_back(pcs);
+    _pckey.push_back(pck);
+}
+
+
+bool TonTable::tonic(const ModeName& mode)
+{
+    switch (mode)
+    {
+        case ModeName::Major:
+        case ModeName::Ionian:
+        case ModeName::Minor:
+        case ModeName::MinorNat:
+        case ModeName::Aeolian:
+        case ModeName::MinorMel:
+        case ModeName::Dorian:
+        case ModeName::Phrygian:
+        case ModeName::Lydian:
+        case ModeName::Mixolydian:
+        case ModeName::Locrian:
+        case ModeName::MajorBlues:
+        case ModeName::MinorBlues:
+        case ModeName::Chromatic:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+
+} // namespace pse
+
+/// @}
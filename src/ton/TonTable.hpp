@@ -0,0 +1,124 @@
+//
+//  TonTable.hpp
+//  pse
+//
+//  Created by agent on 18/10/2026.
+//
+/// @addtogroup pitch
+/// @{
+
+
+#ifndef TonTable_hpp
+#define TonTable_hpp
+
+#include <iostream>
+#include <assert.h>
+#include <vector>
+#include <cstdint>
+
+#include "pstrace.hpp"
+#include "NoteName.hpp"
+#include "Accid.hpp"
+#include "Accids.hpp"
+#include "ModeName.hpp"
+#include "Ton.hpp"
+
+namespace pse {
+
+/// flattened tabulation of the queries to the tonalities of a TonIndex
+/// read on the hot paths of the spelling procedures:
+/// the names of the chromatic harmonic scale, read by pitch class
+/// in the deterministic algorithm, and the sets of pitch classes of the
+/// scales and key signatures, for the lower bounds of row costs.
+/// The values are the ones returned by the corresponding functions of Ton.
+/// The names not defined for the mode of a tonality are undef.
+/// @see TonIndex::close() where the table is built.
+class TonTable
+{
+public: // construction
+
+    /// empty table.
+    TonTable();
+
+    TonTable(const TonTable& rhs) = default;
+
+    ~TonTable();
+
+    TonTable& operator=(const TonTable& rhs) = default;
+
+    /// add the tabulation of the given tonality, at index size().
+    /// @param ton a defined tonality.
+    void add(const Ton& ton);
+
+    /// remove all the tabulations.
+    void clear();
+
+public: // access
+
+    /// number of tonalities tabulated.
+    inline size_t size() const { return _pcscale.size(); }
+
+    /// @see Ton::chromaname
+    /// @param i index of a tonality, smaller than size().
+    /// @param pc a pitch class in 0..11.
+    inline enum NoteName chromaname(size_t i, unsigned int pc) const
+    {
+        assert(pc < 12);
+        assert(12 * i + pc < _chroma.size());
+        return _chroma[12 * i + pc];
+    }
+
+    /// the 12 note names of the chromatic harmonic scale associated to the
+    /// tonality, by pitch class. They are contiguous in this table.
+    /// @param i index of a tonality, smaller than size().
+    /// @see Ton::chromaname
+    inline const enum NoteName* chromanames(size_t i) const
+    {
+        assert(i < size());
+        return _chroma.data() + 12 * i;
+    }
+
+    /// set of the pitch classes of the scale of the tonality,
+    /// pitch class p is in the set iff bit p is 1.
+    /// @param i index of a tonality, smaller than size().
+    /// @see Ton::accidScale
+    inline uint16_t pcscale(size_t i) const
+    {
+        assert(i < _pcscale.size());
+        return _pcscale[i];
+    }
+
+    /// set of the pitch classes of the key signature of the tonality
+    /// (one accidental for every name), pitch class p is in the set iff
+    /// bit p is 1. Empty if the tonality has no key signature.
+    /// @param i index of a tonality, smaller than size().
+    /// @see Ton::accidKey
+    inline uint16_t pckey(size_t i) const
+    {
+        assert(i < _pckey.size());
+        return _pckey[i];
+    }
+
+private: // data
+
+    /// names in chromatic harmonic scale, by ton and pitch class.
+    std::vector<enum NoteName> _chroma;
+
+    /// sets of pitch classes of the scale, by ton.
+    std::vector<uint16_t> _pcscale;
+
+    /// sets of pitch classes of the key signature, by ton.
+    std::vector<uint16_t> _pckey;
+
+private:
+
+    /// the tonic (chromaname) is defined for the mode.
+    static bool tonic(const ModeName& mode);
+
+};
+
+} // namespace pse
+
+#endif /* TonTable_hpp */
+
+/// @}
@@ -0,0 +1,86 @@
+//
+//  TestArena.cpp
+//  testpse
+//
+//  Created by agent on 17/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include "Ton.hpp"
+#include "PSRawEnum.hpp"
+#include "CostA.hpp"
+#include "PSArena.hpp"
+#include "PSBag.hpp"
+
+
+TEST(PSArena, alloc)
+{
+    pse::PSArena a(256);
+    EXPECT_EQ(a.capacity(), 0);
+
+    void* p1 = a.allocate(24, 8);
+    void* p2 = a.allocate(24, 8);
+    EXPECT_NE(p1, p2);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p2) % 8, 0);
+    EXPECT_EQ(a.live(), 2);
+    EXPECT_EQ(a.capacity(), 256);
+
+    void* p3 = a.allocate(1024, 8); // larger than a block
+    EXPECT_EQ(a.live(), 3);
+    EXPECT_EQ(a.capacity(), 256);
+
+    a.deallocate(p1, 24);
+    a.deallocate(p2, 24);
+    a.deallocate(p3, 1024);
+    EXPECT_EQ(a.live(), 0);
+    a.reset();
+    EXPECT_EQ(a.allocated(), 0);
+    EXPECT_EQ(a.capacity(), 256); // blocks are recycled
+    EXPECT_EQ(a.allocate(24, 8), p1);
+    a.deallocate(p1, 24);
+}
+
+TEST(PSArena, shared)
+{
+    pse::PSArena a;
+    {
+        std::shared_ptr<int> p =
+        std::allocate_shared<int>(pse::PSArenaAllocator<int>(a), 3);
+        EXPECT_EQ(*p, 3);
+        EXPECT_EQ(a.live(), 1);
+    }
+    EXPECT_EQ(a.live(), 0);
+}
+
+TEST(PSArena, bag)
+{
+    pse::Ton t(-3, pse::ModeName::Major);
+    pse::PSRawEnum e(0, 4);
+    pse::CostA c0;
+
+    e.add(55, 0); // G3
+    e.add(56, 0); // Ab3
+    e.add(58, 0); // Bb3
+    e.add(55, 0); // G3
+
+    pse::PSArena a;
+    // tonal, no octave
+    pse::PSB b0(pse::Algo::PSE, c0, e, true, false, t);
+    pse::PSB b1(pse::Algo::PSE, c0, e, true, false, t, pse::Ton(), &a);
+
+    // all the configs are dead, the best paths are pinned in the bag
+    EXPECT_EQ(a.live(), 0);
+    EXPECT_GT(a.allocated(), 0);
+    a.reset();
+
+    EXPECT_FALSE(b1.empty());
+    EXPECT_EQ(b1.size(), b0.size());
+    EXPECT_EQ(b1.cost(), b0.cost());
+    EXPECT_FALSE(b1.configs());
+    for (size_t i = e.first(); i < e.stop(); ++i)
+    {
+        EXPECT_EQ(b1.path(0).name(i), b0.path(0).name(i));
+        EXPECT_EQ(b1.path(0).alteration(i), b0.path(0).alteration(i));
+    }
+}
@@ -0,0 +1,157 @@
+//
+//  TestAutomaton.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include "TonIndex.hpp"
+#include "PSRawEnum.hpp"
+#include "CostADplus.hpp"
+#include "Enharmonic.hpp"
+#include "PSState1.hpp"
+#include "PSState2.hpp"
+#include "PSStateP.hpp"
+#include "PSAutomaton.hpp"
+#include "PSTable.hpp"
+
+
+// the packed states are updated as the states of PSState1 and PSState2.
+TEST(PSStateP, update)
+{
+    for (int ks = -7; ks <= 7; ks += 3)
+    {
+        for (bool tonal : { true, false })
+        {
+            pse::Ton ton(ks, tonal?pse::ModeName::Major:pse::ModeName::Minor);
+            pse::PSState1 s1(ton, tonal);
+            pse::PSState2 s2(ton, tonal);
+            pse::PSStateM p1(ton, tonal);
+            pse::PSStateO p2(ton, tonal);
+            pse::PSStateM p1a(p1); // copy
+            EXPECT_TRUE(p1a == p1);
+            EXPECT_EQ(p1a.hash(), p1.hash());
+            unsigned int seed = 7 + ks;
+            for (size_t k = 0; k < 200; ++k)
+            {
+                seed = seed * 1103515245 + 12345;
+                unsigned int m = 24 + (seed >> 16) % 84;
+                int j = (seed >> 8) % 3;
+                enum pse::NoteName n = pse::Enharmonics::name(m%12, j);
+                enum pse::Accid a = pse::Enharmonics::accid(m%12, j);
+                if (not defined(n))
+                    continue;
+                int o = pse::MidiNum::midi_to_octave(m, n);
+                EXPECT_EQ(p1.update(a, n, o), s1.update(a, n, o));
+                EXPECT_EQ(p2.update(a, n, o), s2.update(a, n, o));
+                for (unsigned int pc = 0; pc < 12; ++pc)
+                {
+                    EXPECT_EQ(p1.lastName(pc), s1.lastName(pc));
+                    EXPECT_EQ(p2.lastName(pc), s2.lastName(pc));
+                }
+                for (int i = 0; i < 7; ++i)
+                {
+                    enum pse::NoteName ni = pse::NoteName(i);
+                    EXPECT_EQ(p1.accids(ni, o), s1.accids(ni, o));
+                    EXPECT_EQ(p2.accids(ni, o), s2.accids(ni, o));
+                }
+            }
+            EXPECT_FALSE(p1a == p1);
+        }
+    }
+}
+
+
+// the tables built with the transitions of spelling automata
+// are the same as the tables built without,
+// and the automata are reused from one table to the next.
+TEST(PSAutomaton, table)
+{
+    pse::TonIndex id(26); // closed
+    pse::PSRawEnum e(0, 96);
+    pse::CostADplus seed;
+    const std::vector<unsigned int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    for (size_t b = 0; b < 12; ++b)
+        for (size_t k = 0; k < frag.size(); ++k)
+            e.add(frag[(b%2)?(frag.size()-1-k):k] + b + 12*(k%2), b,
+                  (b%3 == 0) and (k%4 < 2));
+
+    for (bool octave : { false, true })
+    {
+        pse::PSAutomata automata;
+        pse::PST t0(pse::Algo::PSE, seed, id, e, true, octave, false, 1);
+        pse::PST ta(pse::Algo::PSE, seed, id, e, true, octave, false, 1,
+                    nullptr, &automata);
+        ASSERT_EQ(ta.size(), t0.size());
+        for (size_t i = 0; i < id.size(); ++i)
+            EXPECT_EQ(ta.rowCost(i), t0.rowCost(i));
+        for (size_t j = 0; j < t0.size(); ++j)
+        {
+            for (size_t i = 0; i < id.size(); ++i)
+            {
+                const pse::PSB& b0 = t0.column(j).bag(i);
+                const pse::PSB& ba = ta.column(j).bag(i);
+                EXPECT_EQ(ba.cost(), b0.cost());
+                ASSERT_EQ(ba.size(), b0.size());
+                for (size_t n = t0.column(j).first();
+                     n < t0.column(j).stop(); ++n)
+                {
+                    EXPECT_EQ(ba.path(0).name(n), b0.path(0).name(n));
+                    EXPECT_EQ(ba.path(0).printed(n), b0.path(0).printed(n));
+                }
+            }
+        }
+        EXPECT_GT(automata.size(), 0);
+        size_t states = automata.states();
+        size_t rows = automata.rows();
+        pse::PST tb(pse::Algo::PSE, seed, id, e, true, octave, false, 4,
+                    nullptr, &automata);
+        for (size_t i = 0; i < id.size(); ++i)
+            EXPECT_EQ(tb.rowCost(i), t0.rowCost(i));
+        EXPECT_EQ(automata.states(), states);
+        EXPECT_EQ(automata.rows(), rows);
+    }
+}
+
+
+// with a bound on the number of states, the searches stop using the
+// automata when it is reached, and the automata are removed before
+// the next table. The tables are the same as without automata.
+TEST(PSAutomaton, bound)
+{
+    pse::TonIndex id(26); // closed
+    pse::PSRawEnum e(0, 96);
+    pse::CostADplus seed;
+    const std::vector<unsigned int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    for (size_t b = 0; b < 12; ++b)
+        for (size_t k = 0; k < frag.size(); ++k)
+            e.add(frag[(b%2)?(frag.size()-1-k):k] + b + 12*(k%2), b);
+
+    pse::PSAutomata all;
+    pse::PST t0(pse::Algo::PSE, seed, id, e, true, false, false, 1,
+                nullptr, &all);
+    const size_t states = all.states();
+    EXPECT_FALSE(all.full());
+    EXPECT_FALSE(all.reclaim());
+    EXPECT_EQ(all.states(), states);
+
+    pse::PSAutomata automata(states/4);
+    EXPECT_EQ(automata.bound(), states/4);
+    pse::PST ta(pse::Algo::PSE, seed, id, e, true, false, false, 1,
+                nullptr, &automata);
+    EXPECT_TRUE(automata.full());
+    EXPECT_LT(automata.states(), states);
+    pse::PST tb(pse::Algo::PSE, seed, id, e, true, false, false, 1,
+                nullptr, &automata);
+    EXPECT_LT(automata.states(), states);
+    for (size_t i = 0; i < id.size(); ++i)
+    {
+        EXPECT_EQ(ta.rowCost(i), t0.rowCost(i));
+        EXPECT_EQ(tb.rowCost(i), t0.rowCost(i));
+    }
+    EXPECT_TRUE(automata.reclaim());
+    EXPECT_EQ(automata.size(), 0);
+    EXPECT_EQ(automata.states(), 0);
+}
@@ -0,0 +1,128 @@
+//
+//  TestChords.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "Ton.hpp"
+#include "TonIndex.hpp"
+#include "MidiNum.hpp"
+#include "PSRawEnum.hpp"
+#include "PSChords.hpp"
+#include "CostADplus.hpp"
+#include "PSAutomaton.hpp"
+#include "PSBag.hpp"
+
+
+TEST(PSChords, table)
+{
+    pse::PSRawEnum e(0, 9);
+    e.add(60, 0, false);
+    e.add(67, 0, true);  // chord 0: 67 55 64 79
+    e.add(55, 0, true);
+    e.add(64, 0, true);
+    e.add(79, 0, false);
+    e.add(62, 0, false);
+    e.add(65, 0, true);  // chord 1: 65 53
+    e.add(53, 0, false);
+    e.add(72, 0, true);  // truncated chord 2: 72
+    pse::PSChords t(e);
+
+    ASSERT_EQ(t.size(), 3);
+    EXPECT_EQ(t.index(0), pse::PSChords::NOCHORD);
+    EXPECT_EQ(t.index(5), pse::PSChords::NOCHORD);
+    for (size_t i = 1; i < 5; ++i)
+        EXPECT_EQ(t.index(i), 0);
+    EXPECT_EQ(t.index(6), 1);
+    EXPECT_EQ(t.index(7), 1);
+    EXPECT_EQ(t.index(8), 2);
+
+    const pse::PSChords::Chord& c0 = t.chord(0);
+    EXPECT_EQ(c0.first, 1);
+    EXPECT_EQ(c0.stop, 5);
+    EXPECT_EQ(c0.size(), 4);
+    EXPECT_EQ(c0.bass, 2);
+    EXPECT_EQ(c0.pcs, (1 << 7) | (1 << 4));
+    EXPECT_EQ(c0.type(), 2);
+    EXPECT_EQ(c0.low[7], 1); // 55
+    EXPECT_EQ(c0.low[4], 2); // 64
+    EXPECT_EQ(c0.low[0], pse::PSChords::NOPC);
+
+    const pse::PSChords::Chord& c1 = t.chord(1);
+    EXPECT_EQ(c1.first, 6);
+    EXPECT_EQ(c1.stop, 8);
+    EXPECT_EQ(c1.bass, 7);
+    EXPECT_EQ(c1.type(), 1);
+    EXPECT_EQ(c1.low[5], 1);
+
+    EXPECT_EQ(t.chord(2).first, 8);
+    EXPECT_EQ(t.chord(2).stop, 9);
+}
+
+
+// the search with the chords spelled in one step by the chord transitions
+// of an automaton finds the same best paths as the search with the chords
+// spelled in one step (PSC2) without automaton.
+TEST(PSC2, search)
+{
+    const pse::PSRatio dur(0);
+    pse::PSRawEnum e(0, 16);
+    e.add(60, 0, true);  // dense chord, repeated pitch classes
+    e.add(63, 0, true);
+    e.add(66, 0, true);
+    e.add(70, 0, true);
+    e.add(73, 0, true);
+    e.add(75, 0, true);
+    e.add(54, 0, false);
+    e.add(68, 0);
+    e.add(61, 0, true);  // chord, constrained name
+    e.add(66, 0, true, dur, pse::NoteName::G, pse::Accid::Flat,
+          pse::MidiNum::midi_to_octave(66, pse::NoteName::G));
+    e.add(69, 0, false);
+    e.add(62, 0, true);  // chord, constrained name of a repeated class
+    e.add(65, 0, true);
+    e.add(77, 0, true, dur, pse::NoteName::E, pse::Accid::Sharp,
+          pse::MidiNum::midi_to_octave(77, pse::NoteName::E));
+    e.add(58, 0, false);
+    e.add(71, 0);
+
+    pse::TonIndex id(26);
+    pse::CostADplus seed;
+    for (bool octave : { false, true })
+    {
+        pse::PSAutomata automata;
+        for (size_t i = 0; i < id.size(); ++i)
+        {
+            const pse::Ton& ton = id.ton(i);
+            pse::PSB b0(pse::Algo::PSE, seed, e, true, octave, ton);
+            pse::PSB ba(pse::Algo::PSE, seed, e, true, octave, ton,
+                        pse::Ton(), nullptr, nullptr, nullptr, &automata);
+            EXPECT_EQ(b0.cost(), ba.cost());
+            ASSERT_EQ(b0.size(), ba.size());
+            // the chords were read with chord transitions
+            EXPECT_GT(automata.get(seed, ton, pse::Ton(), true, octave).chords(),
+                      0);
+            // same sets of best paths
+            std::vector<std::vector<enum pse::NoteName>> n0, na;
+            std::vector<std::vector<bool>> p0, pa;
+            for (size_t k = 0; k < b0.size(); ++k)
+            {
+                n0.push_back(b0.path(k).names());
+                na.push_back(ba.path(k).names());
+                p0.push_back(b0.path(k).prints());
+                pa.push_back(ba.path(k).prints());
+            }
+            std::sort(n0.begin(), n0.end());
+            std::sort(na.begin(), na.end());
+            std::sort(p0.begin(), p0.end());
+            std::sort(pa.begin(), pa.end());
+            EXPECT_EQ(n0, na);
+            EXPECT_EQ(p0, pa);
+        }
+    }
+}
@@ -116,3 +116,46 @@ TEST(TestCostADlex, BWV858_26)
 
 }
 
+
+// the cached sort key follows the lexicographic order accid, dist, tiebreak
+TEST(TestCostADlex, key)
+{
+    // C maj
+    const pse::Ton gton(0, pse::ModeName::Major);
+    // G maj
+    const pse::Ton lton(1, pse::ModeName::Major);
+
+    pse::CostADlex c0; // zero
+    EXPECT_TRUE(c0.packed());
+    EXPECT_EQ(c0.key(), 0);
+
+    // F# : 1 accid, 0 dist
+    pse::CostADlex c1(c0);
+    c1.update(pse::NoteName::F, pse::Accid::Sharp, true, gton, lton);
+    EXPECT_TRUE(c1.packed());
+    EXPECT_GT(c1.key(), c0.key());
+    EXPECT_TRUE(c0 < c1);
+
+    // Fn : 0 accid, 1 dist
+    pse::CostADlex c2(c0);
+    c2.update(pse::NoteName::F, pse::Accid::Natural, false, gton, lton);
+    EXPECT_TRUE(c2.packed());
+    EXPECT_EQ(c2.get_accid(), 0);
+    EXPECT_EQ(c2.get_dist(), 1);
+    EXPECT_LT(c2.key(), c1.key());
+    EXPECT_TRUE(c2 < c1);
+    EXPECT_FALSE(c1 < c2);
+
+    // the key is updated by sums
+    pse::CostADlex c3(c2);
+    c3 += c1;
+    EXPECT_EQ(c3.get_accid(), 1);
+    EXPECT_EQ(c3.get_dist(), 1);
+    EXPECT_GT(c3.key(), c1.key());
+    EXPECT_TRUE(c1 < c3);
+
+    // copies have equal keys
+    pse::CostADlex c4(c3);
+    EXPECT_EQ(c4.key(), c3.key());
+    EXPECT_TRUE(c4 == c3);
+}
@@ -0,0 +1,120 @@
+//
+//  TestCostOnly.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include "TonIndex.hpp"
+#include "PSRawEnum.hpp"
+#include "CostADplus.hpp"
+#include "PSBMemo.hpp"
+#include "PSTable.hpp"
+
+
+// 6 bars with chromatic notes and chords, two of them repeated
+static void fill(pse::PSRawEnum& e)
+{
+    const std::vector<unsigned int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    for (size_t b = 0; b < 6; ++b)
+    {
+        for (size_t k = 0; k < frag.size(); ++k)
+            e.add(frag[(b%2)?(frag.size()-1-k):k] + (b%3), b, (k == 2));
+    }
+}
+
+// the table in cost-only mode has the same costs as the complete table,
+// and renames the notes in the same way, with or without cache.
+TEST(PSTCostOnly, table)
+{
+    pse::CostADplus seed;
+    for (bool cache : { false, true })
+    {
+        pse::TonIndex id(26); // closed
+        pse::PSRawEnum e0(0, 48);
+        pse::PSRawEnum e1(0, 48);
+        fill(e0);
+        fill(e1);
+        pse::PSBMemo memo;
+        pse::PSBMemo* pm = cache?(&memo):nullptr;
+        pse::PST t0(pse::Algo::PSE, seed, id, e0, false, false, false, 1, pm);
+        pse::PST t1(pse::Algo::PSE, seed, id, e1, false, false, false, 1, pm,
+                    nullptr, false, 100, true);
+        ASSERT_EQ(t1.size(), t0.size());
+        for (size_t i = 0; i < id.size(); ++i)
+        {
+            EXPECT_EQ(t1.rowCost(i), t0.rowCost(i));
+            for (size_t j = 0; j < t0.size(); ++j)
+            {
+                const pse::PSB& b0 = t0.column(j).bag(i);
+                const pse::PSB& b1 = t1.column(j).bag(i);
+                EXPECT_FALSE(b0.costonly());
+                EXPECT_TRUE(b1.costonly());
+                EXPECT_EQ(b1.size(), b0.size());
+                EXPECT_EQ(b1.cost(), b0.cost());
+            }
+        }
+
+        // the best paths of the renaming row only are searched again
+        size_t ig = 3;
+        for (size_t j = 0; j < t1.size(); ++j)
+            EXPECT_FALSE(t1.column(j).rename(ig));
+        ASSERT_TRUE(t0.rename(ig));
+        ASSERT_TRUE(t1.rename(ig));
+        for (size_t j = 0; j < t1.size(); ++j)
+        {
+            EXPECT_FALSE(t1.column(j).bag(ig).costonly());
+            EXPECT_EQ(t1.column(j).bag(ig).cost(),
+                      t0.column(j).bag(ig).cost());
+        }
+        for (size_t n = e0.first(); n < e0.stop(); ++n)
+        {
+            EXPECT_EQ(e1.name(n), e0.name(n));
+            EXPECT_EQ(e1.accidental(n), e0.accidental(n));
+            EXPECT_EQ(e1.printed(n), e0.printed(n));
+        }
+    }
+}
+
+
+// the cache keeps only the costs of the bags in cost-only mode,
+// and a table with best paths searches them again.
+TEST(PSTCostOnly, memo)
+{
+    pse::CostADplus seed;
+    pse::TonIndex id(26); // closed
+    pse::PSRawEnum e0(0, 48);
+    pse::PSRawEnum e1(0, 48);
+    fill(e0);
+    fill(e1);
+    pse::PSBMemo memo;
+    pse::PST t1(pse::Algo::PSE, seed, id, e1, false, false, false, 1, &memo,
+                nullptr, false, 100, true);
+    const size_t n1 = memo.size();
+    EXPECT_GT(n1, 0);
+    // the results without best paths are replaced, not added
+    pse::PST t0(pse::Algo::PSE, seed, id, e0, false, false, false, 1, &memo);
+    EXPECT_EQ(memo.size(), n1);
+    ASSERT_EQ(t1.size(), t0.size());
+    for (size_t i = 0; i < id.size(); ++i)
+    {
+        EXPECT_EQ(t1.rowCost(i), t0.rowCost(i));
+        for (size_t j = 0; j < t0.size(); ++j)
+        {
+            EXPECT_FALSE(t0.column(j).bag(i).costonly());
+            EXPECT_EQ(t1.column(j).bag(i).size(), t0.column(j).bag(i).size());
+            EXPECT_EQ(t1.column(j).bag(i).cost(), t0.column(j).bag(i).cost());
+        }
+    }
+    size_t ig = 3;
+    ASSERT_TRUE(t0.rename(ig));
+    ASSERT_TRUE(t1.rename(ig));
+    for (size_t n = e0.first(); n < e0.stop(); ++n)
+    {
+        EXPECT_EQ(e1.name(n), e0.name(n));
+        EXPECT_EQ(e1.accidental(n), e0.accidental(n));
+        EXPECT_EQ(e1.printed(n), e0.printed(n));
+    }
+}
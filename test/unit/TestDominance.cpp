@@ -0,0 +1,144 @@
+//
+//  TestDominance.cpp
+//  testpse
+//
+//  Created by agent on 17/10/2026.
+//
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "Ton.hpp"
+#include "PSRawEnum.hpp"
+#include "Enharmonic.hpp"
+#include "CostA.hpp"
+#include "CostADplus.hpp"
+#include "PSConfig0.hpp"
+#include "PSConfig1.hpp"
+#include "PSBag.hpp"
+#include "PSAutomaton.hpp"
+
+
+TEST(Dominance, equivalent)
+{
+    pse::Ton t(0, pse::ModeName::Major);
+    pse::PSRawEnum e(0, 2);
+    pse::CostA c0;
+
+    e.add(61, 0); // C#4 or Db4
+    e.add(60, 0); // C4
+
+    std::shared_ptr<const pse::PSC0> i =
+        std::make_shared<const pse::PSC0>(t, 0, c0, true, false);
+    std::shared_ptr<const pse::PSC0> s1 =
+        std::make_shared<const pse::PSC1>(i, e, pse::NoteName::C,
+                                          pse::Accid::Sharp, false, t, t);
+    std::shared_ptr<const pse::PSC0> s2 =
+        std::make_shared<const pse::PSC1>(i, e, pse::NoteName::C,
+                                          pse::Accid::Sharp, false, t, t);
+    std::shared_ptr<const pse::PSC0> s3 =
+        std::make_shared<const pse::PSC1>(i, e, pse::NoteName::D,
+                                          pse::Accid::Flat, false, t, t);
+
+    EXPECT_TRUE(s1->equivalent(*s2));
+    EXPECT_EQ(s1->hash(), s2->hash());
+    EXPECT_FALSE(s1->equivalent(*s3));
+    EXPECT_FALSE(s1->equivalent(*i));
+}
+
+// minimal cost of all the paths from c, by exhaustive enumeration
+static std::shared_ptr<pse::Cost> brute(std::shared_ptr<const pse::PSC0> c,
+                                        const pse::PSRawEnum& e,
+                                        const pse::Ton& t)
+{
+    if (c->id() == e.stop())
+        return c->cost().shared_clone();
+    std::shared_ptr<pse::Cost> best;
+    unsigned int m = e.midipitch(c->id()) % 12;
+    for (int j = 0; j < 3; ++j)
+    {
+        enum pse::NoteName name = pse::Enharmonics::name(m, j, false, false);
+        enum pse::Accid accid = pse::Enharmonics::accid(m, j, false, false);
+        if (! (defined(name) and defined(accid)))
+            continue;
+        std::shared_ptr<const pse::PSC0> s =
+            std::make_shared<const pse::PSC1>(c, e, name, accid, false, t, t);
+        std::shared_ptr<pse::Cost> cs = brute(s, e, t);
+        if ((best == nullptr) || (*cs < *best))
+            best = cs;
+    }
+    return best;
+}
+
+TEST(Dominance, chromatic)
+{
+    pse::Ton t(0, pse::ModeName::Major);
+    pse::PSRawEnum e(0, 10);
+    pse::CostA c0;
+
+    // chromatic ascent and descent
+    const std::vector<unsigned int> notes =
+        { 60, 61, 62, 63, 64, 63, 62, 61, 60, 66 };
+    for (unsigned int m : notes)
+        e.add(m, 0);
+
+    pse::PSB b(pse::Algo::PSE, c0, e, true, false, t);
+    EXPECT_FALSE(b.empty());
+    EXPECT_GT(b.dominated(), 0);
+
+    // the pruned search is exact
+    std::shared_ptr<const pse::PSC0> i =
+        std::make_shared<const pse::PSC0>(t, e.first(), c0, true, false);
+    std::shared_ptr<pse::Cost> best = brute(i, e, t);
+    ASSERT_NE(best, nullptr);
+    EXPECT_EQ(b.cost(), *best);
+}
+
+// best paths of b, in a canonical order
+static std::vector<std::vector<enum pse::NoteName>> paths(const pse::PSB& b)
+{
+    std::vector<std::vector<enum pse::NoteName>> res;
+    for (size_t i = 0; i < b.size(); ++i)
+        res.push_back(b.path(i).names());
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+// same best paths with and without A*,
+// return the number of expansions saved by A*
+static long astar(const pse::Cost& c0, bool octave, pse::PSAutomata* a)
+{
+    pse::PSRawEnum e(0, 16);
+    // dense chromatic bar
+    const std::vector<unsigned int> notes =
+        { 61, 63, 66, 68, 70, 73, 75, 78, 61, 63, 66, 60, 65, 70, 71, 59 };
+    for (unsigned int m : notes)
+        e.add(m, 0);
+
+    long saved = 0;
+    for (int ks = -3; ks <= 3; ++ks)
+    {
+        pse::Ton t(ks, pse::ModeName::Major);
+        pse::PSB b0(pse::Algo::PSE, c0, e, true, octave, t, t,
+                    nullptr, nullptr, nullptr, a);
+        pse::PSB b1(pse::Algo::PSE, c0, e, true, octave, t, t,
+                    nullptr, nullptr, nullptr, a, nullptr, true);
+        EXPECT_EQ(b0.cost(), b1.cost());
+        EXPECT_EQ(b0.size(), b1.size());
+        EXPECT_EQ(paths(b0), paths(b1));
+        EXPECT_GT(b0.expanded(), 0);
+        saved += (long) b0.expanded() - (long) b1.expanded();
+    }
+    return saved;
+}
+
+TEST(Dominance, astar)
+{
+    pse::PSAutomata a;
+    EXPECT_GT(astar(pse::CostA(), false, nullptr), 0);
+    EXPECT_GT(astar(pse::CostA(), true, nullptr), 0);
+    EXPECT_GT(astar(pse::CostA(), false, &a), 0);
+    EXPECT_GT(astar(pse::CostADplus(), false, &a), 0);
+    EXPECT_GT(astar(pse::CostADplus(), true, &a), 0);
+}
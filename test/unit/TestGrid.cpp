@@ -0,0 +1,205 @@
+//
+//  TestGrid.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "TonIndex.hpp"
+#include "PSRawEnum.hpp"
+#include "CostA.hpp"
+#include "PSTable.hpp"
+#include "PSGridx.hpp"
+
+
+// cost of a path in a row of the exhaustive grid,
+// with the coefficients of PSGx (rank, dist. to previous, dist. to global).
+// @param rk ranks of the bags in every column of the table.
+static size_t path_cost(const pse::TonIndex& id,
+                        const std::vector<std::vector<size_t>>& rk,
+                        size_t ig, const std::vector<size_t>& path)
+{
+    size_t c = 0;
+    for (size_t j = 0; j < path.size(); ++j)
+    {
+        const std::vector<size_t>& ranks = rk[j];
+        if (j == 0)
+            c += 2 * id.rankWeber(ig, path[j]) + 2 * ranks[path[j]];
+        else
+            c += id.rankWeber(path[j-1], path[j]) + 2 * ranks[path[j]] +
+                 id.rankWeber(ig, path[j]);
+    }
+    return c;
+}
+
+
+// the k best paths are the ones found by enumeration of all the paths
+TEST(PSGx, kbest)
+{
+    pse::TonIndex id(26);
+    pse::PSRawEnum e(0, 24);
+    pse::CostA seed;
+    const std::vector<unsigned int> frag = { 60, 62, 63, 66, 68, 70, 71, 73 };
+    for (size_t b = 0; b < 3; ++b)
+        for (size_t k = 0; k < frag.size(); ++k)
+            e.add(frag[(3*k + b) % frag.size()] + 2*b, b, false);
+    pse::PST tab(pse::Algo::PSE, seed, id, e, true, false, false, 1);
+    ASSERT_EQ(tab.size(), 3);
+
+    const size_t k = 6;
+    pse::PSGx g1(tab);
+    pse::PSGx gk(tab, false, k);
+    const size_t nt = id.size();
+    std::vector<std::vector<size_t>> rk(tab.size());
+    for (size_t j = 0; j < tab.size(); ++j)
+        tab.column(j).ranks(rk[j]);
+    for (size_t ig = 0; ig < nt; ++ig)
+    {
+        if (not id.isGlobal(ig))
+            continue;
+        // same grid with and without the k best paths
+        for (size_t j = 0; j < tab.size(); ++j)
+            EXPECT_EQ(gk.ilocal(ig, j), g1.ilocal(ig, j));
+        ASSERT_EQ(g1.paths(ig), 1);
+        ASSERT_EQ(gk.paths(ig), k);
+        EXPECT_EQ(gk.pathCost(ig, 0), g1.pathCost(ig, 0));
+        for (size_t j = 0; j < tab.size(); ++j)
+            EXPECT_EQ(gk.path(ig, 0)[j], gk.ilocal(ig, j));
+
+        std::vector<size_t> all;
+        for (size_t p = 0; p < nt * nt * nt; ++p)
+            all.push_back(path_cost(id, rk, ig,
+                                    { p / (nt*nt), (p / nt) % nt, p % nt }));
+        std::sort(all.begin(), all.end());
+        for (size_t r = 0; r < k; ++r)
+        {
+            EXPECT_EQ(gk.pathCost(ig, r), all[r]);
+            EXPECT_EQ(path_cost(id, rk, ig, gk.path(ig, r)),
+                      gk.pathCost(ig, r));
+            for (size_t q = 0; q < r; ++q)
+                EXPECT_NE(gk.path(ig, q), gk.path(ig, r));
+        }
+    }
+}
+
+
+// the k best paths stay in the same local ton in the empty bars
+TEST(PSGx, kbest_empty)
+{
+    pse::TonIndex id(26);
+    pse::PSRawEnum e(0, 16);
+    pse::CostA seed;
+    const std::vector<unsigned int> frag = { 60, 62, 63, 66, 68, 70, 71, 73 };
+    for (size_t b = 0; b < 4; b += 2) // bars 1 and 3 empty
+        for (size_t k = 0; k < frag.size(); ++k)
+            e.add(frag[(3*k + b) % frag.size()] + 2*b, b, false);
+    e.add(64, 4, false);
+    pse::PST tab(pse::Algo::PSE, seed, id, e, true, false, false, 1);
+    ASSERT_EQ(tab.size(), 5);
+
+    const size_t k = 5;
+    pse::PSGx g1(tab);
+    pse::PSGx gk(tab, false, k);
+    for (size_t ig = 0; ig < id.size(); ++ig)
+    {
+        if (not id.isGlobal(ig))
+            continue;
+        ASSERT_EQ(gk.paths(ig), k);
+        EXPECT_EQ(gk.pathCost(ig, 0), g1.pathCost(ig, 0));
+        for (size_t j = 0; j < tab.size(); ++j)
+            EXPECT_EQ(gk.path(ig, 0)[j], g1.ilocal(ig, j));
+        for (size_t r = 0; r < k; ++r)
+        {
+            const std::vector<size_t>& path = gk.path(ig, r);
+            EXPECT_EQ(path[1], path[0]);
+            EXPECT_EQ(path[3], path[2]);
+            if (r > 0)
+                EXPECT_LE(gk.pathCost(ig, r-1), gk.pathCost(ig, r));
+            for (size_t q = 0; q < r; ++q)
+                EXPECT_NE(gk.path(ig, q), path);
+        }
+    }
+}
+
+
+// the table and the online grid extended note by note are the same
+// as the ones computed on the whole sequence, with a lookahead larger
+// than the number of bars.
+TEST(PSGx, online)
+{
+    pse::TonIndex id(26);
+    pse::CostA seed;
+    const std::vector<unsigned int> frag = { 60, 61, 63, 66, 68, 70, 71, 73 };
+    const size_t nb = 6;
+    pse::PSRawEnum e(0, 0);
+    pse::PSRawEnum es(0, 0);
+    std::unique_ptr<pse::PST> ts;
+    std::unique_ptr<pse::PSGx> g2;
+    std::unique_ptr<pse::PSGx> gn;
+    for (size_t b = 0; b < nb; ++b)
+    {
+        // bar 3 is empty
+        if (b == 3)
+            continue;
+        for (size_t k = 0; k < frag.size(); ++k)
+        {
+            unsigned int m = frag[(3*k + b) % frag.size()] + 5*b;
+            e.add(m, b, false);
+            es.add(m, b, false);
+            if (ts == nullptr)
+            {
+                ts.reset(new pse::PST(pse::Algo::PSE, seed, id, es, true));
+                g2.reset(new pse::PSGx(*ts, false, 1, 2));
+                gn.reset(new pse::PSGx(*ts, false, 1, nb));
+            }
+            else
+            {
+                ts->extend();
+                g2->extend(*ts);
+                gn->extend(*ts);
+            }
+            // the bars followed by 2 complete bars are fixed
+            size_t complete = ts->size() - 1;
+            EXPECT_EQ(g2->size(), (complete > 2)?(complete - 2):0);
+            EXPECT_EQ(gn->size(), 0);
+        }
+    }
+    EXPECT_EQ(g2->extend(*ts, true), 3);
+    EXPECT_EQ(gn->extend(*ts, true), nb);
+
+    pse::PST tab(pse::Algo::PSE, seed, id, e, true);
+    ASSERT_EQ(ts->size(), nb);
+    ASSERT_EQ(tab.size(), nb);
+    for (size_t i = 0; i < id.size(); ++i)
+    {
+        EXPECT_EQ(ts->rowCost(i), tab.rowCost(i));
+        for (size_t j = 0; j < nb; ++j)
+        {
+            EXPECT_EQ(ts->column(j).first(), tab.column(j).first());
+            EXPECT_EQ(ts->column(j).stop(), tab.column(j).stop());
+            if (tab.column(j).bag(i).empty())
+                EXPECT_TRUE(ts->column(j).bag(i).empty());
+            else
+                EXPECT_EQ(ts->column(j).bag(i).cost(),
+                          tab.column(j).bag(i).cost());
+        }
+    }
+
+    pse::PSGx grid(tab);
+    ASSERT_EQ(g2->size(), nb);
+    ASSERT_EQ(gn->size(), nb);
+    for (size_t ig = 0; ig < id.size(); ++ig)
+    {
+        if (not id.isGlobal(ig))
+            continue;
+        for (size_t j = 0; j < nb; ++j)
+        {
+            EXPECT_EQ(gn->ilocal(ig, j), grid.ilocal(ig, j));
+            EXPECT_LT(g2->ilocal(ig, j), id.size());
+        }
+    }
+}
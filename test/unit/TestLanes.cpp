@@ -0,0 +1,100 @@
+//
+//  TestLanes.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include "Ton.hpp"
+#include "TonIndex.hpp"
+#include "MidiNum.hpp"
+#include "PSRawEnum.hpp"
+#include "PSBarView.hpp"
+#include "CostA.hpp"
+#include "CostADplus.hpp"
+#include "PSBag.hpp"
+#include "PSLanes.hpp"
+
+
+// one bar with chords, octaves and forced names
+static void bar(pse::PSRawEnum& e)
+{
+    const pse::PSRatio dur(0);
+    e.add(61, 0, true);  // chord
+    e.add(65, 0, true);
+    e.add(68, 0, false);
+    e.add(66, 0, false, dur, pse::NoteName::G, pse::Accid::Flat,
+          pse::MidiNum::midi_to_octave(66, pse::NoteName::G));
+    e.add(66, 0);
+    e.add(70, 0);
+    e.add(63, 0, true);  // chord, same pitch class twice
+    e.add(75, 0, true, dur, pse::NoteName::D, pse::Accid::Sharp,
+          pse::MidiNum::midi_to_octave(75, pse::NoteName::D));
+    e.add(58, 0, false);
+    e.add(73, 0);
+    e.add(72, 0);
+    e.add(71, 0);
+    e.add(49, 0);
+    e.add(61, 0);
+}
+
+// the lanes compute the same path as the search of PSD, for every ton
+static void compare(const pse::Cost& seed, bool tonal, bool octave,
+                    bool local)
+{
+    pse::TonIndex id(30); // closed
+    pse::PSRawEnum e(0, 14);
+    bar(e);
+    pse::PSBarView notes(e, e.first(), e.stop());
+    const pse::Ton lton(-2, pse::ModeName::Minor);
+
+    pse::PSL lanes(seed, tonal, octave);
+    for (size_t i = 0; i < id.size(); ++i)
+        lanes.add(id.ton(i), local?lton:pse::Ton(),
+                  id.table().chromanames(i));
+    ASSERT_EQ(lanes.size(), id.size());
+    lanes.run(notes);
+
+    for (size_t i = 0; i < id.size(); ++i)
+    {
+        pse::PSB b0(pse::Algo::PSD, seed, e, tonal, octave, id.ton(i),
+                    local?lton:pse::Ton());
+        std::shared_ptr<const pse::PSB> b1 = lanes.bag(i, e);
+        ASSERT_EQ(b0.size(), 1);
+        ASSERT_EQ(b1->size(), 1);
+        EXPECT_EQ(lanes.cost(i), b0.cost());
+        EXPECT_EQ(b1->cost(), b0.cost());
+        EXPECT_EQ(b1->path().names(), b0.path().names());
+        EXPECT_EQ(b1->path().accids(), b0.path().accids());
+        EXPECT_EQ(b1->path().prints(), b0.path().prints());
+    }
+}
+
+TEST(PSLanes, CostA)
+{
+    compare(pse::CostA(), true, false, false);
+    compare(pse::CostA(), false, false, false);
+    compare(pse::CostA(), true, true, false);
+}
+
+TEST(PSLanes, CostADplus)
+{
+    compare(pse::CostADplus(), true, false, false);
+    compare(pse::CostADplus(), true, false, true);
+    compare(pse::CostADplus(), false, true, true);
+}
+
+TEST(PSLanes, empty)
+{
+    pse::TonIndex id(30);
+    pse::PSRawEnum e(0, 0);
+    pse::PSBarView notes(e, e.first(), e.stop());
+    pse::PSL lanes(pse::CostA(), true, false);
+    lanes.add(id.ton(0));
+    lanes.run(notes);
+    std::shared_ptr<const pse::PSB> b = lanes.bag(0, e);
+    EXPECT_TRUE(b->empty());
+    EXPECT_EQ(b->cost(), pse::CostA());
+}
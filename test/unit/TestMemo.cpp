@@ -0,0 +1,147 @@
+//
+//  TestMemo.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include "TonIndex.hpp"
+#include "PSRawEnum.hpp"
+#include "CostADplus.hpp"
+#include "PSBMemo.hpp"
+#include "PSTable.hpp"
+#include "PSE.hpp"
+
+
+// the table built with a cache of bag searches is the same as without,
+// and the repeated bars are found in the cache
+TEST(PSBMemo, table)
+{
+    pse::TonIndex id(26); // closed
+    pse::PSRawEnum e(0, 96);
+    pse::CostADplus seed;
+
+    // 4 bars repeated 3 times, with one shifted bar
+    const std::vector<unsigned int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    for (size_t b = 0; b < 12; ++b)
+        for (size_t k = 0; k < frag.size(); ++k)
+            e.add(frag[(b%2)?(frag.size()-1-k):k] + (b%4) + ((b==9)?1:0), b,
+                  false);
+
+    pse::PSBMemo memo;
+    pse::PST t0(pse::Algo::PSE, seed, id, e, true, false, false, 1);
+    pse::PST tm(pse::Algo::PSE, seed, id, e, true, false, false, 4, &memo);
+    ASSERT_EQ(t0.size(), 12);
+    ASSERT_EQ(tm.size(), t0.size());
+    for (size_t i = 0; i < id.size(); ++i)
+        EXPECT_EQ(tm.rowCost(i), t0.rowCost(i));
+    for (size_t j = 0; j < t0.size(); ++j)
+    {
+        for (size_t i = 0; i < id.size(); ++i)
+        {
+            const pse::PSB& b0 = t0.column(j).bag(i);
+            const pse::PSB& bm = tm.column(j).bag(i);
+            ASSERT_EQ(bm.size(), b0.size());
+            EXPECT_EQ(bm.cost(), b0.cost());
+            for (size_t n = t0.column(j).first(); n < t0.column(j).stop(); ++n)
+            {
+                EXPECT_EQ(bm.path(0).name(n), b0.path(0).name(n));
+                EXPECT_EQ(bm.path(0).alteration(n), b0.path(0).alteration(n));
+                EXPECT_EQ(bm.path(0).printed(n), b0.path(0).printed(n));
+            }
+        }
+    }
+    // 5 distinct bars
+    EXPECT_EQ(memo.size() % 5, 0);
+    EXPECT_GT(memo.hits(), 0);
+    EXPECT_GE(memo.misses(), memo.size()); // concurrent misses on same key
+    EXPECT_GT(memo.hitRate(), 0.5);
+}
+
+
+// spelling with a cache gives the same result as without
+TEST(PSBMemo, speller)
+{
+    const std::vector<int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    pse::PSE sp0(30, false);
+    pse::PSE spm(30, false);
+    sp0.setMemo(nullptr);
+    ASSERT_TRUE(spm.memo());
+    for (size_t b = 0; b < 8; ++b)
+    {
+        for (size_t k = 0; k < frag.size(); ++k)
+        {
+            int m = frag[(b%2)?(frag.size()-1-k):k] + (b%2);
+            sp0.add(m, b);
+            spm.add(m, b);
+        }
+    }
+    ASSERT_TRUE(sp0.spell());
+    ASSERT_TRUE(spm.spell());
+    ASSERT_TRUE(sp0.rename(0));
+    ASSERT_TRUE(spm.rename(0));
+    EXPECT_EQ(spm.fifths(), sp0.fifths());
+    for (size_t i = 0; i < sp0.size(); ++i)
+    {
+        EXPECT_EQ(spm.name(i), sp0.name(i));
+        EXPECT_EQ(spm.accidental(i), sp0.accidental(i));
+        EXPECT_EQ(spm.printed(i), sp0.printed(i));
+    }
+    EXPECT_GT(spm.memo()->hits(), 0);
+}
+
+
+// the least recently used results are removed when the capacity is reached
+TEST(PSBMemo, capacity)
+{
+    pse::CostADplus seed;
+    pse::PSBMemo memo(2);
+    EXPECT_EQ(memo.capacity(), 2);
+    std::vector<pse::PSBMemo::Key> keys;
+    for (int m : { 60, 61, 62 })
+    {
+        pse::PSRawEnum e(0, 1);
+        e.add(m, 0);
+        keys.push_back(pse::PSBMemo::key(e, pse::Algo::PSE, seed, true, false,
+                                         pse::Ton(0, pse::ModeName::Major),
+                                         pse::Ton()));
+    }
+    std::shared_ptr<pse::PSBMemo::Entry> entry(new pse::PSBMemo::Entry());
+    entry->cost = seed.shared_zero();
+    entry->ties = 1;
+    memo.insert(keys[0], entry);
+    memo.insert(keys[1], entry);
+    EXPECT_TRUE(memo.find(keys[0], false)); // keys[1] least recently used
+    memo.insert(keys[2], entry);
+    EXPECT_EQ(memo.size(), 2);
+    EXPECT_FALSE(memo.find(keys[1], false));
+    EXPECT_TRUE(memo.find(keys[0], false));
+    EXPECT_TRUE(memo.find(keys[2], false));
+    memo.clear();
+    EXPECT_EQ(memo.size(), 0);
+}
+
+
+// the cache is used by the bags built with an arena
+TEST(PSBMemo, bag)
+{
+    pse::CostADplus seed;
+    pse::Ton t(-3, pse::ModeName::Major);
+    pse::PSRawEnum e(0, 4);
+    for (int m : { 55, 56, 58, 55 })
+        e.add(m, 0);
+    pse::PSBMemo memo;
+    pse::PSArena arena;
+    pse::PSB b0(pse::Algo::PSE, seed, e, true, false, t, pse::Ton(), &arena,
+                nullptr, &memo);
+    arena.reset();
+    pse::PSB b1(pse::Algo::PSE, seed, e, true, false, t, pse::Ton(), &arena,
+                nullptr, &memo);
+    EXPECT_EQ(memo.size(), 1);
+    EXPECT_EQ(memo.hits(), 1);
+    EXPECT_EQ(b1.cost(), b0.cost());
+    EXPECT_EQ(b1.size(), b0.size());
+    EXPECT_FALSE(b1.configs());
+}
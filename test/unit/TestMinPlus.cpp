@@ -0,0 +1,57 @@
+//
+//  TestMinPlus.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "MinPlus.hpp"
+
+using pse::util::MinPlus;
+
+
+// the kernel selects the same predecessor as the scalar version,
+// including in case of ties
+TEST(MinPlus, argmin)
+{
+    for (size_t n : { 1, 7, 8, 13, 30, 104 })
+    {
+        size_t np = MinPlus::padded(n);
+        ASSERT_EQ(np % MinPlus::LANES, 0);
+        ASSERT_GE(np, n);
+        std::vector<int32_t> p(np, MinPlus::INF);
+        std::vector<int32_t> w(np, 0);
+        for (size_t k = 0; k < n; ++k)
+        {
+            // few distinct values to have many ties
+            p[k] = (k % 5 == 3)?MinPlus::INF:(int32_t) ((7 * k) % 4);
+            w[k] = (int32_t) ((3 * k) % 5);
+        }
+        int32_t best;
+        int32_t best_scalar;
+        size_t i = MinPlus::argmin(p.data(), w.data(), n, best);
+        size_t i_scalar = MinPlus::argmin_scalar(p.data(), w.data(), n,
+                                                 best_scalar);
+        EXPECT_EQ(i, i_scalar);
+        EXPECT_EQ(best, best_scalar);
+        ASSERT_LT(i, n);
+        for (size_t k = 0; k < n; ++k)
+        {
+            if (p[k] == MinPlus::INF) continue;
+            EXPECT_LE(best, p[k] + w[k]);
+            if (p[k] + w[k] == best)
+                EXPECT_LE(p[i], p[k]);
+        }
+    }
+
+    // all predecessors infinite
+    std::vector<int32_t> p(8, MinPlus::INF);
+    std::vector<int32_t> w(8, 1);
+    int32_t best;
+    EXPECT_EQ(MinPlus::argmin(p.data(), w.data(), 5, best), 5);
+    EXPECT_EQ(best, MinPlus::INF);
+}
@@ -8,6 +8,8 @@
 #include "gtest/gtest.h"
 
 #include "PSRawEnum.hpp"
+#include "PSBars.hpp"
+#include "PSBarView.hpp"
 
 
 
@@ -143,3 +145,155 @@ TEST(PSRawEnum, rename)
     EXPECT_EQ(e.octave(12), 2);
 }
 
+
+TEST(PSRawEnum, buffers)
+{
+    const std::vector<int64_t> midi = { 24, 25, 26, 27, 28, 29, 30, 31 };
+    const std::vector<int64_t> bars = {  0,  0,  0,  0,  1,  1,  2,  2 };
+    const uint8_t simult[8] = { 0, 0, 0, 1, 0, 0, 0, 0 };
+    const std::vector<int64_t> num = {  1,  1,  2,  1,  1,  1,  1,  1 };
+    const std::vector<int64_t> den = {  4,  4,  8,  4,  2,  2,  2,  2 };
+    pse::PSNoteBuffers buf;
+    buf.size = midi.size();
+    buf.midi = midi.data();
+    buf.bars = bars.data();
+    buf.simult = simult;
+    buf.dur_num = num.data();
+    buf.dur_den = den.data();
+
+    pse::PSRawEnum e(0, 0);
+    e.add(60, 0, false);
+    ASSERT_TRUE(e.set(buf));
+    EXPECT_TRUE(e.buffered());
+    EXPECT_EQ(e.first(), 0);
+    EXPECT_EQ(e.stop(), 8);
+    EXPECT_EQ(e.size(), 8);
+    EXPECT_EQ(e.midipitch(0), 24);
+    EXPECT_EQ(e.midipitch(7), 31);
+    EXPECT_EQ(e.measure(3), 0);
+    EXPECT_EQ(e.measure(4), 1);
+    EXPECT_TRUE(e.simultaneous(3));
+    EXPECT_FALSE(e.simultaneous(4));
+    EXPECT_EQ(e.duration_num(2), 1); // normalized
+    EXPECT_EQ(e.duration_den(2), 4);
+    EXPECT_EQ(e.name(5), pse::NoteName::Undef);
+
+    // clones view the same buffers
+    std::unique_ptr<pse::PSEnum> c = e.clone(4, 8);
+    EXPECT_EQ(c->midipitch(5), 29);
+    c->rename(5, pse::NoteName::F);
+    EXPECT_EQ(e.name(5), pse::NoteName::F);
+    EXPECT_EQ(e.accidental(5), pse::Accid::Natural);
+
+    // ill formed buffers are rejected and the view is unchanged
+    const std::vector<int64_t> bad = {  0,  0,  1,  0,  1,  1,  2,  2 };
+    pse::PSNoteBuffers buf2(buf);
+    buf2.bars = bad.data();
+    EXPECT_FALSE(e.set(buf2));
+    EXPECT_EQ(e.measure(3), 0);
+    EXPECT_EQ(e.name(5), pse::NoteName::F);
+
+    // without simultaneity flags, no note is simultaneous
+    buf2 = buf;
+    buf2.simult = nullptr;
+    ASSERT_TRUE(e.set(buf2));
+    EXPECT_FALSE(e.simultaneous(3));
+
+    e.reset(0, 0);
+    EXPECT_FALSE(e.buffered());
+    EXPECT_EQ(e.size(), 0);
+
+    // back to the input lists
+    e.add(62, 0, true);
+    e.add(64, 1, false);
+    EXPECT_FALSE(e.buffered());
+    EXPECT_EQ(e.size(), 2);
+    EXPECT_EQ(e.midipitch(1), 64);
+    EXPECT_EQ(e.measure(1), 1);
+    EXPECT_TRUE(e.simultaneous(0));
+    EXPECT_EQ(e.duration_num(1), 0);
+    EXPECT_EQ(e.duration_den(1), 1);
+}
+
+
+TEST(PSRawEnum, bars)
+{
+    pse::PSRawEnum e(0, 6);
+    // midi key, bar nb, simult
+    e.add(60, 0, false);
+    e.add(62, 0, false);
+    e.add(64, 2, true);  // bar 1 is empty
+    e.add(67, 2, false);
+    e.add(65, 3, false);
+    e.add(66, 3, false);
+    e.rename(5, pse::NoteName::G, pse::Accid::Flat, 4, true);
+
+    pse::PSBars bars(e);
+    ASSERT_EQ(bars.size(), 4);
+    EXPECT_EQ(bars.first(0), 0);
+    EXPECT_EQ(bars.stop(0), 2);
+    EXPECT_TRUE(bars.empty(1));
+    EXPECT_EQ(bars.first(1), 2);
+    EXPECT_EQ(bars.first(2), 2);
+    EXPECT_EQ(bars.stop(2), 4);
+    EXPECT_EQ(bars.first(3), 4);
+    EXPECT_EQ(bars.stop(3), 6);
+
+    pse::PSBarView v(e, bars.first(3), bars.stop(3));
+    EXPECT_EQ(v.first(), 4);
+    EXPECT_EQ(v.stop(), 6);
+    for (size_t i = v.first(); i < v.stop(); ++i)
+    {
+        EXPECT_EQ(v.midipitch(i), e.midipitch(i));
+        EXPECT_EQ(v.measure(i), e.measure(i));
+        EXPECT_EQ(v.simultaneous(i), e.simultaneous(i));
+        EXPECT_EQ(v.name(i), e.name(i));
+        EXPECT_EQ(v.accidental(i), e.accidental(i));
+    }
+    EXPECT_EQ(v.name(5), pse::NoteName::G);
+
+    // renaming is forwarded to the enumerator
+    v.rename(4, pse::NoteName::F, pse::Accid::Natural, 4, false);
+    EXPECT_EQ(e.name(4), pse::NoteName::F);
+    EXPECT_EQ(v.name(4), pse::NoteName::Undef);
+
+    pse::PSRawEnum empty(0, 0);
+    EXPECT_EQ(pse::PSBars(empty).size(), 0);
+}
+
+
+TEST(PSRawEnum, modify)
+{
+    pse::PSRawEnum e(0, 6);
+    // midi key, bar nb, simult
+    e.add(60, 0, false);
+    e.add(62, 0, false);
+    e.add(64, 1, true);
+    e.add(66, 1, false, pse::PSRatio(0), pse::NoteName::G, pse::Accid::Flat, 4);
+    e.add(67, 1, false);
+    e.add(69, 2, false);
+    EXPECT_TRUE(e.dirty().empty());
+    e.rename(2, pse::NoteName::E, pse::Accid::Natural, 4, false);
+    e.rename(4, pse::NoteName::G, pse::Accid::Natural, 4, false);
+    e.rename(5, pse::NoteName::A, pse::Accid::Natural, 4, false);
+
+    EXPECT_TRUE(e.modify(4, 68, true));
+    EXPECT_EQ(e.midipitch(4), 68);
+    EXPECT_TRUE(e.simultaneous(4));
+    ASSERT_EQ(e.dirty().size(), 1);
+    EXPECT_EQ(*(e.dirty().begin()), 1);
+    // estimated spellings of the bar are reset, not the given ones
+    EXPECT_EQ(e.name(2), pse::NoteName::Undef);
+    EXPECT_EQ(e.name(3), pse::NoteName::G);
+    EXPECT_EQ(e.name(4), pse::NoteName::Undef);
+    EXPECT_EQ(e.accidental(4), pse::Accid::Undef);
+    EXPECT_EQ(e.name(5), pse::NoteName::A);
+
+    // shared by the copies
+    pse::PSRawEnum c(e);
+    EXPECT_TRUE(c.modify(0, 61));
+    EXPECT_EQ(e.dirty().size(), 2);
+    e.clean();
+    EXPECT_TRUE(c.dirty().empty());
+    EXPECT_FALSE(e.modify(6, 60));
+}
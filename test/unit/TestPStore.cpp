@@ -0,0 +1,55 @@
+//
+//  TestPStore.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include "NoteName.hpp"
+#include "PSPStore.hpp"
+
+
+TEST(PSPStore, ties)
+{
+    const std::vector<enum pse::NoteName> n0 =
+    { pse::NoteName::C, pse::NoteName::D, pse::NoteName::E,
+      pse::NoteName::F, pse::NoteName::G };
+    const std::vector<enum pse::NoteName> n1 =
+    { pse::NoteName::C, pse::NoteName::D, pse::NoteName::F,
+      pse::NoteName::F, pse::NoteName::G };
+    const std::vector<enum pse::NoteName> n2 =
+    { pse::NoteName::C, pse::NoteName::D, pse::NoteName::F,
+      pse::NoteName::F, pse::NoteName::A };
+    const std::vector<bool> p0 = { false, true, false, false, true };
+    const std::vector<bool> p2 = { false, true, false, true, true };
+
+    pse::PSPStore s(5);
+    EXPECT_EQ(s.add(n0, p0), 0);
+    EXPECT_EQ(s.stored(), 5);
+    // shares the 2 first notes with path 0
+    EXPECT_EQ(s.add(n1, p0), 1);
+    EXPECT_EQ(s.stored(), 8);
+    // shares the 3 first notes with path 1
+    EXPECT_EQ(s.add(n2, p2), 2);
+    EXPECT_EQ(s.stored(), 10);
+    EXPECT_EQ(s.size(), 3);
+
+    std::vector<enum pse::NoteName> names;
+    std::vector<bool> prints;
+    s.decode(0, names, prints);
+    EXPECT_EQ(names, n0);
+    EXPECT_EQ(prints, p0);
+    s.decode(1, names, prints);
+    EXPECT_EQ(names, n1);
+    EXPECT_EQ(prints, p0);
+    s.decode(2, names, prints);
+    EXPECT_EQ(names, n2);
+    EXPECT_EQ(prints, p2);
+    for (size_t j = 0; j < 5; ++j)
+    {
+        EXPECT_EQ(s.name(2, j), n2[j]);
+        EXPECT_EQ(s.printed(2, j), p2[j]);
+    }
+}
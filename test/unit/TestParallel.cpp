@@ -0,0 +1,197 @@
+//
+//  TestParallel.cpp
+//  testpse
+//
+//  Created by agent on 17/10/2026.
+//
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "Ton.hpp"
+#include "TonIndex.hpp"
+#include "PSRawEnum.hpp"
+#include "CostADplus.hpp"
+#include "PSPool.hpp"
+#include "PSTable.hpp"
+#include "PSE.hpp"
+#include "PSEBatch.hpp"
+
+
+TEST(PSPool, run)
+{
+    pse::PSPool pool(4);
+    EXPECT_EQ(pool.threads(), 4);
+    std::vector<size_t> res(100, 0);
+    std::atomic<size_t> sum(0);
+    pool.run(res.size(), [&res, &sum](size_t k, size_t w)
+    {
+        EXPECT_LT(w, 4);
+        res[k] = k*k;
+        sum += k;
+    });
+    EXPECT_EQ(sum, 4950);
+    for (size_t k = 0; k < res.size(); ++k)
+        EXPECT_EQ(res[k], k*k);
+}
+
+// the workers are kept from one run to the next and every task is run once
+TEST(PSPool, reuse)
+{
+    pse::PSPool pool(3);
+    std::mutex m;
+    std::set<std::thread::id> ids;
+    for (size_t r = 0; r < 20; ++r)
+    {
+        std::vector<std::atomic<size_t>> count(50 + r);
+        for (std::atomic<size_t>& c : count)
+            c = 0;
+        pool.run(count.size(), [&count, &m, &ids](size_t k, size_t)
+        {
+            ++count[k];
+            std::lock_guard<std::mutex> lock(m);
+            ids.insert(std::this_thread::get_id());
+        });
+        for (size_t k = 0; k < count.size(); ++k)
+            EXPECT_EQ(count[k], 1);
+    }
+    EXPECT_LE(ids.size(), 3);
+}
+
+// an exception thrown by a task is rethrown in the calling thread
+TEST(PSPool, exception)
+{
+    pse::PSPool pool(4);
+    EXPECT_THROW(pool.run(100, [](size_t k, size_t)
+    {
+        if (k == 42)
+            throw std::runtime_error("task 42");
+    }), std::runtime_error);
+
+    // the pool is still usable
+    std::atomic<size_t> sum(0);
+    pool.run(100, [&sum](size_t k, size_t) { sum += k; });
+    EXPECT_EQ(sum, 4950);
+
+    // sequential pool
+    pse::PSPool seq(1);
+    EXPECT_THROW(seq.run(3, [](size_t, size_t)
+    {
+        throw std::runtime_error("task");
+    }), std::runtime_error);
+}
+
+
+// the table built with several threads is the same as the sequential one
+TEST(PSPool, table)
+{
+    pse::TonIndex id(26); // closed
+    pse::PSRawEnum e(0, 96);
+    pse::CostADplus seed;
+
+    // 12 bars of ascending and descending chromatic and diatonic fragments
+    const std::vector<unsigned int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    for (size_t b = 0; b < 12; ++b)
+        for (size_t k = 0; k < frag.size(); ++k)
+            e.add(frag[(b%2)?(frag.size()-1-k):k] + b, b, false);
+
+    pse::PST t1(pse::Algo::PSE, seed, id, e, true, false, false, 1);
+    pse::PST t4(pse::Algo::PSE, seed, id, e, true, false, false, 4);
+    ASSERT_EQ(t1.size(), 12);
+    ASSERT_EQ(t4.size(), t1.size());
+    for (size_t i = 0; i < id.size(); ++i)
+        EXPECT_EQ(t4.rowCost(i), t1.rowCost(i));
+    for (size_t j = 0; j < t1.size(); ++j)
+    {
+        for (size_t i = 0; i < id.size(); ++i)
+        {
+            const pse::PSB& b1 = t1.column(j).bag(i);
+            const pse::PSB& b4 = t4.column(j).bag(i);
+            EXPECT_EQ(b4.cost(), b1.cost());
+            ASSERT_EQ(b4.size(), b1.size());
+            for (size_t n = t1.column(j).first(); n < t1.column(j).stop(); ++n)
+                EXPECT_EQ(b4.path(0).name(n), b1.path(0).name(n));
+        }
+    }
+}
+
+// the spelling of parts in a batch is the same as the spelling one by one
+TEST(PSEBatch, spell)
+{
+    const std::vector<int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    std::vector<pse::PSENotes> parts(6);
+    for (size_t p = 0; p < parts.size(); ++p)
+        for (size_t b = 0; b < 4; ++b)
+            for (size_t k = 0; k < frag.size(); ++k)
+            {
+                parts[p].midi.push_back(frag[(b%2)?(frag.size()-1-k):k]+p+b);
+                parts[p].bars.push_back(b);
+            }
+    parts.push_back(pse::PSENotes()); // empty part
+
+    pse::PSEBatch batch(30, pse::CostType::ACCID, pse::CostType::ADplus, 4);
+    std::vector<pse::PSESpelling> res = batch.spell(parts);
+    ASSERT_EQ(res.size(), parts.size());
+    EXPECT_TRUE(res.back().status);
+    EXPECT_TRUE(res.back().names.empty());
+    
+    for (size_t p = 0; p+1 < parts.size(); ++p)
+    {
+        pse::PSE sp(30, false); // no debug, as in batch
+        for (size_t i = 0; i < parts[p].midi.size(); ++i)
+            sp.add(parts[p].midi[i], parts[p].bars[i]);
+        ASSERT_TRUE(sp.spell());
+        ASSERT_TRUE(sp.rename(0));
+        ASSERT_TRUE(res[p].status);
+        ASSERT_EQ(res[p].names.size(), sp.size());
+        ASSERT_EQ(res[p].globals.size(), sp.globals());
+        EXPECT_EQ(res[p].globals[0], sp.global(0));
+        for (size_t i = 0; i < sp.size(); ++i)
+        {
+            EXPECT_EQ(res[p].names[i], sp.name(i));
+            EXPECT_EQ(res[p].accids[i], sp.accidental(i));
+            EXPECT_EQ(res[p].octaves[i], sp.octave(i));
+            EXPECT_EQ(res[p].printed[i], sp.printed(i));
+        }
+    }
+}
+
+
+// the invalid parts are detected before spelling, and not spelled
+TEST(PSEBatch, check)
+{
+    pse::PSENotes valid;
+    valid.midi = { 60, 62, 64 };
+    valid.bars = { 0, 0, 1 };
+    std::vector<pse::PSENotes> parts(5, valid);
+    parts[1].midi[1] = -1;
+    parts[2].midi[2] = 200;
+    parts[3].bars[2] = -1;
+    parts[4].bars.pop_back();
+    std::string msg;
+    EXPECT_TRUE(pse::PSEBatch::check(parts[0], msg));
+    for (size_t p = 1; p < parts.size(); ++p)
+    {
+        EXPECT_FALSE(pse::PSEBatch::check(parts[p], msg));
+        EXPECT_FALSE(msg.empty());
+    }
+    pse::PSENotes decreasing(valid);
+    decreasing.bars = { 1, 0, 1 };
+    EXPECT_FALSE(pse::PSEBatch::check(decreasing, msg));
+
+    pse::PSEBatch batch(30, pse::CostType::ACCID, pse::CostType::ADplus, 2);
+    std::vector<pse::PSESpelling> res = batch.spell(parts);
+    ASSERT_EQ(res.size(), parts.size());
+    EXPECT_TRUE(res[0].status);
+    EXPECT_EQ(res[0].names.size(), 3);
+    for (size_t p = 1; p < parts.size(); ++p)
+    {
+        EXPECT_FALSE(res[p].status);
+        EXPECT_TRUE(res[p].names.empty());
+    }
+}
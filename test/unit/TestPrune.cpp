@@ -0,0 +1,127 @@
+//
+//  TestPrune.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include "gtest/gtest.h"
+
+#include "Ton.hpp"
+#include "TonIndex.hpp"
+#include "PSRawEnum.hpp"
+#include "CostA.hpp"
+#include "CostADlex.hpp"
+#include "PSTable.hpp"
+
+
+// 16 bars in D major, with some chromatic passing notes
+static void dmajor(pse::PSRawEnum& e)
+{
+    const std::vector<unsigned int> frag =
+    { 62, 64, 66, 67, 69, 71, 73, 74, 73, 71, 70, 69, 67, 66, 65, 64 };
+    for (size_t b = 0; b < 16; ++b)
+        for (size_t k = 0; k < 8; ++k)
+            e.add(frag[(8*b + 3*k) % frag.size()] + ((b%3 == 0)?12:0), b);
+}
+
+// 16 bars in A minor, with the natural and raised 6th and 7th degrees
+// (the natural 7th is in the key signature but not in the harmonic scale)
+static void aminor(pse::PSRawEnum& e)
+{
+    const std::vector<unsigned int> frag =
+    { 69, 71, 72, 74, 76, 77, 79, 81, 80, 78, 76, 74, 72, 71, 68, 69 };
+    for (size_t b = 0; b < 16; ++b)
+        for (size_t k = 0; k < 8; ++k)
+            e.add(frag[(8*b + 5*k) % frag.size()] + ((b%4 == 1)?-12:0), b);
+}
+
+// 16 bars of the notes A B C E G, spelled without accidentals
+// in A minor and E minor (the G is not in the harmonic scale of A minor)
+static void fivenotes(pse::PSRawEnum& e)
+{
+    const std::vector<unsigned int> frag =
+    { 69, 71, 72, 76, 79, 81, 79, 76, 72, 71, 69, 67, 64, 60, 67, 72 };
+    for (size_t b = 0; b < 16; ++b)
+        for (size_t k = 0; k < 8; ++k)
+            e.add(frag[(8*b + 3*k) % frag.size()], b);
+}
+
+// the pruned table agrees with the complete table on the exact rows
+// and on the selection of globals
+static void compare(const pse::Cost& seed, double d,
+                    const pse::TonIndex& id = pse::TonIndex(30),
+                    bool tonal = false,
+                    void (*fill)(pse::PSRawEnum&) = dmajor)
+{
+    ASSERT_TRUE(id.closed());
+    pse::TonIndex id0(id);
+    pse::TonIndex id1(id);
+    pse::PSRawEnum e(0, 128);
+    fill(e);
+
+    pse::PST t0(pse::Algo::PSE, seed, id0, e, tonal);
+    pse::PST t1(pse::Algo::PSE, seed, id1, e, tonal, false, false, 1,
+                nullptr, nullptr, false, d);
+    ASSERT_TRUE(t0.exact());
+    EXPECT_EQ(t0.threshold(), 100);
+    EXPECT_FALSE(t1.exact());
+    EXPECT_EQ(t1.threshold(), d);
+    ASSERT_EQ(t1.size(), t0.size());
+    for (size_t i = 0; i < id0.size(); ++i)
+    {
+        if (t1.exact(i))
+            EXPECT_EQ(t1.rowCost(i), t0.rowCost(i));
+        else
+            EXPECT_TRUE(t1.rowCost(i) < t0.rowCost(i) or
+                        t1.rowCost(i) == t0.rowCost(i));
+    }
+
+    size_t n0 = id0.selectGlobals(t0, d, false);
+    size_t n1 = id1.selectGlobals(t1, d, false);
+    EXPECT_EQ(n1, n0);
+    for (size_t i = 0; i < id0.size(); ++i)
+        EXPECT_EQ(id1.isGlobal(i), id0.isGlobal(i));
+
+    // completion gives the complete table
+    t1.complete();
+    EXPECT_TRUE(t1.exact());
+    EXPECT_EQ(t1.threshold(), 100);
+    for (size_t i = 0; i < id0.size(); ++i)
+    {
+        EXPECT_EQ(t1.rowCost(i), t0.rowCost(i));
+        for (size_t j = 0; j < t0.size(); ++j)
+            EXPECT_EQ(t1.column(j).bag(i).cost(), t0.column(j).bag(i).cost());
+    }
+}
+
+TEST(PSTPrune, CostA)
+{
+    compare(pse::CostA(), 0);
+    compare(pse::CostA(), 10);
+}
+
+TEST(PSTPrune, CostADlex)
+{
+    compare(pse::CostADlex(), 10);
+}
+
+// tonal mode: the initial states are the key signatures,
+// with minor and modal tonalities
+TEST(PSTPrune, tonal)
+{
+    // the minor tonalities represent the rows of their key signature
+    pse::TonIndex id(0);
+    for (int ks = -4; ks <= 4; ++ks)
+        id.add(ks, pse::ModeName::Minor);
+    for (int ks = -4; ks <= 4; ++ks)
+        id.add(ks, pse::ModeName::Dorian, false);
+    id.close();
+    compare(pse::CostA(), 0, id, true, fivenotes);
+    compare(pse::CostA(), 10, id, true, fivenotes);
+    compare(pse::CostA(), 0, id, true, aminor);
+    compare(pse::CostA(), 10, id, true, aminor);
+    compare(pse::CostADlex(), 10, id, true, aminor);
+    compare(pse::CostA(), 10, id, true, dmajor);
+    compare(pse::CostA(), 10, pse::TonIndex(104), true, aminor);
+}
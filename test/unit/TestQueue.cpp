@@ -0,0 +1,85 @@
+//
+//  TestQueue.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include <queue>
+
+#include "gtest/gtest.h"
+
+#include "Ton.hpp"
+#include "PSRawEnum.hpp"
+#include "Enharmonic.hpp"
+#include "CostA.hpp"
+#include "CostAD.hpp"
+#include "PSConfig0.hpp"
+#include "PSConfig1.hpp"
+#include "PSOrder.hpp"
+#include "PSCQueue.hpp"
+
+
+// all the configs reachable from c
+static void configs(std::shared_ptr<const pse::PSC0> c,
+                    const pse::PSRawEnum& e, const pse::Ton& t,
+                    std::vector<std::shared_ptr<const pse::PSC0>>& v)
+{
+    v.push_back(c);
+    if (c->id() == e.stop())
+        return;
+    unsigned int m = e.midipitch(c->id()) % 12;
+    for (int j = 0; j < 3; ++j)
+    {
+        enum pse::NoteName name = pse::Enharmonics::name(m, j, false, false);
+        enum pse::Accid accid = pse::Enharmonics::accid(m, j, false, false);
+        if (! (defined(name) and defined(accid)))
+            continue;
+        configs(std::make_shared<const pse::PSC1>(c, e, name, accid,
+                                                  false, t, t), e, t, v);
+    }
+}
+
+// same order of extraction as a priority queue ordered by PSClex
+static void compare(const pse::Cost& seed)
+{
+    pse::Ton t(-1, pse::ModeName::Major);
+    pse::PSRawEnum e(0, 5);
+    for (unsigned int m : { 61, 63, 66, 68, 60 })
+        e.add(m, 0);
+    std::vector<std::shared_ptr<const pse::PSC0>> v;
+    configs(std::make_shared<const pse::PSC0>(t, 0, seed, true, false),
+            e, t, v);
+    ASSERT_GT(v.size(), 100);
+
+    pse::PSCQueue q;
+    std::priority_queue<std::shared_ptr<const pse::PSC0>,
+                        std::vector<std::shared_ptr<const pse::PSC0>>,
+                        pse::PSCCompare> pq((pse::PSClex()));
+    for (const std::shared_ptr<const pse::PSC0>& c : v)
+    {
+        q.push(c);
+        pq.push(c);
+    }
+    EXPECT_EQ(q.size(), v.size());
+    while (! pq.empty())
+    {
+        ASSERT_FALSE(q.empty());
+        std::shared_ptr<const pse::PSC0> c = q.top();
+        EXPECT_EQ(c->cost(), pq.top()->cost());
+        EXPECT_EQ(c->id(), pq.top()->id());
+        q.pop();
+        pq.pop();
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(PSCQueue, CostA)
+{
+    compare(pse::CostA());
+}
+
+TEST(PSCQueue, CostAD)
+{
+    compare(pse::CostAD());
+}
@@ -0,0 +1,296 @@
+//
+//  TestSpeller.cpp
+//  testpse
+//
+//  Created by agent on 18/10/2026.
+//
+
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "NoteName.hpp"
+#include "Accid.hpp"
+#include "TonIndex.hpp"
+#include "PSE.hpp"
+#include "PS13.hpp"
+#include "SpellerEnum.hpp"
+
+
+// the bulk export of results is the same as the note by note access
+TEST(Speller, export)
+{
+    const std::vector<int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    pse::PSE sp(30, false);
+    for (size_t b = 0; b < 5; ++b)
+        for (size_t k = 0; k < frag.size(); ++k)
+            sp.add(frag[(b%2)?(frag.size()-1-k):k] + b, b);
+    EXPECT_EQ(sp.gridRows(), 0);
+    EXPECT_EQ(sp.gridColumns(), 0);
+    ASSERT_TRUE(sp.spell());
+    ASSERT_TRUE(sp.rename(0));
+
+    size_t n = sp.size();
+    std::vector<int> names(n), accids(n), octaves(n);
+    std::unique_ptr<bool[]> prints(new bool[n]);
+    EXPECT_EQ(sp.exportNotes(names.data(), accids.data(), octaves.data(),
+                             prints.get()), n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        EXPECT_EQ(static_cast<enum pse::NoteName>(names[i]), sp.name(i));
+        EXPECT_EQ(static_cast<enum pse::Accid>(accids[i]), sp.accidental(i));
+        EXPECT_EQ(octaves[i], sp.octave(i));
+        EXPECT_EQ(prints[i], sp.printed(i));
+    }
+
+    ASSERT_EQ(sp.gridRows(), 30);
+    ASSERT_EQ(sp.gridColumns(), 5);
+    std::vector<size_t> ilocals(sp.gridRows() * sp.gridColumns());
+    ASSERT_TRUE(sp.exportGrid(ilocals.data()));
+    for (size_t i = 0; i < sp.gridRows(); ++i)
+        for (size_t j = 0; j < sp.gridColumns(); ++j)
+            EXPECT_EQ(ilocals[i*sp.gridColumns()+j], sp.ilocal(i, j));
+}
+
+
+// the k best paths of the exhaustive grid are accessible from the speller,
+// the first one being the row of the grid
+TEST(Speller, grid_kbest)
+{
+    const std::vector<int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    pse::SpellerEnum sp(26);
+    for (size_t b = 0; b < 4; ++b)
+        for (size_t k = 0; k < frag.size(); ++k)
+            sp.add(frag[(3*k + b)%frag.size()] + b, b);
+    ASSERT_TRUE(sp.evalTable(pse::CostType::ACCID));
+    ASSERT_TRUE(sp.evalGrid(pse::GridAlgo::Rank));
+    EXPECT_EQ(sp.gridPaths(0), 0); // not exhaustive
+    ASSERT_TRUE(sp.evalGrid(pse::GridAlgo::Exhaustive, 4));
+    for (size_t i = 0; i < sp.gridRows(); ++i)
+    {
+        ASSERT_EQ(sp.gridPaths(i), 4);
+        std::vector<size_t> best = sp.gridPath(i, 0);
+        ASSERT_EQ(best.size(), sp.gridColumns());
+        for (size_t j = 0; j < sp.gridColumns(); ++j)
+            EXPECT_EQ(best[j], sp.ilocal(i, j));
+        for (size_t r = 1; r < 4; ++r)
+            EXPECT_LE(sp.gridPathCost(i, r-1), sp.gridPathCost(i, r));
+    }
+    EXPECT_TRUE(sp.gridPath(0, 4).empty());
+}
+
+
+// streaming PS13 gives the same spellings as PS13 on the whole sequence
+TEST(Speller, PS13_stream)
+{
+    const std::vector<int> frag = { 60, 61, 63, 66, 68, 69, 70, 73, 75, 78 };
+    pse::PS13 sp(10, 7, false);
+    pse::PS13 st(10, 7, false);
+    size_t k = 0;
+    for (size_t b = 0; b < 8; ++b)
+    {
+        for (size_t j = 0; j < frag.size(); ++j)
+        {
+            int m = frag[(3*j + b)%frag.size()] + (int) b;
+            sp.add(m, b);
+            st.add(m, b);
+            ++k;
+            st.stream();
+            // the notes with Kpost next notes known are spelled
+            EXPECT_EQ(st.spelled(), (k >= 7)?(k - 7 + 1):0);
+        }
+    }
+    EXPECT_EQ(st.stream(true), 6);
+    EXPECT_EQ(st.spelled(), k);
+    ASSERT_TRUE(sp.spell());
+    for (size_t i = 0; i < k; ++i)
+    {
+        EXPECT_EQ(st.name(i), sp.name(i));
+        EXPECT_EQ(st.accidental(i), sp.accidental(i));
+    }
+}
+
+
+// streaming PSE spells the bars followed by lag complete bars
+// re-spelling after modification of notes gives the same result as
+// spelling from scratch
+TEST(Speller, PSE_respell)
+{
+    const std::vector<int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    const size_t nb = 10;
+    // (index, new MIDI key)
+    const std::vector<std::pair<size_t, int>> edits =
+    { { 2*8+3, 66 }, { 2*8+5, 67 }, { 6*8+1, 61 } };
+    // with a change of the global flags after spell,
+    // the notes are spelled again from scratch.
+    for (bool force : { false, true })
+    {
+        pse::PSE sp(30, false);
+        pse::PSE ref(30, false);
+        for (size_t b = 0; b < nb; ++b)
+        {
+            for (size_t j = 0; j < frag.size(); ++j)
+            {
+                int m = frag[(b%2)?(frag.size()-1-j):j] + (int) b;
+                sp.add(m, b);
+                for (auto& ed : edits)
+                    if (ed.first == b*frag.size()+j)
+                        m = ed.second;
+                ref.add(m, b);
+            }
+        }
+        ASSERT_TRUE(sp.spell());
+        ASSERT_TRUE(sp.rename(0));
+        if (force)
+        {
+            ASSERT_TRUE(sp.forceGlobal(-3, pse::ModeName::Major));
+            ASSERT_TRUE(ref.forceGlobal(-3, pse::ModeName::Major));
+        }
+        for (auto& ed : edits)
+            EXPECT_TRUE(sp.modify(ed.first, ed.second));
+        ASSERT_TRUE(sp.respell());
+        ASSERT_TRUE(sp.rename(0));
+        ASSERT_TRUE(ref.spell());
+        ASSERT_TRUE(ref.rename(0));
+
+        EXPECT_EQ(sp.globals(), ref.globals());
+        EXPECT_EQ(sp.iglobal(0), ref.iglobal(0));
+        EXPECT_EQ(sp.globals0(), ref.globals0());
+        ASSERT_EQ(sp.gridColumns(), nb);
+        for (size_t i = 0; i < sp.gridRows(); ++i)
+            for (size_t j = 0; j < nb; ++j)
+                EXPECT_EQ(sp.ilocal(i, j), ref.ilocal(i, j));
+        for (size_t i = 0; i < sp.size(); ++i)
+        {
+            EXPECT_EQ(sp.name(i), ref.name(i));
+            EXPECT_EQ(sp.accidental(i), ref.accidental(i));
+            EXPECT_EQ(sp.printed(i), ref.printed(i));
+        }
+        // nothing modified
+        EXPECT_TRUE(sp.respell());
+    }
+}
+
+
+TEST(Speller, PSE_stream)
+{
+    const std::vector<int> frag = { 60, 62, 63, 65, 66, 68, 70, 71 };
+    const size_t lag = 2;
+    pse::PSE st(30, false);
+    EXPECT_EQ(st.stream(false, lag), 0);
+    size_t k = 0;
+    for (size_t b = 0; b < 6; ++b)
+    {
+        for (size_t j = 0; j < frag.size(); ++j)
+        {
+            st.add(frag[(b%2)?(frag.size()-1-j):j] + b, b);
+            ++k;
+            st.stream(false, lag);
+            // bars 0..b-1 are complete
+            size_t fixed = (b > lag)?(b - lag):0;
+            EXPECT_EQ(st.spelled(), fixed * frag.size());
+        }
+    }
+    EXPECT_EQ(st.stream(true, lag), lag * frag.size() + frag.size());
+    EXPECT_EQ(st.spelled(), k);
+    for (size_t i = 0; i < k; ++i)
+    {
+        EXPECT_NE(st.name(i), pse::NoteName::Undef);
+        EXPECT_NE(st.accidental(i), pse::Accid::Undef);
+    }
+    EXPECT_EQ(st.gridColumns(), 6);
+
+    // restart and stream again in one call
+    st.restart();
+    EXPECT_EQ(st.spelled(), 0);
+    EXPECT_EQ(st.stream(true, lag), k);
+}
+
+
+// the spelling in streaming mode ends as the spelling in one call, when the
+// estimated global tonality changes during streaming and when the global
+// flags of the index are changed between two calls.
+TEST(Speller, PSE_stream_global)
+{
+    // 2 bars in B major, then 6 bars in Db major
+    const std::vector<int> fis = { 71, 61, 63, 64, 66, 68, 70 };
+    const std::vector<int> des = { 61, 63, 65, 66, 68, 70, 72 };
+    const size_t lag = 1;
+    for (bool force : { false, true })
+    {
+        pse::PSE st(30, false);
+        std::set<size_t> globals;
+        for (size_t b = 0; b < 8; ++b)
+        {
+            for (int m : (b < 2)?fis:des)
+                st.add(m, b);
+            st.stream(false, lag);
+            if (st.spelled() > 0)
+                globals.insert(st.iglobal(0));
+            // change of the global flags between two calls
+            if (force and b == 4)
+                ASSERT_TRUE(st.forceGlobal(-3, pse::ModeName::Major));
+        }
+        st.stream(true, lag);
+        // the estimated global has changed during streaming
+        if (! force)
+            EXPECT_GT(globals.size(), 1);
+        std::vector<enum pse::NoteName> names;
+        std::vector<enum pse::Accid> accids;
+        for (size_t i = 0; i < st.size(); ++i)
+        {
+            names.push_back(st.name(i));
+            accids.push_back(st.accidental(i));
+        }
+
+        // same spelling as streaming in one call
+        st.restart();
+        EXPECT_EQ(st.stream(true, lag), st.size());
+        for (size_t i = 0; i < st.size(); ++i)
+        {
+            EXPECT_EQ(st.name(i), names[i]);
+            EXPECT_EQ(st.accidental(i), accids[i]);
+        }
+    }
+}
+
+
+// streaming ends with the same spelling as spell, with the same options
+// of the tables (the octave mode is set with the debug flag).
+// the online grid is computed with a different algorithm than the grid
+// of spell, they give the same local tonalities for these notes.
+TEST(Speller, PSE_stream_spell)
+{
+    // 6 bars of 8 notes, on 4 octaves
+    const std::vector<int> notes =
+    {
+        85, 72, 90, 78, 60, 85, 75, 87,
+        77, 84, 56, 75, 65, 89, 63, 84,
+        69, 75, 61, 87, 67, 72, 70, 85,
+        89, 66, 67, 86, 70, 87, 75, 77,
+        58, 60, 79, 70, 73, 72, 56, 60,
+        80, 68, 84, 82, 79, 82, 71, 84
+    };
+    const size_t lag = 2;
+    for (bool dflag : { false, true })
+    {
+        pse::PSE sp(30, dflag);
+        pse::PSE st(30, dflag);
+        for (size_t i = 0; i < notes.size(); ++i)
+        {
+            sp.add(notes[i], i/8);
+            st.add(notes[i], i/8);
+            st.stream(false, lag);
+        }
+        st.stream(true, lag);
+        ASSERT_TRUE(sp.spell());
+        ASSERT_TRUE(sp.rename(0));
+        ASSERT_EQ(st.spelled(), sp.size());
+        for (size_t i = 0; i < sp.size(); ++i)
+        {
+            EXPECT_EQ(st.name(i), sp.name(i));
+            EXPECT_EQ(st.accidental(i), sp.accidental(i));
+            EXPECT_EQ(st.printed(i), sp.printed(i));
+        }
+    }
+}
@@ -11,6 +11,7 @@
 #include "Accid.hpp"
 #include "ModeName.hpp"
 #include "Ton.hpp"
+#include "MidiNum.hpp"
 #include "TonIndex.hpp"
 
 
@@ -339,3 +340,56 @@ TEST(TonIndex, 30_equiv)
 //    EXPECT_TRUE(id.isGlobal(6));
 //    EXPECT_FALSE(id.isGlobal(10));
 //}
+
+TEST(TonIndex, 30_copy)
+{
+    pse::TonIndex id(30);
+    ASSERT_TRUE(id.forceGlobal(2, pse::ModeName::Major));
+    EXPECT_EQ(id.globals(), 1);
+    pse::TonIndex cp(id);
+    EXPECT_TRUE(cp.closed());
+    ASSERT_EQ(cp.size(), id.size());
+    EXPECT_EQ(cp.globals(), 30); // initial globals
+    for (size_t i = 0; i < id.size(); ++i)
+    {
+        EXPECT_EQ(cp.ton(i), id.ton(i));
+        EXPECT_EQ(cp.irepresentative(i, true), id.irepresentative(i, true));
+        for (size_t j = 0; j < id.size(); ++j)
+        {
+            EXPECT_EQ(cp.distWeber(i, j), id.distWeber(i, j));
+            EXPECT_EQ(cp.rankWeber(i, j), id.rankWeber(i, j));
+        }
+    }
+    EXPECT_EQ(id.globals(), 1);
+}
+
+TEST(TonIndex, 165_table)
+{
+    pse::TonIndex id(165);
+    ASSERT_TRUE(id.closed());
+    const pse::TonTable& tab = id.table();
+    ASSERT_EQ(tab.size(), id.size());
+    const enum pse::Accid accids[5] =
+    { pse::Accid::DoubleFlat, pse::Accid::Flat, pse::Accid::Natural,
+      pse::Accid::Sharp, pse::Accid::DoubleSharp };
+    for (size_t i = 0; i < id.size(); ++i)
+    {
+        const pse::Ton& ton = id.ton(i);
+        uint16_t pcs = 0;
+        for (int n = 0; n < 7; ++n)
+        {
+            const enum pse::NoteName name = pse::NoteName(n);
+            for (const enum pse::Accid& a : accids)
+            {
+                if (pse::Accids::contained(a, ton.accidScale(name)))
+                    pcs |= (1 << pse::MidiNum::pitchClass(name, a));
+            }
+        }
+        EXPECT_EQ(tab.pcscale(i), pcs);
+        for (int pc = 0; pc < 12; ++pc)
+        {
+            EXPECT_EQ(tab.chromaname(i, pc), ton.chromaname(pc));
+            EXPECT_EQ(tab.chromanames(i)[pc], ton.chromaname(pc));
+        }
+    }
+}